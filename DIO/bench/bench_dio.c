@@ -0,0 +1,666 @@
+/**
+ * @file bench_dio.c
+ * @author Jose Luis Figueroa
+ * @brief Benchmark the DIO driver. Every entry point of the driver is
+ * measured in cycles and register accesses per call, and the results are
+ * printed as JSON (see bench.h).
+ * @version 1.0
+ * @date 2025-04-09
+ * @note Take into account the following considerations:
+ * + Build with the native_bench (host) or nucleo_f401re_bench environment.
+ * + On the board the pins of the benchmark tables are reconfigured, except
+ *   PA13/PA14 (SWD) so the debugger stays attached.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include "dio.h"
+#include "dio_parallel.h"
+#include "dio_stream.h"
+#include "dio_capture.h"
+#include "dio_exti.h"
+#include "dio_debounce.h"
+#include "dio_keypad.h"
+#include "dio_pwm.h"
+#include "bench.h"
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the size of the largest DIO_init table */
+#define BENCH_DIO_TABLE_SIZE    50U
+
+/** Defines the size of the largest parallel bus burst in bytes */
+#define BENCH_DIO_BURST_SIZE    1024U
+
+/** Defines the size of the waveform stream buffer in words */
+#define BENCH_DIO_WAVE_SIZE     64U
+
+/** Defines the size of the logic capture buffer in samples */
+#define BENCH_DIO_CAPTURE_SIZE  64U
+
+/** Defines the period of the software PWM in counts */
+#define BENCH_DIO_PWM_PERIOD    256U
+
+/** Defines the prescaler of the software PWM (64 cycles per count) */
+#define BENCH_DIO_PWM_PRESCALER 63U
+
+/** Defines the period of the software PWM in core cycles (about 1 kHz) */
+#define BENCH_DIO_PWM_CYCLES    \
+    (BENCH_DIO_PWM_PERIOD * (BENCH_DIO_PWM_PRESCALER + 1U))
+
+#ifdef HOST_BUILD
+/**
+ * Defines the CPU cycles of the PWM table build, which the bus-cost model
+ * does not see: per channel (sort step and event words) and per shift of
+ * the insertion sort. Estimates of the compiled loops on the Cortex-M4.
+ */
+#define BENCH_DIO_PWM_CHANNEL_CYCLES    20U
+#define BENCH_DIO_PWM_SHIFT_CYCLES      6U
+#endif
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void BENCH_configFill(void);
+static void BENCH_dioInit(uint32_t param);
+static void BENCH_dioInitImage(uint32_t param);
+static void BENCH_dioPinConfigure(uint32_t param);
+static void BENCH_dioPinRead(uint32_t param);
+static void BENCH_dioPinWrite(uint32_t param);
+static void BENCH_dioPinToggle(uint32_t param);
+static void BENCH_dioPinSet(uint32_t param);
+static void BENCH_dioPinClear(uint32_t param);
+static void BENCH_dioPinToggleFast(uint32_t param);
+static void BENCH_dioPortWrite(uint32_t param);
+static void BENCH_dioPortRead(uint32_t param);
+static void BENCH_dioGroupWrite(uint32_t param);
+static void BENCH_dioGroupRead(uint32_t param);
+static void BENCH_dioBatch(uint32_t param);
+static void BENCH_dioPinWriteAll(uint32_t param);
+static void BENCH_dioParallelWrite(uint32_t param);
+static void BENCH_dioParallelRead(uint32_t param);
+static void BENCH_dioParallelWrite16(uint32_t param);
+static void BENCH_dioStream(uint32_t param);
+static void BENCH_dioCapture(uint32_t param);
+static void BENCH_dioExtiEvent(uint32_t param);
+static void BENCH_dioDebounceTick(uint32_t param);
+static void BENCH_dioKeypadFrame(uint32_t param);
+static void BENCH_pwmSelect(uint32_t channels);
+static void BENCH_dioPwmPeriod(uint32_t param);
+
+/** The compare handler of the PWM, called to swap in the committed table */
+extern void TIM2_IRQHandler(void);
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+/** Configuration table used to benchmark DIO_init (filled by main) */
+static DioConfig_t BenchConfig[BENCH_DIO_TABLE_SIZE];
+
+/** Pin used by the single pin functions */
+static const DioPinConfig_t BenchPin = {DIO_PA, DIO_PA5};
+
+/** Handle of the pin used by the fast path functions (built by main) */
+static DioPinHandle_t BenchHandle;
+
+/** Pin reconfigured by DIO_pinConfigure (alternate function, AFRH) */
+static const DioConfig_t BenchPinConfig = {DIO_PB, DIO_PB10, DIO_FUNCTION,
+    DIO_OPEN_DRAIN, DIO_HIGH_SPEED, DIO_PULLUP, DIO_AF4, DIO_NO_TRIGGER};
+
+/** Pins of the 8 bits group, spread over ports A, B and C */
+static const DioPinConfig_t BenchGroupPins[] =
+{
+    {DIO_PA, DIO_PA0}, {DIO_PA, DIO_PA1}, {DIO_PA, DIO_PA4}, 
+    {DIO_PB, DIO_PB0}, {DIO_PB, DIO_PB1}, {DIO_PB, DIO_PB2},
+    {DIO_PC, DIO_PC0}, {DIO_PC, DIO_PC1}
+};
+
+/** Group of BenchGroupPins (built by main) */
+static DioPinGroup_t BenchGroup;
+
+/** Pins of the batch, 12 outputs over ports A, B and C */
+static const DioPinConfig_t BenchBatchPins[] =
+{
+    {DIO_PA, DIO_PA0}, {DIO_PA, DIO_PA1}, {DIO_PA, DIO_PA4}, 
+    {DIO_PA, DIO_PA5}, {DIO_PA, DIO_PA6}, {DIO_PB, DIO_PB0},
+    {DIO_PB, DIO_PB1}, {DIO_PB, DIO_PB2}, {DIO_PB, DIO_PB10},
+    {DIO_PC, DIO_PC0}, {DIO_PC, DIO_PC1}, {DIO_PC, DIO_PC2}
+};
+
+/** Number of pins written by the batch cases */
+static const uint32_t BenchBatchSizes[] = {1, 4, 12};
+
+/** Data pins of the 8 bits bus, PC0-PC7 (one port, one run) */
+static const DioPinConfig_t BenchBus8Pins[] =
+{
+    {DIO_PC, DIO_PC0}, {DIO_PC, DIO_PC1}, {DIO_PC, DIO_PC2}, 
+    {DIO_PC, DIO_PC3}, {DIO_PC, DIO_PC4}, {DIO_PC, DIO_PC5},
+    {DIO_PC, DIO_PC6}, {DIO_PC, DIO_PC7}
+};
+
+/** Data pins of the 16 bits bus, spread over ports A, B and C */
+static const DioPinConfig_t BenchBus16Pins[] =
+{
+    {DIO_PB, DIO_PB0}, {DIO_PB, DIO_PB1}, {DIO_PB, DIO_PB2}, 
+    {DIO_PB, DIO_PB3}, {DIO_PB, DIO_PB4}, {DIO_PB, DIO_PB5},
+    {DIO_PB, DIO_PB6}, {DIO_PB, DIO_PB7}, {DIO_PA, DIO_PA0},
+    {DIO_PA, DIO_PA1}, {DIO_PA, DIO_PA4}, {DIO_PA, DIO_PA6},
+    {DIO_PC, DIO_PC0}, {DIO_PC, DIO_PC1}, {DIO_PC, DIO_PC2},
+    {DIO_PC, DIO_PC3}
+};
+
+/** Pin maps of the parallel buses, WR and RD on port C */
+static const DioParallelConfig_t BenchBus8Config =
+{
+    BenchBus8Pins, 8, {DIO_PC, DIO_PC8}, {DIO_PC, DIO_PC9}
+};
+static const DioParallelConfig_t BenchBus16Config =
+{
+    BenchBus16Pins, 16, {DIO_PC, DIO_PC8}, {DIO_PC, DIO_PC9}
+};
+
+/** Parallel buses (built by main) */
+static DioParallel_t BenchBus8;
+static DioParallel_t BenchBus16;
+
+/** Data of the parallel bus bursts */
+static uint8_t BenchBurst[BENCH_DIO_BURST_SIZE];
+
+/** Sizes of the parallel bus bursts in bytes */
+static const uint32_t BenchBurstSizes[] = {2, 64, 1024};
+
+/** Square wave on PA0-PA7 streamed by DMA (filled by main) */
+static uint32_t BenchWave[BENCH_DIO_WAVE_SIZE];
+static const DioStreamConfig_t BenchWaveConfig =
+{
+    DIO_PA, BenchWave, BENCH_DIO_WAVE_SIZE, 100, NULL, NULL
+};
+
+/** Logic capture of port C with the compressor on PC13 */
+static uint16_t BenchSamples[BENCH_DIO_CAPTURE_SIZE];
+static DioCaptureRun_t BenchRuns[8];
+static const DioCaptureConfig_t BenchCaptureConfig =
+{
+    DIO_PC, BenchSamples, BENCH_DIO_CAPTURE_SIZE, 100, NULL, 1U<<DIO_PC13,
+    BenchRuns, 8, NULL
+};
+
+/** Pin with an EXTI trigger, its line is raised by software (SWIER) */
+static const DioConfig_t BenchExtiConfig = {DIO_PC, DIO_PC13, DIO_INPUT,
+    DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF0, DIO_BOTH_EDGES};
+
+/** Ports debounced, all 16 pins of each (the first param rows are used) */
+static const DioDebounceConfig_t BenchDebounceConfig[] =
+{
+    {DIO_PA, 0xFFFFU, 4}, {DIO_PB, 0xFFFFU, 8}, {DIO_PC, 0xFFFFU, 15}
+};
+
+/** Debouncers of 1, 2 and 3 ports (built by main) */
+static DioDebounce_t BenchDebounce[3];
+
+/** Number of ports of the debouncer cases */
+static const uint32_t BenchDebounceSizes[] = {1, 2, 3};
+
+/** Key matrix, rows PB0-PB7 and columns PC0-PC7 (4x4 uses the first 4) */
+static const DioPinConfig_t BenchKeypadRows[] =
+{
+    {DIO_PB, DIO_PB0}, {DIO_PB, DIO_PB1}, {DIO_PB, DIO_PB2}, 
+    {DIO_PB, DIO_PB3}, {DIO_PB, DIO_PB4}, {DIO_PB, DIO_PB5},
+    {DIO_PB, DIO_PB6}, {DIO_PB, DIO_PB7}
+};
+static const DioPinConfig_t BenchKeypadColumns[] =
+{
+    {DIO_PC, DIO_PC0}, {DIO_PC, DIO_PC1}, {DIO_PC, DIO_PC2}, 
+    {DIO_PC, DIO_PC3}, {DIO_PC, DIO_PC4}, {DIO_PC, DIO_PC5},
+    {DIO_PC, DIO_PC6}, {DIO_PC, DIO_PC7}
+};
+static const DioKeypadConfig_t BenchKeypadConfig[2] =
+{
+    {BenchKeypadRows, 4, BenchKeypadColumns, 4},
+    {BenchKeypadRows, 8, BenchKeypadColumns, 8}
+};
+
+/** Scanners of the 4x4 and 8x8 matrices (built by main) */
+static DioKeypad_t BenchKeypad[2];
+
+/** Number of rows of the key matrix cases */
+static const uint32_t BenchKeypadSizes[] = {4, 8};
+
+/** PWM channels, PA0-PA12, PB0-PB15 and PC0-PC2 (the first n are used) */
+static DioPinConfig_t BenchPwmPins[DIO_PWM_MAX_CHANNELS];
+
+/** PWM of 8, 16 and 32 channels (selected by BENCH_pwmSelect) */
+static DioPwmConfig_t BenchPwmConfig[3];
+
+/** Number of channels of the PWM cases */
+static const uint32_t BenchPwmSizes[] = {8, 16, 32};
+
+#ifdef HOST_BUILD
+/** Shifts of the insertion sort of the selected PWM duties */
+static uint32_t BenchPwmShifts = 0;
+#endif
+
+/** Sizes of the DIO_init tables */
+static const uint32_t BenchInitSizes[] = {1, 2, 5, 10, 20, 30, 50};
+
+/** Size of the functions that do not depend on a table */
+static const uint32_t BenchSingle[] = {1};
+
+/** Number of toggles of the toggle rate cases */
+static const uint32_t BenchToggles[] = {1, 100};
+
+/**
+ * The following array contains the benchmark cases of the DIO driver. The
+ * thresholds are the fixed cycles per call plus the cycles per pin of the
+ * table (or per toggle), for the host bus-cost model and for the DWT 
+ * counter. The toggle rate of a function is BENCH_CORE_CLOCK_HZ over its
+ * cycles per toggle, the parallel bus cases report their throughput. The
+ * stream and capture cases measure the CPU side of the DMA transfers 
+ * (start and stop), the words themselves cost no CPU cycles. The EXTI 
+ * case is one edge event: interrupt, queue and dequeue. The debouncer 
+ * costs the same per port whatever the number of pins debounced. The key
+ * matrix case is a full frame, one tick per row: at a 1 kHz frame rate
+ * on 84 MHz, 1% of the CPU is 105 cycles per row, the target limit. The 
+ * PWM case is one period with a commit in it (the worst case): the table
+ * build, then one compare interrupt per event, and reports its load of 
+ * the period. DIO_init commits at most six registers per port, so its 
+ * bus cost does not grow with the number of pins.
+ */
+static const BenchCase_t BenchCases[] =
+{
+/*  Function         Wrapper             Sizes
+ *  Fixed limit                  Unit limit              Bytes  Period  Bus
+ */
+    {"DIO_init",      BENCH_dioInit,      BenchInitSizes, 7,
+     BENCH_LIMIT(160, 600),       BENCH_LIMIT(0, 60),     0,     0,      0},
+    {"DIO_initImage", BENCH_dioInitImage, BenchSingle,    1,
+     BENCH_LIMIT(80, 200),        0,                      0,     0,      0},
+    {"DIO_pinConfigure", BENCH_dioPinConfigure, BenchSingle, 1,
+     BENCH_LIMIT(50, 200),        0,                      0,     0,      0},
+    {"DIO_pinRead",   BENCH_dioPinRead,   BenchSingle,    1,
+     BENCH_LIMIT(4, 40),          0,                      0,     0,      0},
+    {"DIO_pinWrite",  BENCH_dioPinWrite,  BenchSingle,    1,
+     BENCH_LIMIT(3, 50),          0,                      0,     0,      0},
+    {"DIO_pinToggle", BENCH_dioPinToggle, BenchToggles,   2,
+     0,                           BENCH_LIMIT(8, 40),     0,     0,      0},
+    {"DIO_pinSet",    BENCH_dioPinSet,    BenchSingle,    1,
+     BENCH_LIMIT(3, 10),          0,                      0,     0,      0},
+    {"DIO_pinClear",  BENCH_dioPinClear,  BenchSingle,    1,
+     BENCH_LIMIT(3, 10),          0,                      0,     0,      0},
+    {"DIO_pinToggleFast", BENCH_dioPinToggleFast, BenchToggles, 2,
+     0,                           BENCH_LIMIT(6, 16),     0,     0,      0},
+    {"DIO_portWrite", BENCH_dioPortWrite, BenchSingle,    1,
+     BENCH_LIMIT(3, 30),          0,                      0,     0,      0},
+    {"DIO_portRead",  BENCH_dioPortRead,  BenchSingle,    1,
+     BENCH_LIMIT(4, 30),          0,                      0,     0,      0},
+    {"DIO_groupWrite", BENCH_dioGroupWrite, BenchSingle,  1,
+     BENCH_LIMIT(8, 200),         0,                      0,     0,      0},
+    {"DIO_groupRead", BENCH_dioGroupRead, BenchSingle,    1,
+     BENCH_LIMIT(12, 200),        0,                      0,     0,      0},
+    {"DIO_batch",     BENCH_dioBatch,     BenchBatchSizes, 3,
+     BENCH_LIMIT(6, 60),          BENCH_LIMIT(0, 30),     0,     0,      0},
+    {"DIO_pinWrite_x", BENCH_dioPinWriteAll, BenchBatchSizes, 3,
+     0,                           BENCH_LIMIT(2, 50),     0,     0,      0},
+    {"DIO_parallelWrite", BENCH_dioParallelWrite, BenchBurstSizes, 3,
+     BENCH_LIMIT(0, 40),          BENCH_LIMIT(4, 16),     1,     0,      0},
+    {"DIO_parallelRead", BENCH_dioParallelRead, BenchBurstSizes, 3,
+     BENCH_LIMIT(20, 200),        BENCH_LIMIT(7, 30),     1,     0,      0},
+    {"DIO_parallelWrite16", BENCH_dioParallelWrite16, BenchBurstSizes, 3,
+     BENCH_LIMIT(0, 40),          BENCH_LIMIT(4, 16),     1,     0,      0},
+    {"DIO_stream",    BENCH_dioStream,    BenchSingle,    1,
+     BENCH_LIMIT(120, 400),       0,                      0,     0,      0},
+    {"DIO_capture",   BENCH_dioCapture,   BenchSingle,    1,
+     BENCH_LIMIT(130, 400),       0,                      0,     0,      0},
+    {"DIO_extiEvent", BENCH_dioExtiEvent, BenchSingle,    1,
+     BENCH_LIMIT(60, 200),        0,                      0,     0,      0},
+    {"DIO_debounceTick", BENCH_dioDebounceTick, BenchDebounceSizes, 3,
+     BENCH_LIMIT(0, 40),          BENCH_LIMIT(6, 60),     0,     0,      0},
+    {"DIO_keypadFrame", BENCH_dioKeypadFrame, BenchKeypadSizes, 2,
+     BENCH_LIMIT(0, 200),         BENCH_LIMIT(8, 105),    0,     0,      0},
+    {"DIO_pwmPeriod", BENCH_dioPwmPeriod, BenchPwmSizes,  3,
+     BENCH_LIMIT(100, 200),       BENCH_LIMIT(100, 150),
+     0,     BENCH_DIO_PWM_CYCLES, 0},
+};
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: BENCH_configFill()
+*//**
+ *\b Description:
+ * This function is used to fill the DIO_init table. The pins walk through
+ * ports A, B and C (skipping the SWD pins) and the settings cycle through
+ * every mode, type, speed, resistor and alternate function, so the table
+ * exercises every branch of the driver.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void BENCH_configFill(void)
+{
+    uint32_t pin = 0;
+
+    for(uint32_t i = 0; i < BENCH_DIO_TABLE_SIZE; i++)
+    {
+        /* PA13 and PA14 are the SWD lines of the ST-LINK */
+        if((pin == 13U) || (pin == 14U))
+        {
+            pin = 15U;
+        }
+
+        BenchConfig[i].Port = (DioPort_t)((pin / 16U) % 3U);
+        BenchConfig[i].Pin = (DioPin_t)(pin % 16U);
+        BenchConfig[i].Mode = (i & 1U) ? DIO_ANALOG : DIO_INPUT;
+        BenchConfig[i].Type = (DioType_t)(i % DIO_MAX_TYPE);
+        BenchConfig[i].Speed = (DioSpeed_t)(i % DIO_MAX_SPEED);
+        BenchConfig[i].Resistor = (DioResistor_t)(i % DIO_MAX_RESISTOR);
+        BenchConfig[i].Function = (DioFunction_t)(i % DIO_MAX_FUNCTION);
+
+        pin = (pin + 1U) % 48U;
+    }
+}
+
+/* Wrappers performing one call of each function under test */
+static void BENCH_dioInit(uint32_t param)
+{
+    DIO_init(BenchConfig, param);
+}
+
+static void BENCH_dioInitImage(uint32_t param)
+{
+    DIO_initImage(DIO_configImageGet());
+    (void)param;
+}
+
+static void BENCH_dioPinConfigure(uint32_t param)
+{
+    DIO_pinConfigure(&BenchPinConfig);
+    (void)param;
+}
+
+static void BENCH_dioPinRead(uint32_t param)
+{
+    volatile DioPinState_t state = DIO_pinRead(&BenchPin);
+    (void)state;
+    (void)param;
+}
+
+static void BENCH_dioPinWrite(uint32_t param)
+{
+    DIO_pinWrite(&BenchPin, DIO_HIGH);
+    (void)param;
+}
+
+static void BENCH_dioPinToggle(uint32_t param)
+{
+    for(uint32_t i = 0; i < param; i++)
+    {
+        DIO_pinToggle(&BenchPin);
+    }
+}
+
+static void BENCH_dioPinSet(uint32_t param)
+{
+    DIO_pinSet(&BenchHandle);
+    (void)param;
+}
+
+static void BENCH_dioPinClear(uint32_t param)
+{
+    DIO_pinClear(&BenchHandle);
+    (void)param;
+}
+
+static void BENCH_dioPinToggleFast(uint32_t param)
+{
+    for(uint32_t i = 0; i < param; i++)
+    {
+        DIO_pinToggleFast(&BenchHandle);
+    }
+}
+
+static void BENCH_dioPortWrite(uint32_t param)
+{
+    DIO_portWrite(DIO_PA, 0x00FFU, 0x0056U);
+    (void)param;
+}
+
+static void BENCH_dioPortRead(uint32_t param)
+{
+    volatile uint16_t state = DIO_portRead(DIO_PA);
+    (void)state;
+    (void)param;
+}
+
+static void BENCH_dioGroupWrite(uint32_t param)
+{
+    DIO_groupWrite(&BenchGroup, 0x56U);
+    (void)param;
+}
+
+static void BENCH_dioGroupRead(uint32_t param)
+{
+    volatile uint32_t state = DIO_groupRead(&BenchGroup);
+    (void)state;
+    (void)param;
+}
+
+/* Batch of param pins (alternating levels) against param DIO_pinWrite */
+static void BENCH_dioBatch(uint32_t param)
+{
+    DioBatch_t Batch;
+
+    DIO_batchBegin(&Batch);
+    for(uint32_t i = 0; i < param; i++)
+    {
+        if(i & 1U)
+        {
+            DIO_batchClear(&Batch, &BenchBatchPins[i]);
+        }
+        else
+        {
+            DIO_batchSet(&Batch, &BenchBatchPins[i]);
+        }
+    }
+    DIO_batchCommit(&Batch);
+}
+
+static void BENCH_dioPinWriteAll(uint32_t param)
+{
+    for(uint32_t i = 0; i < param; i++)
+    {
+        DIO_pinWrite(&BenchBatchPins[i], (i & 1U) ? DIO_LOW : DIO_HIGH);
+    }
+}
+
+static void BENCH_dioParallelWrite(uint32_t param)
+{
+    DIO_parallelWrite(&BenchBus8, BenchBurst, param);
+}
+
+static void BENCH_dioParallelRead(uint32_t param)
+{
+    DIO_parallelRead(&BenchBus8, BenchBurst, param);
+}
+
+static void BENCH_dioParallelWrite16(uint32_t param)
+{
+    DIO_parallelWrite(&BenchBus16, BenchBurst, param);
+}
+
+static void BENCH_dioStream(uint32_t param)
+{
+    DIO_streamStart(&BenchWaveConfig);
+    DIO_streamStop();
+    (void)param;
+}
+
+static void BENCH_dioCapture(uint32_t param)
+{
+    DIO_captureStart(&BenchCaptureConfig);
+    DIO_captureStop();
+    (void)param;
+}
+
+static void BENCH_dioExtiEvent(uint32_t param)
+{
+    DioExtiEvent_t Event;
+
+    REG_WRITE32(&EXTI->SWIER, 1UL<<DIO_PC13);
+    while(!DIO_extiEventGet(&Event))
+    {
+    }
+    (void)param;
+}
+
+static void BENCH_dioDebounceTick(uint32_t param)
+{
+    (void)DIO_debounceTick(&BenchDebounce[param - 1U]);
+}
+
+/*****************************************************************************
+ * Function: BENCH_pwmSelect()
+*//**
+ *\b Description:
+ * This function is used to run the PWM with the requested channels. The
+ * PWM is restarted only when the number of channels changes (the cheapest
+ * run of a case is kept), and its counter is stopped at 0 so the handler
+ * runs only when the benchmark pends its interrupt, and applies one event
+ * each time. The duties are distinct: one event per channel.
+ *
+ * @param[in]   channels is 8, 16 or 32.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void BENCH_pwmSelect(uint32_t channels)
+{
+    static uint32_t selected = 0;
+
+    if(selected != channels)
+    {
+        DIO_pwmInit(&BenchPwmConfig[channels / 16U]);
+        REG_CLEAR32(&TIM2->CR1, TIM_CR1_CEN);
+        REG_WRITE32(&TIM2->CNT, 0);
+        REG_WRITE32(&TIM2->SR, 0);
+        for(uint8_t i = 0; i < channels; i++)
+        {
+            DIO_pwmDutySet(i, (i * 37U) % BENCH_DIO_PWM_PERIOD);
+        }
+        DIO_pwmCommit();
+        /* The period of the zero duties swaps in the committed table */
+        TIM2_IRQHandler();
+#ifdef HOST_BUILD
+        BenchPwmShifts = 0;
+        for(uint32_t i = 0; i < channels; i++)
+        {
+            for(uint32_t j = 0; j < i; j++)
+            {
+                if(((j * 37U) % BENCH_DIO_PWM_PERIOD) > 
+                   ((i * 37U) % BENCH_DIO_PWM_PERIOD))
+                {
+                    BenchPwmShifts++;
+                }
+            }
+        }
+#endif
+        selected = channels;
+    }
+}
+
+static void BENCH_dioPwmPeriod(uint32_t param)
+{
+    BENCH_pwmSelect(param);
+    DIO_pwmCommit();
+#ifdef HOST_BUILD
+    SIM_idle((param * BENCH_DIO_PWM_CHANNEL_CYCLES) + 
+             (BenchPwmShifts * BENCH_DIO_PWM_SHIFT_CYCLES));
+#endif
+    /* The last event swaps in the committed table for the next period */
+    for(uint32_t event = 0; event < param; event++)
+    {
+        NVIC_SetPendingIRQ(TIM2_IRQn);
+    }
+}
+
+static void BENCH_dioKeypadFrame(uint32_t param)
+{
+    DioKeypad_t * const Keypad = &BenchKeypad[param / 8U];
+
+    for(uint32_t i = 0; i < param; i++)
+    {
+        (void)DIO_keypadTick(Keypad);
+    }
+}
+
+int main(void)
+{
+    /* Enable clock access to the GPIO ports of the benchmark tables*/
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN;
+    /* Enable clock access to the DMA and timer of the waveform stream*/
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+    RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+    /* Enable clock access to SYSCFG for the EXTI lines*/
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    /* Enable clock access to the timer of the software PWM*/
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+    BENCH_configFill();
+    BenchHandle = DIO_pinHandleGet(&BenchPin);
+    DIO_groupInit(&BenchGroup, BenchGroupPins,
+                  sizeof(BenchGroupPins)/sizeof(BenchGroupPins[0]));
+    DIO_parallelInit(&BenchBus8, &BenchBus8Config);
+    DIO_parallelInit(&BenchBus16, &BenchBus16Config);
+    DIO_extiInit(&BenchExtiConfig, 1);
+    for(uint32_t i = 0; i < 3U; i++)
+    {
+        DIO_debounceInit(&BenchDebounce[i], BenchDebounceConfig, i + 1U);
+    }
+    DIO_keypadInit(&BenchKeypad[0], &BenchKeypadConfig[0]);
+    DIO_keypadInit(&BenchKeypad[1], &BenchKeypadConfig[1]);
+    for(uint32_t i = 0; i < DIO_PWM_MAX_CHANNELS; i++)
+    {
+        BenchPwmPins[i].Port = (i < 13U) ? DIO_PA : 
+                               (i < 29U) ? DIO_PB : DIO_PC;
+        BenchPwmPins[i].Pin = (DioPin_t)((i < 13U) ? i : 
+                                         (i < 29U) ? (i - 13U) : (i - 29U));
+    }
+    for(uint32_t i = 0; i < 3U; i++)
+    {
+        BenchPwmConfig[i].Channels = BenchPwmPins;
+        BenchPwmConfig[i].channels = (uint8_t)(8U << i);
+        BenchPwmConfig[i].period = BENCH_DIO_PWM_PERIOD;
+        BenchPwmConfig[i].prescaler = BENCH_DIO_PWM_PRESCALER;
+    }
+    for(uint32_t i = 0; i < BENCH_DIO_BURST_SIZE; i++)
+    {
+        BenchBurst[i] = (uint8_t)(i * 7U);
+    }
+    for(uint32_t i = 0; i < BENCH_DIO_WAVE_SIZE; i++)
+    {
+        BenchWave[i] = DIO_streamWordGet(0x00FFU, (i & 1U) ? 0xFFFFU : 0U);
+    }
+
+    BENCH_init("dio");
+    BENCH_run(BenchCases, sizeof(BenchCases)/sizeof(BenchCases[0]));
+    uint32_t failures = BENCH_finish();
+
+#ifdef HOST_BUILD
+    return (failures == 0U) ? 0 : 1;
+#else
+    /* Stop here, the results are read through the debugger */
+    (void)failures;
+    while(1)
+    {
+    }
+#endif
+}
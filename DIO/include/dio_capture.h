@@ -0,0 +1,92 @@
+/**
+ * @file dio_capture.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DIO logic capture. This is the
+ * header file for the definition of a logic analyzer mode: the IDR of a
+ * whole port is sampled by DMA2 at a fixed rate, paced by TIM1, into a
+ * circular buffer, with an optional run-length compressor.
+ * @version 1.0
+ * @date 2025-04-10
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_CAPTURE_H_
+#define DIO_CAPTURE_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the DMA2 channel of the TIM1_CH1 request (stream 1) */
+#define DIO_CAPTURE_DMA_CHANNEL 6U
+
+/** Defines the longest run of the compressor in samples */
+#define DIO_CAPTURE_MAX_RUN     0xFFFFU
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines a run of the compressor: Length consecutive samples that read
+ * Value on the pins of the mask.
+ */
+typedef struct
+{
+    uint16_t Value;             /**< Pins of the mask during the run */
+    uint16_t Length;            /**< Samples of the run (1 or more) */
+}DioCaptureRun_t;
+
+/**
+ * Defines the callback of the raw samples. It receives the half of the
+ * buffer that the DMA has just filled, before it is overwritten. It runs
+ * in the DMA interrupt.
+ */
+typedef void (*DioCaptureCallback_t)(const uint16_t * const Samples,
+                                     uint16_t size);
+
+/**
+ * Defines the callback of the compressor. It receives the runs closed
+ * since the last call; the run still open is held back until the pins
+ * change. It runs in the DMA interrupt.
+ */
+typedef void (*DioCaptureRunCallback_t)(const DioCaptureRun_t * const Runs,
+                                        uint16_t count);
+
+/**
+ * Defines a logic capture. Each sample is the IDR of the port; the buffer
+ * is filled in a loop until DIO_captureStop.
+ */
+typedef struct
+{
+    DioPort_t Port;                     /**< Port sampled */
+    uint16_t *Buffer;                   /**< Samples, in SRAM */
+    uint16_t size;                      /**< Samples of the buffer (even) */
+    uint16_t period;                    /**< TIM1 cycles per sample (>= 2) */
+    DioCaptureCallback_t Samples;       /**< Raw halves (or NULL) */
+    uint16_t mask;                      /**< Pins compressed */
+    DioCaptureRun_t *Runs;              /**< Runs of the compressor */
+    uint16_t runsSize;                  /**< Runs of Runs (0, no compressor)*/
+    DioCaptureRunCallback_t RunsReady;  /**< Closed runs (or NULL) */
+}DioCaptureConfig_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DIO_captureStart(const DioCaptureConfig_t * const Config);
+void DIO_captureStop(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*DIO_CAPTURE_H_*/
@@ -17,6 +17,7 @@
 * Includes
 *****************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
 
 /*****************************************************************************
 * Preprocessor Constants
@@ -26,6 +27,23 @@
  */
 #define NUMBER_OF_PORTS 5U
 
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Defines the reset value of the configuration registers of each port 
+ * (RM0368). The debug pins of ports A and B are configured out of reset,
+ * the other registers reset to zero.
+ */
+#define DIO_RESET_MODER(port)       \
+    (((port) == DIO_PA) ? 0xA8000000UL : ((port) == DIO_PB) ? 0x00000280UL : 0UL)
+#define DIO_RESET_OTYPER(port)      (0UL)
+#define DIO_RESET_OSPEEDR(port)     \
+    (((port) == DIO_PA) ? 0x0C000000UL : ((port) == DIO_PB) ? 0x000000C0UL : 0UL)
+#define DIO_RESET_PUPDR(port)       \
+    (((port) == DIO_PA) ? 0x64000000UL : ((port) == DIO_PB) ? 0x00000100UL : 0UL)
+#define DIO_RESET_AFR(port)         (0UL)
+
 /*****************************************************************************
 * Typedefs
 *****************************************************************************/
@@ -184,6 +202,19 @@ typedef enum
     DIO_MAX_FUNCTION/**< Defines the maximum function value */
 }DioFunction_t;
 
+/**
+ * Defines the edges of an input pin that raise its external interrupt
+ * line (EXTI). The lines are set up by DIO_extiInit.
+ */
+typedef enum
+{
+    DIO_NO_TRIGGER,     /**< The pin does not use its EXTI line */
+    DIO_RISING_EDGE,    /**< Rising edges raise the line */
+    DIO_FALLING_EDGE,   /**< Falling edges raise the line */
+    DIO_BOTH_EDGES,     /**< Both edges raise the line */
+    DIO_MAX_TRIGGER     /**< Defines the maximum trigger value */
+}DioTrigger_t;
+
 /**
  * Defines the digital input/output configuration table's elements that are 
  * used by Dio_Init to configure the Dio peripheral.
@@ -197,8 +228,44 @@ typedef struct
     DioSpeed_t Speed;           /**< Low, Medium, High, very */
     DioResistor_t Resistor;     /**< Enabled or Disabled */
     DioFunction_t Function;     /**< Mux Function - Dio_Peri_Select */
+    DioTrigger_t Trigger;       /**< Edges raising the EXTI line */
 }DioConfig_t;
 
+/**
+ * Defines the configuration registers of a port, in the order of the 
+ * register map. The alternate function is split in AFRL (pins 0-7) and
+ * AFRH (pins 8-15).
+ */
+typedef enum
+{
+    DIO_MODER,      /**< Port mode register */
+    DIO_OTYPER,     /**< Port output type register */
+    DIO_OSPEEDR,    /**< Port output speed register */
+    DIO_PUPDR,      /**< Port pull-up/pull-down register */
+    DIO_AFRL,       /**< Alternate function low register */
+    DIO_AFRH,       /**< Alternate function high register */
+    DIO_MAX_REGISTER/**< Defines the maximum register value */
+}DioRegister_t;
+
+/**
+ * Defines the bits of a configuration register that are written (mask) and
+ * the value they take.
+ */
+typedef struct
+{
+    uint32_t Mask;              /**< Bits written on the register */
+    uint32_t Value;             /**< Value of the written bits */
+}DioRegisterImage_t;
+
+/**
+ * Defines the image of the configuration registers of a port. It is 
+ * gathered from the configuration table by DIO_init, or folded at compile
+ * time by the dio_cfg module.
+ */
+typedef struct
+{
+    DioRegisterImage_t Register[DIO_MAX_REGISTER]; /**< Register images */
+}DioPortImage_t;
 
 /*****************************************************************************
 * Function Prototypes
@@ -209,6 +276,7 @@ extern "C"{
 
 const DioConfig_t * const DIO_configGet(void);
 size_t DIO_configSizeGet(void);
+const DioPortImage_t * DIO_configImageGet(void);
 
 #ifdef __cplusplus
 } //extern "C"
@@ -0,0 +1,108 @@
+/**
+ * @file dio_debounce.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DIO debouncer. This is the header
+ * file for the definition of a bit-parallel debouncer: the IDR of each port
+ * is read once per tick and its 16 pins are filtered together with
+ * vertical counters.
+ * @version 1.0
+ * @date 2025-04-11
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_DEBOUNCE_H_
+#define DIO_DEBOUNCE_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the number of bit planes of the vertical counters */
+#define DIO_DEBOUNCE_PLANES     4U
+
+/** Defines the maximum filter depth in ticks (2^planes - 1) */
+#define DIO_DEBOUNCE_MAX_DEPTH  ((1U<<DIO_DEBOUNCE_PLANES) - 1U)
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the pins of a port to debounce. A pin takes a new level after
+ * depth consecutive ticks at that level.
+ */
+typedef struct
+{
+    DioPort_t Port;             /**< The I/O port */
+    uint16_t mask;              /**< Pins debounced */
+    uint8_t depth;              /**< Filter depth in ticks (1-15) */
+}DioDebounceConfig_t;
+
+/**
+ * Defines the debouncer of a port. Plane[b] holds the bit b of the 16
+ * vertical counters, one per pin: the ticks the pin has read against its
+ * debounced level.
+ */
+typedef struct
+{
+    uint32_t volatile *Idr;     /**< Input data register of the port */
+    uint16_t Mask;              /**< Pins debounced (0, port not used) */
+    uint16_t State;             /**< Debounced level of the pins */
+    uint16_t Changed;           /**< Pins that changed on the last tick */
+    uint16_t Plane[DIO_DEBOUNCE_PLANES];    /**< Vertical counters */
+    uint8_t Depth;              /**< Filter depth in ticks */
+}DioDebouncePort_t;
+
+/**
+ * Defines a debouncer, one entry per port of the MCU. It is built by
+ * DIO_debounceInit and run by DIO_debounceTick.
+ */
+typedef struct
+{
+    DioDebouncePort_t Port[NUMBER_OF_PORTS];    /**< Debouncer of each port */
+}DioDebounce_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DIO_debounceInit(DioDebounce_t * const Debounce,
+                      const DioDebounceConfig_t * const Config, size_t size);
+bool DIO_debounceTick(DioDebounce_t * const Debounce);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+/*****************************************************************************
+* Inline Function Definitions
+*****************************************************************************/
+/**
+ * Get the debounced level of the pins of a port (pins not debounced read 0).
+ */
+static inline uint16_t DIO_debounceStateGet(const DioDebounce_t * const
+                                            Debounce, DioPort_t Port)
+{
+    return Debounce->Port[Port].State;
+}
+
+/**
+ * Get the pins of a port whose debounced level changed on the last tick.
+ */
+static inline uint16_t DIO_debounceChangedGet(const DioDebounce_t * const
+                                              Debounce, DioPort_t Port)
+{
+    return Debounce->Port[Port].Changed;
+}
+
+#endif /*DIO_DEBOUNCE_H_*/
@@ -0,0 +1,80 @@
+/**
+ * @file dio_exti.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DIO external interrupts. This is
+ * the header file for the definition of an edge-triggered input engine:
+ * the EXTI lines of the pins with a trigger in the configuration table
+ * raise interrupts that call per-line callbacks and fill an event queue
+ * the application can sleep on.
+ * @version 1.0
+ * @date 2025-04-11
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_EXTI_H_
+#define DIO_EXTI_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the number of EXTI lines of the GPIO pins (one per pin number) */
+#define DIO_EXTI_LINES          16U
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+/**
+ * Defines the number of events held by the queue. It must be a power of
+ * two; the events that find the queue full are dropped and counted.
+ */
+#ifndef DIO_EXTI_QUEUE_SIZE
+#define DIO_EXTI_QUEUE_SIZE     16U
+#endif
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines an edge event: the pin whose line was raised and its level read
+ * in the interrupt.
+ */
+typedef struct
+{
+    DioPort_t Port;             /**< The I/O port */
+    DioPin_t Pin;               /**< The I/O pin (EXTI line) */
+    DioPinState_t State;        /**< Level of the pin after the edge */
+}DioExtiEvent_t;
+
+/**
+ * Defines the callback of an EXTI line. It runs in the interrupt, before
+ * the event is read from the queue.
+ */
+typedef void (*DioExtiCallback_t)(const DioExtiEvent_t * const Event);
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DIO_extiInit(const DioConfig_t * const Config, size_t configSize);
+void DIO_extiCallbackRegister(DioPin_t Line, DioExtiCallback_t Callback);
+bool DIO_extiEventGet(DioExtiEvent_t * const Event);
+void DIO_extiWait(void);
+uint32_t DIO_extiDroppedGet(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*DIO_EXTI_H_*/
@@ -0,0 +1,99 @@
+/**
+ * @file dio_keypad.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DIO keypad. This is the header
+ * file for the definition of a non-blocking key matrix scanner: one row is
+ * driven with one BSRR store and all the columns are read with one IDR
+ * load per tick, with ghosting detection and n-key rollover.
+ * @version 1.0
+ * @date 2025-04-12
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_KEYPAD_H_
+#define DIO_KEYPAD_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the maximum number of rows of the matrix */
+#define DIO_KEYPAD_MAX_ROWS     8U
+
+/** Defines the maximum number of columns of the matrix */
+#define DIO_KEYPAD_MAX_COLUMNS  8U
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the pins of a key matrix. The rows share a port and are driven
+ * low one at a time; the columns share a port and read low on a pressed
+ * key of the driven row.
+ */
+typedef struct
+{
+    const DioPinConfig_t *Rows;     /**< Row pins, open-drain outputs */
+    uint8_t rows;                   /**< Number of rows */
+    const DioPinConfig_t *Columns;  /**< Column pins, pulled-up inputs */
+    uint8_t columns;                /**< Number of columns */
+}DioKeypadConfig_t;
+
+/**
+ * Defines a key matrix scanner. It is built by DIO_keypadInit and run by
+ * DIO_keypadTick. The rows of a frame are kept as raw column masks of
+ * the column port.
+ */
+typedef struct
+{
+    uint32_t volatile *RowBsrr;                 /**< BSRR of the row port */
+    uint32_t volatile *ColumnIdr;               /**< IDR of the column port */
+    uint32_t RowWord[DIO_KEYPAD_MAX_ROWS];      /**< BSRR word of each row */
+    uint16_t ColumnMask;                        /**< Column pins */
+    uint8_t ColumnPin[DIO_KEYPAD_MAX_COLUMNS];  /**< Pin of each column */
+    uint16_t Scan[DIO_KEYPAD_MAX_ROWS];         /**< Frame being scanned */
+    uint16_t Keys[DIO_KEYPAD_MAX_ROWS];         /**< Last clean frame */
+    uint8_t Rows;                               /**< Number of rows */
+    uint8_t Columns;                            /**< Number of columns */
+    uint8_t Row;                                /**< Row being driven */
+    bool Ghost;                                 /**< Last frame ghosted */
+}DioKeypad_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DIO_keypadInit(DioKeypad_t * const Keypad,
+                    const DioKeypadConfig_t * const Config);
+bool DIO_keypadTick(DioKeypad_t * const Keypad);
+size_t DIO_keypadKeysGet(const DioKeypad_t * const Keypad,
+                         uint8_t * const Keys, size_t size);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+/*****************************************************************************
+* Inline Function Definitions
+*****************************************************************************/
+/**
+ * Get whether the last frame was ghosted: the keys of the last clean
+ * frame are kept until the ambiguous keys are released.
+ */
+static inline bool DIO_keypadGhostGet(const DioKeypad_t * const Keypad)
+{
+    return Keypad->Ghost;
+}
+
+#endif /*DIO_KEYPAD_H_*/
@@ -0,0 +1,113 @@
+/**
+ * @file dio_parallel.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the parallel bus. This is the header
+ * file for the definition of an 8080-style 8/16 bits parallel bus (LCD,
+ * FIFO) driven over arbitrary DIO pins, that can be spread over several
+ * ports.
+ * @version 1.0
+ * @date 2025-04-09
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_PARALLEL_H_
+#define DIO_PARALLEL_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the maximum width of the bus in bits */
+#define DIO_PARALLEL_MAX_WIDTH  16U
+
+/** Defines the number of data bits encoded by a lookup table (a byte) */
+#define DIO_PARALLEL_LANE_BITS  8U
+
+/** Defines the maximum number of byte lanes of the bus */
+#define DIO_PARALLEL_MAX_LANES  (DIO_PARALLEL_MAX_WIDTH/DIO_PARALLEL_LANE_BITS)
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+/**
+ * Defines the maximum number of ports written by the bus (data and WR
+ * strobe). Each port costs a lookup table of 1 kB per lane.
+ */
+#ifndef DIO_PARALLEL_MAX_PORTS
+#define DIO_PARALLEL_MAX_PORTS  3U
+#endif
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the pins of a parallel bus. Data[i] is the bit i of the bus, the
+ * strobes are active low (idle high) as in the 8080 interface.
+ */
+typedef struct
+{
+    const DioPinConfig_t *Data; /**< Data pins, bit 0 first */
+    uint8_t Width;              /**< Width of the bus (8 or 16 bits) */
+    DioPinConfig_t Wr;          /**< Write strobe, data latched rising */
+    DioPinConfig_t Rd;          /**< Read strobe, data driven while low */
+}DioParallelConfig_t;
+
+/**
+ * Defines a run of data pins that are consecutive both on their port and
+ * on the bus. A read gathers a whole run with one shift and one mask.
+ */
+typedef struct
+{
+    uint8_t Port;               /**< Index of the port on the bus */
+    uint8_t PinShift;           /**< First pin of the run on the port */
+    uint8_t BitShift;           /**< First bit of the run on the bus */
+    uint16_t Mask;              /**< Mask of the run, aligned to bit 0 */
+}DioParallelRun_t;
+
+/**
+ * Defines a parallel bus. It is built once by DIO_parallelInit, which
+ * precomputes for every byte lane and port the BSRR word of each data byte.
+ * The object holds the lookup tables (up to 6 kB), declare it static.
+ */
+typedef struct
+{
+    /** BSRR word of each data byte, per lane and port */
+    uint32_t Lut[DIO_PARALLEL_MAX_LANES][DIO_PARALLEL_MAX_PORTS][256];
+    uint32_t volatile *Bsrr[DIO_PARALLEL_MAX_PORTS];  /**< BSRR per port */
+    uint32_t volatile *Idr[DIO_PARALLEL_MAX_PORTS];   /**< IDR per port */
+    DioPort_t Port[DIO_PARALLEL_MAX_PORTS];           /**< Ports used */
+    uint16_t DataMask[DIO_PARALLEL_MAX_PORTS];        /**< Data pins */
+    DioParallelRun_t Run[DIO_PARALLEL_MAX_WIDTH];     /**< Data pin runs */
+    DioPinHandle_t Wr;          /**< Write strobe */
+    DioPinHandle_t Rd;          /**< Read strobe */
+    uint8_t Ports;              /**< Number of ports used */
+    uint8_t Lanes;              /**< Number of byte lanes (width/8) */
+    uint8_t Runs;               /**< Number of data pin runs */
+}DioParallel_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DIO_parallelInit(DioParallel_t * const Bus,
+                      const DioParallelConfig_t * const Config);
+void DIO_parallelWrite(const DioParallel_t * const Bus,
+                       const uint8_t * const Data, size_t size);
+void DIO_parallelRead(const DioParallel_t * const Bus,
+                      uint8_t * const Data, size_t size);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*DIO_PARALLEL_H_*/
@@ -0,0 +1,95 @@
+/**
+ * @file dio_pwm.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DIO software PWM. This is the
+ * header file for the definition of a multi-channel PWM on arbitrary DIO
+ * outputs: the duty cycles are sorted into a list of edge events, and a
+ * TIM2 compare interrupt applies the edges due at the same instant with
+ * one BSRR store per port.
+ * @version 1.0
+ * @date 2025-04-12
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_PWM_H_
+#define DIO_PWM_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the maximum number of channels */
+#define DIO_PWM_MAX_CHANNELS    32U
+
+/** Defines the maximum number of events of a period (one per duty + 0) */
+#define DIO_PWM_MAX_EVENTS      (DIO_PWM_MAX_CHANNELS + 1U)
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+/**
+ * Defines the maximum number of ports of the channels. Each port costs a
+ * word per event of the two tables.
+ */
+#ifndef DIO_PWM_MAX_PORTS
+#define DIO_PWM_MAX_PORTS       3U
+#endif
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the channels and the time base of the PWM. TIM2 counts at the
+ * timer clock divided by prescaler + 1, a period is period counts.
+ */
+typedef struct
+{
+    const DioPinConfig_t *Channels; /**< Channel pins, outputs */
+    uint8_t channels;               /**< Number of channels (1-32) */
+    uint32_t period;                /**< Counts per period (>= 2) */
+    uint16_t prescaler;             /**< TIM2 prescaler (PSC) */
+}DioPwmConfig_t;
+
+/**
+ * Defines an edge event: at Time counts from the start of the period, the
+ * Word of each port is stored in its BSRR.
+ */
+typedef struct
+{
+    uint32_t Time;                      /**< Counts from the period start */
+    uint32_t Word[DIO_PWM_MAX_PORTS];   /**< BSRR word of each port */
+}DioPwmEvent_t;
+
+/**
+ * Defines a table of events, sorted by time. The first event (time 0)
+ * raises the channels with a duty.
+ */
+typedef struct
+{
+    DioPwmEvent_t Event[DIO_PWM_MAX_EVENTS];    /**< Events of a period */
+    uint8_t Events;                             /**< Number of events */
+}DioPwmTable_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DIO_pwmInit(const DioPwmConfig_t * const Config);
+void DIO_pwmDutySet(uint8_t channel, uint32_t duty);
+void DIO_pwmCommit(void);
+void DIO_pwmStop(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*DIO_PWM_H_*/
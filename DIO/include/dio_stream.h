@@ -0,0 +1,82 @@
+/**
+ * @file dio_stream.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DIO waveform stream. This is the
+ * header file for the definition of a GPIO waveform generator: a circular
+ * buffer of BSRR words is pushed to a port by DMA2, one word per period of
+ * TIM1, without the CPU.
+ * @version 1.0
+ * @date 2025-04-10
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_STREAM_H_
+#define DIO_STREAM_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the DMA2 channel of the TIM1_UP request (stream 5) */
+#define DIO_STREAM_DMA_CHANNEL  6U
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the callback of a stream. It receives the half of the buffer
+ * that the DMA has just finished, which can be refilled while the other
+ * half is streamed. It runs in the DMA interrupt.
+ */
+typedef void (*DioStreamCallback_t)(uint32_t * const Words, uint16_t size);
+
+/**
+ * Defines a waveform stream. Each word of the buffer is a BSRR word of the
+ * port (see DIO_streamWordGet); the buffer is streamed in a loop until
+ * DIO_streamStop.
+ */
+typedef struct
+{
+    DioPort_t Port;                     /**< Port written by the stream */
+    uint32_t *Buffer;                   /**< BSRR words, in SRAM */
+    uint16_t size;                      /**< Words of the buffer (even) */
+    uint16_t period;                    /**< TIM1 cycles per word (>= 2) */
+    DioStreamCallback_t HalfComplete;   /**< First half done (or NULL) */
+    DioStreamCallback_t FullComplete;   /**< Second half done (or NULL) */
+}DioStreamConfig_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DIO_streamStart(const DioStreamConfig_t * const Config);
+void DIO_streamStop(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+/*****************************************************************************
+* Inline Function Definitions
+*****************************************************************************/
+/**
+ * Build the BSRR word that drives the pins of mask to value: the pins set
+ * in value go to the set half, the others to the reset half. The pins out
+ * of mask are not touched.
+ */
+static inline uint32_t DIO_streamWordGet(uint16_t mask, uint16_t value)
+{
+    return ((uint32_t)(mask & (uint16_t)~value) << 16U) |
+           (uint32_t)(mask & value);
+}
+
+#endif /*DIO_STREAM_H_*/
@@ -0,0 +1,81 @@
+/**
+ * @file reg_backend.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the register backend. This header
+ * selects how the drivers reach the peripheral registers: directly on the
+ * STM32F401 or through the simulated register file on a host build
+ * (HOST_BUILD defined).
+ * @version 1.0
+ * @date 2025-04-07
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef REG_BACKEND_H_
+#define REG_BACKEND_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#ifdef HOST_BUILD
+#include "stm32f4xx_sim.h"  /*Simulated STM32F401 register file*/
+#else
+#include "stm32f4xx.h"      /*Microcontroller family header*/
+#endif
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#ifdef HOST_BUILD
+/** Read a 32 bits register through the simulated register file */
+#define REG_READ32(reg)             SIM_read32((reg))
+/** Write a 32 bits register through the simulated register file */
+#define REG_WRITE32(reg, value)     SIM_write32((reg), (uint32_t)(value))
+/** Read a 16 bits register through the simulated register file */
+#define REG_READ16(reg)             SIM_read16((reg))
+/** Write a 16 bits register through the simulated register file */
+#define REG_WRITE16(reg, value)     SIM_write16((reg), (uint16_t)(value))
+/** Translate a physical register address into a 32 bits register pointer */
+#define REG_ADDRESS32(address)      \
+    ((volatile uint32_t *)SIM_address((uint32_t)(address)))
+/** Translate a physical register address into a 16 bits register pointer */
+#define REG_ADDRESS16(address)      \
+    ((volatile uint16_t *)SIM_address((uint32_t)(address)))
+/** Bus address of a register or a buffer, as programmed in a DMA stream */
+#define REG_DMA_ADDRESS(pointer)    \
+    SIM_dmaAddress((const volatile void *)(pointer))
+#else
+/** Read a 32 bits register */
+#define REG_READ32(reg)             (*(reg))
+/** Write a 32 bits register */
+#define REG_WRITE32(reg, value)     (*(reg) = (uint32_t)(value))
+/** Read a 16 bits register */
+#define REG_READ16(reg)             (*(reg))
+/** Write a 16 bits register */
+#define REG_WRITE16(reg, value)     (*(reg) = (uint16_t)(value))
+/** Cast a physical register address into a 32 bits register pointer */
+#define REG_ADDRESS32(address)      ((volatile uint32_t *)(address))
+/** Cast a physical register address into a 16 bits register pointer */
+#define REG_ADDRESS16(address)      ((volatile uint16_t *)(address))
+/** Bus address of a register or a buffer, as programmed in a DMA stream */
+#define REG_DMA_ADDRESS(pointer)    ((uint32_t)(uintptr_t)(pointer))
+#endif
+
+/** Set the bits of mask on a 32 bits register (read-modify-write) */
+#define REG_SET32(reg, mask)        \
+    REG_WRITE32((reg), REG_READ32(reg) | (uint32_t)(mask))
+/** Clear the bits of mask on a 32 bits register (read-modify-write) */
+#define REG_CLEAR32(reg, mask)      \
+    REG_WRITE32((reg), REG_READ32(reg) & ~(uint32_t)(mask))
+/** Toggle the bits of mask on a 32 bits register (read-modify-write) */
+#define REG_TOGGLE32(reg, mask)     \
+    REG_WRITE32((reg), REG_READ32(reg) ^ (uint32_t)(mask))
+/** Set the bits of mask on a 16 bits register (read-modify-write) */
+#define REG_SET16(reg, mask)        \
+    REG_WRITE16((reg), REG_READ16(reg) | (uint16_t)(mask))
+/** Clear the bits of mask on a 16 bits register (read-modify-write) */
+#define REG_CLEAR16(reg, mask)      \
+    REG_WRITE16((reg), REG_READ16(reg) & (uint16_t)~(uint16_t)(mask))
+
+#endif /*REG_BACKEND_H_*/
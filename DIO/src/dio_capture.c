@@ -0,0 +1,288 @@
+/**
+ * @file dio_capture.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DIO logic capture.
+ * @version 1.0
+ * @date 2025-04-10
+ * @note Take into account the following considerations:
+ * + TIM1_CH1 requests DMA2 stream 1 (channel 6). Only DMA2 reaches the GPIO
+ *   ports (AHB1) through its peripheral port.
+ * + The capture owns TIM1, so it does not run together with the waveform
+ *   stream (dio_stream.c).
+ * + The compressor runs in the DMA interrupt: it must go through half of
+ *   the buffer before the DMA fills it again (size/2 * period cycles).
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "dio_capture.h"    /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/** Defines the status and clear flags of DMA2 stream 1 (LISR/LIFCR) */
+#define DIO_CAPTURE_FLAGS   (DMA_LIFCR_CFEIF1 | DMA_LIFCR_CDMEIF1 | \
+                             DMA_LIFCR_CTEIF1 | DMA_LIFCR_CHTIF1 |  \
+                             DMA_LIFCR_CTCIF1)
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Capture running on DMA2 stream 1 (NULL when stopped) */
+static const DioCaptureConfig_t *ActiveCapture = NULL;
+
+/** Run of the compressor still open and runs closed in Runs */
+static DioCaptureRun_t OpenRun;
+static uint16_t ClosedRuns;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void DIO_captureCompress(const DioCaptureConfig_t * const Capture,
+                                const uint16_t * const Samples,
+                                uint16_t size);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_captureCompress()
+*//**
+ *\b Description:
+ * This function is used to run the compressor over half of the buffer. A
+ * sample that reads the value of the open run on the pins of the mask
+ * extends it, any other sample closes it. The closed runs are handed to
+ * the callback when Runs is full and at the end of the half.
+ *
+ * @param[in]   Capture is the running capture.
+ * @param[in]   Samples is the half of the buffer just filled.
+ * @param[in]   size is the number of samples.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void DIO_captureCompress(const DioCaptureConfig_t * const Capture,
+                                const uint16_t * const Samples,
+                                uint16_t size)
+{
+    const uint16_t mask = Capture->mask;
+
+    for(uint16_t i=0; i<size; i++)
+    {
+        const uint16_t value = Samples[i] & mask;
+
+        if((value == OpenRun.Value) && (OpenRun.Length < DIO_CAPTURE_MAX_RUN))
+        {
+            OpenRun.Length++;
+            continue;
+        }
+
+        if(OpenRun.Length != 0U)
+        {
+            Capture->Runs[ClosedRuns] = OpenRun;
+            ClosedRuns++;
+
+            if(ClosedRuns == Capture->runsSize)
+            {
+                if(Capture->RunsReady != NULL)
+                {
+                    Capture->RunsReady(Capture->Runs, ClosedRuns);
+                }
+                ClosedRuns = 0;
+            }
+        }
+
+        OpenRun.Value = value;
+        OpenRun.Length = 1;
+    }
+
+    if((ClosedRuns != 0U) && (Capture->RunsReady != NULL))
+    {
+        Capture->RunsReady(Capture->Runs, ClosedRuns);
+    }
+    ClosedRuns = 0;
+}
+
+/*****************************************************************************
+ * Function: DIO_captureStart()
+*//**
+ *\b Description:
+ * This function is used to start a logic capture. TIM1 counts period
+ * cycles per sample and its channel 1 compare requests DMA2 stream 1,
+ * which stores the IDR of the port in the next half-word of the buffer.
+ * The buffer is circular: on the half-transfer and transfer-complete
+ * interrupts the half just filled goes to the raw callback and through the
+ * compressor, while the DMA fills the other half. The sampling instants
+ * follow the timer clock, whatever the CPU is doing.
+ *
+ * PRE-CONDITION: The clocks of TIM1 and DMA2 are enabled. <br>
+ * PRE-CONDITION: The waveform stream is stopped (TIM1 is shared). <br>
+ * PRE-CONDITION: size is even and not zero, period is 2 or more. <br>
+ * PRE-CONDITION: The configuration and the buffers live until
+ * DIO_captureStop. <br>
+ *
+ * POST-CONDITION: The port is sampled once per period. <br>
+ *
+ * @param[in]   Config is the capture to start.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static uint16_t Samples[512];
+ * static DioCaptureRun_t Runs[64];
+ * static const DioCaptureConfig_t ButtonCapture =
+ * {
+ *      DIO_PC, Samples, 512, 84, NULL, 1U<<DIO_PC13, Runs, 64, ButtonRuns
+ * };
+ *
+ * DIO_captureStart(&ButtonCapture);
+ * @endcode
+ *
+ * @see DIO_captureStart
+ * @see DIO_captureStop
+ *
+*****************************************************************************/
+void DIO_captureStart(const DioCaptureConfig_t * const Config)
+{
+    assert(Config->Port < DIO_MAX_PORT);
+    assert((Config->size != 0U) && ((Config->size % 2U) == 0U));
+    assert(Config->period >= 2U);
+    assert((Config->runsSize == 0U) || (Config->Runs != NULL));
+
+    const DioPinConfig_t PortPin = {Config->Port, (DioPin_t)0};
+    const DioPinHandle_t Handle = DIO_pinHandleGet(&PortPin);
+
+    DIO_captureStop();
+    ActiveCapture = Config;
+    OpenRun.Value = 0;
+    OpenRun.Length = 0;
+    ClosedRuns = 0;
+
+    /* TIM1: one compare of channel 1 (output, frozen) per period */
+    REG_WRITE32(&TIM1->CR1, 0);
+    REG_WRITE32(&TIM1->PSC, 0);
+    REG_WRITE32(&TIM1->ARR, Config->period - 1U);
+    REG_WRITE32(&TIM1->CCMR1, 0);
+    REG_WRITE32(&TIM1->CCR1, 0);
+    REG_WRITE32(&TIM1->EGR, TIM_EGR_UG);
+    REG_WRITE32(&TIM1->SR, 0);
+    REG_WRITE32(&TIM1->DIER, TIM_DIER_CC1DE);
+
+    /* DMA2 stream 1: 16 bits IDR to memory, circular, half/complete
+     * interrupts
+    */
+    REG_WRITE32(&DMA2->LIFCR, DIO_CAPTURE_FLAGS);
+    REG_WRITE32(&DMA2_Stream1->PAR, REG_DMA_ADDRESS(Handle.Idr));
+    REG_WRITE32(&DMA2_Stream1->M0AR, REG_DMA_ADDRESS(Config->Buffer));
+    REG_WRITE32(&DMA2_Stream1->NDTR, Config->size);
+    REG_WRITE32(&DMA2_Stream1->FCR, 0);
+    REG_WRITE32(&DMA2_Stream1->CR,
+                (DIO_CAPTURE_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) |
+                DMA_SxCR_PL_1 | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 |
+                DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_TCIE |
+                DMA_SxCR_HTIE);
+    REG_SET32(&DMA2_Stream1->CR, DMA_SxCR_EN);
+
+    NVIC_ClearPendingIRQ(DMA2_Stream1_IRQn);
+    NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+
+    REG_SET32(&TIM1->CR1, TIM_CR1_CEN);
+}
+
+/*****************************************************************************
+ * Function: DIO_captureStop()
+*//**
+ *\b Description:
+ * This function is used to stop the logic capture. The timer stops first,
+ * then the DMA stream is disabled. The run still open is handed to the
+ * compressor callback.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: TIM1 and DMA2 stream 1 are stopped, the callbacks are
+ * no longer called. <br>
+ *
+ * @return  void
+ *
+ * @see DIO_captureStart
+ * @see DIO_captureStop
+ *
+*****************************************************************************/
+void DIO_captureStop(void)
+{
+    const DioCaptureConfig_t * const Capture = ActiveCapture;
+
+    REG_CLEAR32(&TIM1->CR1, TIM_CR1_CEN);
+    REG_WRITE32(&TIM1->DIER, 0);
+    REG_CLEAR32(&DMA2_Stream1->CR, DMA_SxCR_EN);
+
+    /* The stream finishes its current transfer before it reads disabled */
+    while((REG_READ32(&DMA2_Stream1->CR) & DMA_SxCR_EN) != 0U)
+    {
+    }
+
+    NVIC_DisableIRQ(DMA2_Stream1_IRQn);
+    REG_WRITE32(&DMA2->LIFCR, DIO_CAPTURE_FLAGS);
+    ActiveCapture = NULL;
+
+    if((Capture != NULL) && (Capture->runsSize != 0U) &&
+       (OpenRun.Length != 0U) && (Capture->RunsReady != NULL))
+    {
+        Capture->Runs[0] = OpenRun;
+        Capture->RunsReady(Capture->Runs, 1);
+    }
+    OpenRun.Length = 0;
+}
+
+/*****************************************************************************
+ * Function: DMA2_Stream1_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of DMA2 stream 1. It hands the
+ * half of the buffer that the DMA has just filled to the raw callback and
+ * to the compressor.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void DMA2_Stream1_IRQHandler(void)
+{
+    const uint32_t status = REG_READ32(&DMA2->LISR);
+    const DioCaptureConfig_t * const Capture = ActiveCapture;
+
+    REG_WRITE32(&DMA2->LIFCR, status & (DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTCIF1));
+
+    if(Capture == NULL)
+    {
+        return;
+    }
+
+    const uint16_t half = Capture->size / 2U;
+
+    /* Both flags are set when the handler ran late, the first half goes
+     * first
+    */
+    for(uint16_t part=0; part<2U; part++)
+    {
+        const uint32_t flag = (part == 0U) ? DMA_LISR_HTIF1 : DMA_LISR_TCIF1;
+        const uint16_t * const Samples = &Capture->Buffer[part * half];
+
+        if((status & flag) == 0U)
+        {
+            continue;
+        }
+
+        if(Capture->Samples != NULL)
+        {
+            Capture->Samples(Samples, half);
+        }
+        if(Capture->runsSize != 0U)
+        {
+            DIO_captureCompress(Capture, Samples, half);
+        }
+    }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file dio_debounce.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DIO debouncer.
+ * @version 1.0
+ * @date 2025-04-11
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "dio_debounce.h"   /*For this modules definitions*/
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_debounceInit()
+*//**
+ *\b Description:
+ * This function is used to build a debouncer. Each row of the table sets
+ * the pins and the filter depth of a port; the debounced level starts at
+ * the level the pins read now.
+ *
+ * PRE-CONDITION: The pins are configured as INPUT (DIO_init). <br>
+ * PRE-CONDITION: Each port appears once in the table. <br>
+ * PRE-CONDITION: depth is 1 to DIO_DEBOUNCE_MAX_DEPTH. <br>
+ *
+ * POST-CONDITION: The debouncer is ready for DIO_debounceTick. <br>
+ *
+ * @param[out]  Debounce is the debouncer to build.
+ * @param[in]   Config is the table of the ports to debounce.
+ * @param[in]   size is the number of rows of the table.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static const DioDebounceConfig_t KeysConfig[] =
+ * {
+ *      {DIO_PB, 0xF000U, 8}, {DIO_PC, 1U<<DIO_PC13, 4}
+ * };
+ * static DioDebounce_t Keys;
+ *
+ * DIO_debounceInit(&Keys, KeysConfig, 2);
+ * @endcode
+ *
+ * @see DIO_debounceInit
+ * @see DIO_debounceTick
+ *
+*****************************************************************************/
+void DIO_debounceInit(DioDebounce_t * const Debounce,
+                      const DioDebounceConfig_t * const Config, size_t size)
+{
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        DioDebouncePort_t * const Entry = &Debounce->Port[port];
+
+        Entry->Idr = NULL;
+        Entry->Mask = 0;
+        Entry->State = 0;
+        Entry->Changed = 0;
+        Entry->Depth = 0;
+        for(uint8_t plane=0; plane<DIO_DEBOUNCE_PLANES; plane++)
+        {
+            Entry->Plane[plane] = 0;
+        }
+    }
+
+    for(size_t i=0; i<size; i++)
+    {
+        assert(Config[i].Port < DIO_MAX_PORT);
+        assert((Config[i].depth >= 1U) &&
+               (Config[i].depth <= DIO_DEBOUNCE_MAX_DEPTH));
+
+        DioDebouncePort_t * const Entry = &Debounce->Port[Config[i].Port];
+        const DioPinConfig_t PortPin = {Config[i].Port, (DioPin_t)0};
+
+        assert(Entry->Mask == 0U);
+
+        Entry->Idr = DIO_pinHandleGet(&PortPin).Idr;
+        Entry->Mask = Config[i].mask;
+        Entry->Depth = Config[i].depth;
+        Entry->State = (uint16_t)(REG_READ32(Entry->Idr) & Entry->Mask);
+    }
+}
+
+/*****************************************************************************
+ * Function: DIO_debounceTick()
+*//**
+ *\b Description:
+ * This function is used to run one tick of the debouncer. Each port reads
+ * its IDR once; the vertical counters of the pins that read against their
+ * debounced level count up, the others restart. The pins whose counter
+ * reaches the depth of the port take the new level. The work is a few
+ * bitwise operations per counter plane, whatever the number of pins.
+ *
+ * PRE-CONDITION: The debouncer is built by DIO_debounceInit. <br>
+ * PRE-CONDITION: The ticks are periodic (timer interrupt or main loop). <br>
+ *
+ * POST-CONDITION: The changed pins of each port are set (see
+ * DIO_debounceChangedGet). <br>
+ *
+ * @param[in,out]   Debounce is the debouncer.
+ *
+ * @return  true when a pin of a port changed on this tick.
+ *
+ * @see DIO_debounceInit
+ * @see DIO_debounceTick
+ * @see DIO_debounceStateGet
+ * @see DIO_debounceChangedGet
+ *
+*****************************************************************************/
+bool DIO_debounceTick(DioDebounce_t * const Debounce)
+{
+    uint16_t changedAll = 0;
+
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        DioDebouncePort_t * const Entry = &Debounce->Port[port];
+
+        if(Entry->Mask == 0U)
+        {
+            continue;
+        }
+
+        const uint16_t sample = (uint16_t)REG_READ32(Entry->Idr);
+        const uint16_t delta = (sample ^ Entry->State) & Entry->Mask;
+        uint16_t carry = delta;
+        uint16_t reached = delta;
+
+        /* Count up the pins of delta (ripple carry), restart the others */
+        for(uint8_t plane=0; plane<DIO_DEBOUNCE_PLANES; plane++)
+        {
+            const uint16_t count = Entry->Plane[plane];
+
+            Entry->Plane[plane] = (count ^ carry) & delta;
+            carry &= count;
+        }
+
+        /* Pins whose counter equals the depth, plane by plane */
+        for(uint8_t plane=0; plane<DIO_DEBOUNCE_PLANES; plane++)
+        {
+            reached &= ((Entry->Depth >> plane) & 1U) ?
+                       Entry->Plane[plane] : (uint16_t)~Entry->Plane[plane];
+        }
+
+        for(uint8_t plane=0; plane<DIO_DEBOUNCE_PLANES; plane++)
+        {
+            Entry->Plane[plane] &= (uint16_t)~reached;
+        }
+
+        Entry->State ^= reached;
+        Entry->Changed = reached;
+        changedAll |= reached;
+    }
+
+    return (changedAll != 0U);
+}
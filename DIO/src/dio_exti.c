@@ -0,0 +1,392 @@
+/**
+ * @file dio_exti.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DIO external interrupts.
+ * @version 1.0
+ * @date 2025-04-11
+ * @note Take into account the following considerations:
+ * + EXTI line n is shared by the pins n of every port, SYSCFG routes one
+ *   port to it. Two pins with the same number can not both use a trigger.
+ * + The queue is written by the interrupts and read by the application.
+ *   The interrupts queue their events with the interrupts masked, so the
+ *   EXTI interrupts may have different priorities and preempt each other;
+ *   the application needs no lock, it only writes the tail.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "dio_exti.h"       /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/** Defines the lines served by each EXTI interrupt */
+#define DIO_EXTI_LINES_9_5      0x03E0UL
+#define DIO_EXTI_LINES_15_10    0xFC00UL
+
+/** Defines the width of a port field of SYSCFG_EXTICR */
+#define DIO_EXTI_SOURCE_BITS    4U
+
+_Static_assert((DIO_EXTI_QUEUE_SIZE & (DIO_EXTI_QUEUE_SIZE - 1U)) == 0U,
+               "DIO_EXTI_QUEUE_SIZE must be a power of two");
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Source code of each port in SYSCFG_EXTICR (PH is code 7) */
+static const uint8_t ExtiSource[NUMBER_OF_PORTS] = {0U, 1U, 2U, 3U, 7U};
+
+/** Port routed to each line, its input data register and its callback */
+static DioPort_t LinePort[DIO_EXTI_LINES];
+static uint32_t volatile *LineIdr[DIO_EXTI_LINES];
+static volatile DioExtiCallback_t LineCallback[DIO_EXTI_LINES];
+
+/** Event queue: Head is written by the interrupts, Tail by the reader */
+static volatile DioExtiEvent_t EventQueue[DIO_EXTI_QUEUE_SIZE];
+static volatile uint32_t EventHead = 0;
+static volatile uint32_t EventTail = 0;
+static volatile uint32_t EventDropped = 0;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void DIO_extiDispatch(uint32_t lines);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_extiDispatch()
+*//**
+ *\b Description:
+ * This function is used to serve the pending lines of an EXTI interrupt.
+ * The lines are acknowledged at once, so an edge arriving while they are
+ * served raises them again. Each line reads the level of its pin, calls
+ * its callback and queues its event. The event is queued with the 
+ * interrupts masked, an EXTI interrupt of a higher priority may preempt
+ * this one.
+ *
+ * @param[in]   lines is the mask of the lines served by the interrupt.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void DIO_extiDispatch(uint32_t lines)
+{
+    const uint32_t pending = REG_READ32(&EXTI->PR) & REG_READ32(&EXTI->IMR) &
+                             lines;
+
+    REG_WRITE32(&EXTI->PR, pending);
+
+    for(uint32_t line=0; line<DIO_EXTI_LINES; line++)
+    {
+        if((pending & (1UL<<line)) == 0U)
+        {
+            continue;
+        }
+
+        const DioPort_t Port = LinePort[line];
+        const DioExtiCallback_t Callback = LineCallback[line];
+        const DioExtiEvent_t Event =
+        {
+            Port, (DioPin_t)line,
+            (REG_READ32(LineIdr[line]) & (1UL<<line)) ? DIO_HIGH : DIO_LOW
+        };
+
+        if(Callback != NULL)
+        {
+            Callback(&Event);
+        }
+
+        /* The slot is written before the head moves past it, and no
+         * other EXTI interrupt takes the same slot meanwhile
+        */
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if((EventHead - EventTail) < DIO_EXTI_QUEUE_SIZE)
+        {
+            EventQueue[EventHead & (DIO_EXTI_QUEUE_SIZE - 1U)] = Event;
+            EventHead++;
+        }
+        else
+        {
+            EventDropped++;
+        }
+        __set_PRIMASK(primask);
+    }
+}
+
+/*****************************************************************************
+ * Function: DIO_extiInit()
+*//**
+ *\b Description:
+ * This function is used to set up the EXTI lines of the configuration
+ * table. Every pin with a trigger gets its port routed to its line, the
+ * trigger edges selected and the line unmasked; the interrupts of the
+ * lines used are enabled. Each register is written once for the table.
+ *
+ * PRE-CONDITION: The clock of SYSCFG is enabled. <br>
+ * PRE-CONDITION: The pins with a trigger are configured (DIO_init). <br>
+ * PRE-CONDITION: Two pins with a trigger do not share a pin number. <br>
+ *
+ * POST-CONDITION: The edges of the pins raise their lines, the events are
+ * queued. <br>
+ *
+ * @param[in]   Config is a pointer to the configuration table.
+ * @param[in]   configSize is the number of rows of the table.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * const DioConfig_t * const DioConfig = DIO_configGet();
+ * size_t configSize = DIO_configSizeGet();
+ *
+ * DIO_init(DioConfig, configSize);
+ * DIO_extiInit(DioConfig, configSize);
+ * @endcode
+ *
+ * @see DIO_extiInit
+ * @see DIO_extiCallbackRegister
+ * @see DIO_extiEventGet
+ * @see DIO_extiWait
+ *
+*****************************************************************************/
+void DIO_extiInit(const DioConfig_t * const Config, size_t configSize)
+{
+    uint32_t sourceMask[4] = {0};
+    uint32_t sourceValue[4] = {0};
+    uint32_t used = 0;
+    uint32_t rising = 0;
+    uint32_t falling = 0;
+
+    for(size_t i=0; i<configSize; i++)
+    {
+        assert(Config[i].Trigger < DIO_MAX_TRIGGER);
+
+        if(Config[i].Trigger == DIO_NO_TRIGGER)
+        {
+            continue;
+        }
+
+        const uint32_t line = (uint32_t)Config[i].Pin;
+        const uint32_t shift = (line % 4U) * DIO_EXTI_SOURCE_BITS;
+
+        assert(Config[i].Port < DIO_MAX_PORT);
+        assert((used & (1UL<<line)) == 0U);
+
+        const DioPinConfig_t Pin = {Config[i].Port, Config[i].Pin};
+
+        LinePort[line] = Config[i].Port;
+        LineIdr[line] = DIO_pinHandleGet(&Pin).Idr;
+        used |= 1UL<<line;
+        sourceMask[line / 4U] |= 0xFUL << shift;
+        sourceValue[line / 4U] |= (uint32_t)ExtiSource[Config[i].Port] << shift;
+
+        if((Config[i].Trigger == DIO_RISING_EDGE) ||
+           (Config[i].Trigger == DIO_BOTH_EDGES))
+        {
+            rising |= 1UL<<line;
+        }
+        if((Config[i].Trigger == DIO_FALLING_EDGE) ||
+           (Config[i].Trigger == DIO_BOTH_EDGES))
+        {
+            falling |= 1UL<<line;
+        }
+    }
+
+    for(uint32_t reg=0; reg<4U; reg++)
+    {
+        if(sourceMask[reg] != 0U)
+        {
+            REG_WRITE32(&SYSCFG->EXTICR[reg],
+                        (REG_READ32(&SYSCFG->EXTICR[reg]) & ~sourceMask[reg]) |
+                        sourceValue[reg]);
+        }
+    }
+
+    REG_WRITE32(&EXTI->RTSR, (REG_READ32(&EXTI->RTSR) & ~used) | rising);
+    REG_WRITE32(&EXTI->FTSR, (REG_READ32(&EXTI->FTSR) & ~used) | falling);
+    REG_WRITE32(&EXTI->PR, used);
+    REG_SET32(&EXTI->IMR, used);
+
+    /* Lines 0-4 have their own interrupt, 5-9 and 10-15 share one */
+    for(uint32_t line=0; line<5U; line++)
+    {
+        if(used & (1UL<<line))
+        {
+            NVIC_EnableIRQ((IRQn_Type)(EXTI0_IRQn + (int)line));
+        }
+    }
+    if(used & DIO_EXTI_LINES_9_5)
+    {
+        NVIC_EnableIRQ(EXTI9_5_IRQn);
+    }
+    if(used & DIO_EXTI_LINES_15_10)
+    {
+        NVIC_EnableIRQ(EXTI15_10_IRQn);
+    }
+}
+
+/*****************************************************************************
+ * Function: DIO_extiCallbackRegister()
+*//**
+ *\b Description:
+ * This function is used to register the callback of an EXTI line. The
+ * callback runs in the interrupt of every edge of the line; NULL removes
+ * it. The events are queued either way.
+ *
+ * PRE-CONDITION: Line is a pin number (0-15). <br>
+ *
+ * POST-CONDITION: The next edges of the line call the callback. <br>
+ *
+ * @param[in]   Line is the EXTI line (the pin number).
+ * @param[in]   Callback is the function to call, or NULL.
+ *
+ * @return  void
+ *
+ * @see DIO_extiInit
+ * @see DIO_extiCallbackRegister
+ *
+*****************************************************************************/
+void DIO_extiCallbackRegister(DioPin_t Line, DioExtiCallback_t Callback)
+{
+    assert((uint32_t)Line < DIO_EXTI_LINES);
+
+    LineCallback[Line] = Callback;
+}
+
+/*****************************************************************************
+ * Function: DIO_extiEventGet()
+*//**
+ *\b Description:
+ * This function is used to take the oldest event of the queue. It does
+ * not block and is called from the application only.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: The event is removed from the queue. <br>
+ *
+ * @param[out]  Event is filled with the oldest event.
+ *
+ * @return  true when an event was taken, false when the queue is empty.
+ *
+ * @see DIO_extiEventGet
+ * @see DIO_extiWait
+ *
+*****************************************************************************/
+bool DIO_extiEventGet(DioExtiEvent_t * const Event)
+{
+    const uint32_t tail = EventTail;
+
+    if(tail == EventHead)
+    {
+        return false;
+    }
+
+    *Event = EventQueue[tail & (DIO_EXTI_QUEUE_SIZE - 1U)];
+
+    /* The slot is read before the tail frees it */
+    EventTail = tail + 1U;
+
+    return true;
+}
+
+/*****************************************************************************
+ * Function: DIO_extiWait()
+*//**
+ *\b Description:
+ * This function is used to sleep (WFI) until the queue holds an event.
+ * The queue is checked with the interrupts masked, so an edge arriving
+ * between the check and the WFI still wakes the core.
+ *
+ * PRE-CONDITION: DIO_extiInit has set up at least one line. <br>
+ *
+ * POST-CONDITION: The queue holds at least one event. <br>
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * DioExtiEvent_t Event;
+ *
+ * while(1)
+ * {
+ *      DIO_extiWait();
+ *      while(DIO_extiEventGet(&Event))
+ *      {
+ *          ...
+ *      }
+ * }
+ * @endcode
+ *
+ * @see DIO_extiEventGet
+ * @see DIO_extiWait
+ *
+*****************************************************************************/
+void DIO_extiWait(void)
+{
+    __disable_irq();
+    while(EventHead == EventTail)
+    {
+        /* A pending interrupt wakes the core even while it is masked */
+        __WFI();
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+
+/*****************************************************************************
+ * Function: DIO_extiDroppedGet()
+*//**
+ *\b Description:
+ * This function is used to get the number of events dropped because the
+ * queue was full.
+ *
+ * @return  The number of events dropped since the start.
+ *
+*****************************************************************************/
+uint32_t DIO_extiDroppedGet(void)
+{
+    return EventDropped;
+}
+
+/* Interrupt handlers of the EXTI lines of the GPIO pins */
+void EXTI0_IRQHandler(void)
+{
+    DIO_extiDispatch(1UL<<0);
+}
+
+void EXTI1_IRQHandler(void)
+{
+    DIO_extiDispatch(1UL<<1);
+}
+
+void EXTI2_IRQHandler(void)
+{
+    DIO_extiDispatch(1UL<<2);
+}
+
+void EXTI3_IRQHandler(void)
+{
+    DIO_extiDispatch(1UL<<3);
+}
+
+void EXTI4_IRQHandler(void)
+{
+    DIO_extiDispatch(1UL<<4);
+}
+
+void EXTI9_5_IRQHandler(void)
+{
+    DIO_extiDispatch(DIO_EXTI_LINES_9_5);
+}
+
+void EXTI15_10_IRQHandler(void)
+{
+    DIO_extiDispatch(DIO_EXTI_LINES_15_10);
+}
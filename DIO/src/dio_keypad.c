@@ -0,0 +1,252 @@
+/**
+ * @file dio_keypad.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DIO keypad.
+ * @version 1.0
+ * @date 2025-04-12
+ * @note Take into account the following considerations:
+ * + A tick reads the row driven on the previous tick, so the column lines
+ *   settle for a whole tick period before they are sampled.
+ * + Without a diode per key, three keys on the corners of a rectangle make
+ *   the fourth read pressed (ghost). The ghosted frames are rejected.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "dio_keypad.h"     /*For this modules definitions*/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static bool DIO_keypadGhosted(const DioKeypad_t * const Keypad);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_keypadGhosted()
+*//**
+ *\b Description:
+ * This function is used to detect a ghosted frame: two rows that share two
+ * or more pressed columns close a rectangle, and one of its keys can not
+ * be told from a ghost.
+ *
+ * @param[in]   Keypad is the scanner with a complete frame in Scan.
+ *
+ * @return  true when the frame is ghosted.
+ *
+*****************************************************************************/
+static bool DIO_keypadGhosted(const DioKeypad_t * const Keypad)
+{
+    for(uint8_t i=0; i<Keypad->Rows; i++)
+    {
+        for(uint8_t j=i+1U; j<Keypad->Rows; j++)
+        {
+            const uint16_t shared = Keypad->Scan[i] & Keypad->Scan[j];
+
+            /* Two bits or more: clearing the lowest leaves one */
+            if((shared & (shared - 1U)) != 0U)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/*****************************************************************************
+ * Function: DIO_keypadInit()
+*//**
+ *\b Description:
+ * This function is used to build a key matrix scanner. The BSRR word of
+ * each row, which drives that row low and releases the others, is
+ * precomputed. The first row is driven at once.
+ *
+ * PRE-CONDITION: The rows are open-drain outputs of one port, the columns
+ * are inputs with pull-up of one port (DIO_init). <br>
+ * PRE-CONDITION: rows and columns are 1 to 8. <br>
+ *
+ * POST-CONDITION: The scanner is ready for DIO_keypadTick, no key is
+ * pressed. <br>
+ *
+ * @param[out]  Keypad is the scanner to build.
+ * @param[in]   Config is the pin map of the matrix.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static const DioPinConfig_t Rows[4] =
+ * {
+ *      {DIO_PB, DIO_PB0}, {DIO_PB, DIO_PB1}, {DIO_PB, DIO_PB2},
+ *      {DIO_PB, DIO_PB3}
+ * };
+ * static const DioPinConfig_t Columns[4] =
+ * {
+ *      {DIO_PC, DIO_PC0}, {DIO_PC, DIO_PC1}, {DIO_PC, DIO_PC2},
+ *      {DIO_PC, DIO_PC3}
+ * };
+ * static const DioKeypadConfig_t KeypadConfig = {Rows, 4, Columns, 4};
+ * static DioKeypad_t Keypad;
+ *
+ * DIO_keypadInit(&Keypad, &KeypadConfig);
+ * @endcode
+ *
+ * @see DIO_keypadInit
+ * @see DIO_keypadTick
+ * @see DIO_keypadKeysGet
+ *
+*****************************************************************************/
+void DIO_keypadInit(DioKeypad_t * const Keypad,
+                    const DioKeypadConfig_t * const Config)
+{
+    assert((Config->rows >= 1U) && (Config->rows <= DIO_KEYPAD_MAX_ROWS));
+    assert((Config->columns >= 1U) &&
+           (Config->columns <= DIO_KEYPAD_MAX_COLUMNS));
+
+    uint32_t rowMask = 0;
+
+    Keypad->RowBsrr = DIO_pinHandleGet(&Config->Rows[0]).Bsrr;
+    Keypad->ColumnIdr = DIO_pinHandleGet(&Config->Columns[0]).Idr;
+    Keypad->Rows = Config->rows;
+    Keypad->Columns = Config->columns;
+    Keypad->ColumnMask = 0;
+    Keypad->Row = 0;
+    Keypad->Ghost = false;
+
+    for(uint8_t row=0; row<Config->rows; row++)
+    {
+        assert(Config->Rows[row].Port == Config->Rows[0].Port);
+        rowMask |= 1UL<<(Config->Rows[row].Pin);
+    }
+
+    /* Drive the row low (reset half), release the others (set half) */
+    for(uint8_t row=0; row<Config->rows; row++)
+    {
+        const uint32_t bit = 1UL<<(Config->Rows[row].Pin);
+
+        Keypad->RowWord[row] = (bit << 16U) | (rowMask & ~bit);
+        Keypad->Scan[row] = 0;
+        Keypad->Keys[row] = 0;
+    }
+
+    for(uint8_t column=0; column<Config->columns; column++)
+    {
+        assert(Config->Columns[column].Port == Config->Columns[0].Port);
+        Keypad->ColumnPin[column] = (uint8_t)Config->Columns[column].Pin;
+        Keypad->ColumnMask |= (uint16_t)(1UL<<(Config->Columns[column].Pin));
+    }
+
+    REG_WRITE32(Keypad->RowBsrr, Keypad->RowWord[0]);
+}
+
+/*****************************************************************************
+ * Function: DIO_keypadTick()
+*//**
+ *\b Description:
+ * This function is used to advance the scanner by one row. It loads the
+ * columns of the row driven on the previous tick with one IDR load, then
+ * drives the next row with one BSRR store. After the last row the frame
+ * is complete: a clean frame becomes the pressed keys, a ghosted frame is
+ * rejected.
+ *
+ * PRE-CONDITION: The scanner is built by DIO_keypadInit. <br>
+ * PRE-CONDITION: The ticks are periodic (timer interrupt); a frame takes
+ * one tick per row. <br>
+ *
+ * POST-CONDITION: The next row is driven. <br>
+ *
+ * @param[in,out]   Keypad is the scanner.
+ *
+ * @return  true when a frame completed and the pressed keys changed.
+ *
+ * @see DIO_keypadInit
+ * @see DIO_keypadTick
+ * @see DIO_keypadKeysGet
+ * @see DIO_keypadGhostGet
+ *
+*****************************************************************************/
+bool DIO_keypadTick(DioKeypad_t * const Keypad)
+{
+    const uint8_t row = Keypad->Row;
+    const uint8_t next = (uint8_t)((row + 1U) % Keypad->Rows);
+    bool changed = false;
+
+    /* Pressed keys pull their column low */
+    Keypad->Scan[row] = (uint16_t)~REG_READ32(Keypad->ColumnIdr) &
+                        Keypad->ColumnMask;
+    REG_WRITE32(Keypad->RowBsrr, Keypad->RowWord[next]);
+    Keypad->Row = next;
+
+    if(next == 0U)
+    {
+        Keypad->Ghost = DIO_keypadGhosted(Keypad);
+
+        if(!Keypad->Ghost)
+        {
+            for(uint8_t i=0; i<Keypad->Rows; i++)
+            {
+                changed = changed || (Keypad->Keys[i] != Keypad->Scan[i]);
+                Keypad->Keys[i] = Keypad->Scan[i];
+            }
+        }
+    }
+
+    return changed;
+}
+
+/*****************************************************************************
+ * Function: DIO_keypadKeysGet()
+*//**
+ *\b Description:
+ * This function is used to list the pressed keys of the last clean frame
+ * (n-key rollover: every key is reported). The code of a key is
+ * row * columns + column.
+ *
+ * PRE-CONDITION: The scanner is built by DIO_keypadInit. <br>
+ *
+ * POST-CONDITION: Keys holds the first size codes, row by row. <br>
+ *
+ * @param[in]   Keypad is the scanner.
+ * @param[out]  Keys is the list of key codes to fill.
+ * @param[in]   size is the capacity of the list.
+ *
+ * @return  The number of pressed keys (it may exceed size).
+ *
+ * @see DIO_keypadTick
+ * @see DIO_keypadKeysGet
+ *
+*****************************************************************************/
+size_t DIO_keypadKeysGet(const DioKeypad_t * const Keypad,
+                         uint8_t * const Keys, size_t size)
+{
+    size_t count = 0;
+
+    for(uint8_t row=0; row<Keypad->Rows; row++)
+    {
+        const uint16_t pressed = Keypad->Keys[row];
+
+        if(pressed == 0U)
+        {
+            continue;
+        }
+
+        for(uint8_t column=0; column<Keypad->Columns; column++)
+        {
+            if(pressed & (1UL<<(Keypad->ColumnPin[column])))
+            {
+                if(count < size)
+                {
+                    Keys[count] = (uint8_t)((row * Keypad->Columns) + column);
+                }
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,332 @@
+/**
+ * @file dio_parallel.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the parallel bus.
+ * @version 1.0
+ * @date 2025-04-09
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "dio_parallel.h"   /*For this modules definitions*/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint8_t DIO_parallelPortIndex(DioParallel_t * const Bus,
+                                     DioPort_t Port);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_parallelPortIndex()
+*//**
+ *\b Description:
+ * This function is used to get the index of a port on the bus. The port is
+ * added to the bus the first time it is used.
+ *
+ * @param[in,out]   Bus is the bus under construction.
+ * @param[in]       Port is the port of a data pin or of the WR strobe.
+ *
+ * @return  The index of the port on the bus.
+ *
+*****************************************************************************/
+static uint8_t DIO_parallelPortIndex(DioParallel_t * const Bus,
+                                     DioPort_t Port)
+{
+    uint8_t index = 0;
+
+    while((index < Bus->Ports) && (Bus->Port[index] != Port))
+    {
+        index++;
+    }
+
+    if(index == Bus->Ports)
+    {
+        assert(Bus->Ports < DIO_PARALLEL_MAX_PORTS);
+
+        const DioPinConfig_t PortPin = {Port, (DioPin_t)0};
+        const DioPinHandle_t Handle = DIO_pinHandleGet(&PortPin);
+
+        Bus->Port[index] = Port;
+        Bus->Bsrr[index] = Handle.Bsrr;
+        Bus->Idr[index] = Handle.Idr;
+        Bus->DataMask[index] = 0;
+        Bus->Ports++;
+    }
+
+    return index;
+}
+
+/*****************************************************************************
+ * Function: DIO_parallelInit()
+*//**
+ *\b Description:
+ * This function is used to build a parallel bus. For every byte lane and
+ * every port of the bus, it precomputes the BSRR word that drives each of
+ * the 256 byte values on the data pins of that port. The WR falling edge
+ * is merged in the words of its port, so a bus cycle is one store per port
+ * plus the WR rising edge. The strobes are left idle (high).
+ *
+ * PRE-CONDITION: The data pins and the strobes are configured as OUTPUT
+ * (DIO_init). <br>
+ * PRE-CONDITION: Width is 8 or 16. <br>
+ * PRE-CONDITION: The data pins and WR use at most DIO_PARALLEL_MAX_PORTS
+ * ports. <br>
+ *
+ * POST-CONDITION: The bus is ready for DIO_parallelWrite and
+ * DIO_parallelRead. <br>
+ *
+ * @param[out]  Bus is the bus to build.
+ * @param[in]   Config is the pin map of the bus.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static const DioPinConfig_t LcdData[8] =
+ * {
+ *      {DIO_PA, DIO_PA0}, {DIO_PA, DIO_PA1}, {DIO_PA, DIO_PA4},
+ *      {DIO_PB, DIO_PB0}, {DIO_PC, DIO_PC1}, {DIO_PC, DIO_PC0},
+ *      {DIO_PA, DIO_PA8}, {DIO_PB, DIO_PB10}
+ * };
+ * static const DioParallelConfig_t LcdConfig =
+ * {
+ *      LcdData, 8, {DIO_PA, DIO_PA9}, {DIO_PC, DIO_PC7}
+ * };
+ * static DioParallel_t Lcd;
+ *
+ * DIO_parallelInit(&Lcd, &LcdConfig);
+ * DIO_parallelWrite(&Lcd, frame, sizeof(frame));
+ * @endcode
+ *
+ * @see DIO_parallelInit
+ * @see DIO_parallelWrite
+ * @see DIO_parallelRead
+ *
+*****************************************************************************/
+void DIO_parallelInit(DioParallel_t * const Bus,
+                      const DioParallelConfig_t * const Config)
+{
+    assert((Config->Width == 8U) || (Config->Width == 16U));
+
+    uint8_t dataPort[DIO_PARALLEL_MAX_WIDTH];
+
+    Bus->Ports = 0;
+    Bus->Runs = 0;
+    Bus->Lanes = (uint8_t)(Config->Width / DIO_PARALLEL_LANE_BITS);
+    Bus->Wr = DIO_pinHandleGet(&Config->Wr);
+    Bus->Rd = DIO_pinHandleGet(&Config->Rd);
+
+    /* Gather the ports of the data pins and the runs of consecutive pins */
+    for(uint8_t bit=0; bit<Config->Width; bit++)
+    {
+        const DioPinConfig_t * const Pin = &Config->Data[bit];
+        const uint8_t port = DIO_parallelPortIndex(Bus, Pin->Port);
+        DioParallelRun_t * const Last =
+            (Bus->Runs > 0U) ? &Bus->Run[Bus->Runs - 1U] : NULL;
+
+        dataPort[bit] = port;
+        Bus->DataMask[port] |= (uint16_t)(1UL<<(Pin->Pin));
+
+        /* The last run ends on the previous bit, extend it if the pin 
+         * follows its last pin on the same port
+        */
+        if((Last != NULL) && (Last->Port == port) &&
+           ((uint32_t)Pin->Pin ==
+            (uint32_t)(Last->PinShift + (bit - Last->BitShift))))
+        {
+            Last->Mask = (uint16_t)((Last->Mask << 1U) | 1U);
+        }
+        else
+        {
+            Bus->Run[Bus->Runs].Port = port;
+            Bus->Run[Bus->Runs].PinShift = (uint8_t)Pin->Pin;
+            Bus->Run[Bus->Runs].BitShift = bit;
+            Bus->Run[Bus->Runs].Mask = 1U;
+            Bus->Runs++;
+        }
+    }
+
+    const uint8_t wrPort = DIO_parallelPortIndex(Bus, Config->Wr.Port);
+
+    /* Encode every byte value of every lane on every port */
+    for(uint8_t lane=0; lane<Bus->Lanes; lane++)
+    {
+        for(uint8_t port=0; port<Bus->Ports; port++)
+        {
+            for(uint32_t value=0; value<256U; value++)
+            {
+                uint32_t word = 0;
+
+                for(uint8_t i=0; i<DIO_PARALLEL_LANE_BITS; i++)
+                {
+                    const uint8_t bit =
+                        (uint8_t)((lane * DIO_PARALLEL_LANE_BITS) + i);
+                    const uint32_t mask = 1UL<<(Config->Data[bit].Pin);
+
+                    if(dataPort[bit] == port)
+                    {
+                        /* Set the pin (low half) or reset it (high half) */
+                        word |= ((value >> i) & 1UL) ? mask : (mask << 16U);
+                    }
+                }
+
+                /* The WR falling edge goes out with the data of lane 0 */
+                if((lane == 0U) && (port == wrPort))
+                {
+                    word |= Bus->Wr.Mask << 16U;
+                }
+
+                Bus->Lut[lane][port][value] = word;
+            }
+        }
+    }
+
+    DIO_pinSet(&Bus->Wr);
+    DIO_pinSet(&Bus->Rd);
+}
+
+/*****************************************************************************
+ * Function: DIO_parallelWrite()
+*//**
+ *\b Description:
+ * This function is used to write a buffer on the bus. Each bus cycle
+ * drives the data (and the WR falling edge) with one BSRR store per port,
+ * then raises WR to latch the data. A 16 bits bus takes the bytes of the
+ * buffer in pairs, low byte first.
+ *
+ * PRE-CONDITION: The bus is built by DIO_parallelInit. <br>
+ * PRE-CONDITION: size is a multiple of the bus width in bytes. <br>
+ *
+ * POST-CONDITION: The buffer is written on the bus, WR is idle. <br>
+ *
+ * @param[in]   Bus is the bus to write.
+ * @param[in]   Data is the buffer to write.
+ * @param[in]   size is the size of the buffer in bytes.
+ *
+ * @return  void
+ *
+ * @see DIO_parallelInit
+ * @see DIO_parallelWrite
+ * @see DIO_parallelRead
+ *
+*****************************************************************************/
+void DIO_parallelWrite(const DioParallel_t * const Bus,
+                       const uint8_t * const Data, size_t size)
+{
+    assert((size % Bus->Lanes) == 0U);
+
+    if(Bus->Lanes == 1U)
+    {
+        for(size_t i=0; i<size; i++)
+        {
+            for(uint8_t port=0; port<Bus->Ports; port++)
+            {
+                REG_WRITE32(Bus->Bsrr[port], Bus->Lut[0][port][Data[i]]);
+            }
+
+            DIO_pinSet(&Bus->Wr);
+        }
+    }
+    else
+    {
+        for(size_t i=0; i<size; i+=2U)
+        {
+            for(uint8_t port=0; port<Bus->Ports; port++)
+            {
+                REG_WRITE32(Bus->Bsrr[port], Bus->Lut[0][port][Data[i]] |
+                                             Bus->Lut[1][port][Data[i+1U]]);
+            }
+
+            DIO_pinSet(&Bus->Wr);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: DIO_parallelRead()
+*//**
+ *\b Description:
+ * This function is used to read a buffer from the bus. The data pins are
+ * turned to inputs for the burst. Each bus cycle lowers RD, loads the IDR
+ * of every data port, raises RD and gathers the data bits run by run. A
+ * 16 bits bus fills the bytes of the buffer in pairs, low byte first.
+ *
+ * PRE-CONDITION: The bus is built by DIO_parallelInit. <br>
+ * PRE-CONDITION: size is a multiple of the bus width in bytes. <br>
+ * PRE-CONDITION: The device drives the bus within the RD low time (a few
+ * core cycles). <br>
+ *
+ * POST-CONDITION: The buffer is read from the bus, RD is idle and the
+ * data pins are outputs again. <br>
+ *
+ * @param[in]   Bus is the bus to read.
+ * @param[out]  Data is the buffer to fill.
+ * @param[in]   size is the size of the buffer in bytes.
+ *
+ * @return  void
+ *
+ * @see DIO_parallelInit
+ * @see DIO_parallelWrite
+ * @see DIO_parallelRead
+ *
+*****************************************************************************/
+void DIO_parallelRead(const DioParallel_t * const Bus,
+                      uint8_t * const Data, size_t size)
+{
+    assert((size % Bus->Lanes) == 0U);
+
+    uint32_t idr[DIO_PARALLEL_MAX_PORTS] = {0};
+
+    for(uint8_t port=0; port<Bus->Ports; port++)
+    {
+        if(Bus->DataMask[port] != 0U)
+        {
+            DIO_portModeWrite(Bus->Port[port], Bus->DataMask[port],
+                              DIO_INPUT);
+        }
+    }
+
+    for(size_t i=0; i<size; i+=Bus->Lanes)
+    {
+        uint32_t value = 0;
+
+        DIO_pinClear(&Bus->Rd);
+        for(uint8_t port=0; port<Bus->Ports; port++)
+        {
+            if(Bus->DataMask[port] != 0U)
+            {
+                idr[port] = REG_READ32(Bus->Idr[port]);
+            }
+        }
+        DIO_pinSet(&Bus->Rd);
+
+        for(uint8_t run=0; run<Bus->Runs; run++)
+        {
+            const DioParallelRun_t * const Run = &Bus->Run[run];
+
+            value |= ((idr[Run->Port] >> Run->PinShift) & Run->Mask) <<
+                     Run->BitShift;
+        }
+
+        Data[i] = (uint8_t)value;
+        if(Bus->Lanes == 2U)
+        {
+            Data[i+1U] = (uint8_t)(value >> 8U);
+        }
+    }
+
+    for(uint8_t port=0; port<Bus->Ports; port++)
+    {
+        if(Bus->DataMask[port] != 0U)
+        {
+            DIO_portModeWrite(Bus->Port[port], Bus->DataMask[port],
+                              DIO_OUTPUT);
+        }
+    }
+}
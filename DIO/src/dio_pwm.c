@@ -0,0 +1,381 @@
+/**
+ * @file dio_pwm.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DIO software PWM.
+ * @version 1.0
+ * @date 2025-04-12
+ * @note Take into account the following considerations:
+ * + The PWM owns TIM2, its channel 1 compare and the TIM2 interrupt.
+ * + The edges closer than the interrupt latency are applied together, the
+ *   later ones a few cycles late. Choose the prescaler so one count is
+ *   longer than the handler of an event.
+ * + A handler delayed past the end of the period applies the rest of the
+ *   period and the start of the next one at once, late by the delay.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include <stdbool.h>
+#include "dio_pwm.h"        /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Channels and time base of the running PWM */
+static const DioPwmConfig_t *PwmConfig = NULL;
+
+/** Port and pin mask of each channel */
+static uint8_t ChannelPort[DIO_PWM_MAX_CHANNELS];
+static uint32_t ChannelMask[DIO_PWM_MAX_CHANNELS];
+
+/** Duty of each channel, applied by DIO_pwmCommit */
+static uint32_t ChannelDuty[DIO_PWM_MAX_CHANNELS];
+
+/** BSRR of each port of the channels */
+static uint32_t volatile *PortBsrr[DIO_PWM_MAX_PORTS];
+static uint8_t Ports = 0;
+
+/**
+ * Event tables: the interrupt runs Table[Front], DIO_pwmCommit builds the
+ * other one and raises Pending; the interrupt swaps them at the start of
+ * the next period.
+ */
+static DioPwmTable_t Table[2];
+static volatile uint8_t Front = 0;
+static volatile bool Pending = false;
+
+/** Next event of the front table */
+static volatile uint8_t NextEvent = 0;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void DIO_pwmTableBuild(DioPwmTable_t * const Build);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_pwmTableBuild()
+*//**
+ *\b Description:
+ * This function is used to sort the duties into an event table. The first
+ * event raises the channels with a duty and lowers the others; then the
+ * channels are lowered in the order of their duty, the channels with the
+ * same duty in the same event. A duty of a whole period never lowers.
+ *
+ * @param[out]  Build is the table to build.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void DIO_pwmTableBuild(DioPwmTable_t * const Build)
+{
+    const uint8_t channels = PwmConfig->channels;
+    const uint32_t period = PwmConfig->period;
+    uint8_t order[DIO_PWM_MAX_CHANNELS];
+    uint8_t events = 1;
+
+    /* Insertion sort of the channels by duty */
+    for(uint8_t i=0; i<channels; i++)
+    {
+        uint8_t j = i;
+
+        while((j > 0U) && (ChannelDuty[order[j - 1U]] > ChannelDuty[i]))
+        {
+            order[j] = order[j - 1U];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    Build->Event[0].Time = 0;
+    for(uint8_t port=0; port<Ports; port++)
+    {
+        Build->Event[0].Word[port] = 0;
+    }
+
+    for(uint8_t i=0; i<channels; i++)
+    {
+        const uint8_t channel = order[i];
+        const uint32_t duty = ChannelDuty[channel];
+        const uint8_t port = ChannelPort[channel];
+
+        if(duty == 0U)
+        {
+            Build->Event[0].Word[port] |= ChannelMask[channel] << 16U;
+            continue;
+        }
+
+        Build->Event[0].Word[port] |= ChannelMask[channel];
+
+        if(duty >= period)
+        {
+            continue;
+        }
+
+        /* A new time opens an event, the same time joins the last one */
+        if(Build->Event[events - 1U].Time != duty)
+        {
+            Build->Event[events].Time = duty;
+            for(uint8_t p=0; p<Ports; p++)
+            {
+                Build->Event[events].Word[p] = 0;
+            }
+            events++;
+        }
+        Build->Event[events - 1U].Word[port] |= ChannelMask[channel] << 16U;
+    }
+
+    Build->Events = events;
+}
+
+/*****************************************************************************
+ * Function: DIO_pwmInit()
+*//**
+ *\b Description:
+ * This function is used to start the software PWM. Every channel starts
+ * with a duty of 0 (low). TIM2 counts the period and its channel 1
+ * compare interrupts at each event of the table.
+ *
+ * PRE-CONDITION: The clock of TIM2 is enabled. <br>
+ * PRE-CONDITION: The channels are configured as OUTPUT (DIO_init) and use
+ * at most DIO_PWM_MAX_PORTS ports. <br>
+ * PRE-CONDITION: The configuration lives until DIO_pwmStop. <br>
+ *
+ * POST-CONDITION: The PWM runs, the duties are set by DIO_pwmDutySet and
+ * DIO_pwmCommit. <br>
+ *
+ * @param[in]   Config is the PWM to start.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static const DioPinConfig_t Leds[3] =
+ * {
+ *      {DIO_PA, DIO_PA0}, {DIO_PA, DIO_PA1}, {DIO_PB, DIO_PB0}
+ * };
+ * static const DioPwmConfig_t LedsPwm = {Leds, 3, 256, 83};
+ *
+ * DIO_pwmInit(&LedsPwm);
+ * DIO_pwmDutySet(0, 64);
+ * DIO_pwmDutySet(2, 192);
+ * DIO_pwmCommit();
+ * @endcode
+ *
+ * @see DIO_pwmInit
+ * @see DIO_pwmDutySet
+ * @see DIO_pwmCommit
+ * @see DIO_pwmStop
+ *
+*****************************************************************************/
+void DIO_pwmInit(const DioPwmConfig_t * const Config)
+{
+    assert((Config->channels >= 1U) &&
+           (Config->channels <= DIO_PWM_MAX_CHANNELS));
+    assert(Config->period >= 2U);
+
+    DIO_pwmStop();
+    PwmConfig = Config;
+    Ports = 0;
+
+    for(uint8_t channel=0; channel<Config->channels; channel++)
+    {
+        const DioPinHandle_t Handle =
+            DIO_pinHandleGet(&Config->Channels[channel]);
+        uint8_t port = 0;
+
+        while((port < Ports) && (PortBsrr[port] != Handle.Bsrr))
+        {
+            port++;
+        }
+        if(port == Ports)
+        {
+            assert(Ports < DIO_PWM_MAX_PORTS);
+            PortBsrr[port] = Handle.Bsrr;
+            Ports++;
+        }
+
+        ChannelPort[channel] = port;
+        ChannelMask[channel] = Handle.Mask;
+        ChannelDuty[channel] = 0;
+    }
+
+    Front = 0;
+    Pending = false;
+    NextEvent = 0;
+    DIO_pwmTableBuild(&Table[0]);
+
+    /* TIM2: period counts, compare of channel 1 (frozen) at the events */
+    REG_WRITE32(&TIM2->CR1, 0);
+    REG_WRITE32(&TIM2->PSC, Config->prescaler);
+    REG_WRITE32(&TIM2->ARR, Config->period - 1U);
+    REG_WRITE32(&TIM2->CCMR1, 0);
+    REG_WRITE32(&TIM2->CCR1, 0);
+    REG_WRITE32(&TIM2->EGR, TIM_EGR_UG);
+    REG_WRITE32(&TIM2->SR, 0);
+    REG_WRITE32(&TIM2->DIER, TIM_DIER_CC1IE);
+
+    NVIC_ClearPendingIRQ(TIM2_IRQn);
+    NVIC_EnableIRQ(TIM2_IRQn);
+
+    REG_SET32(&TIM2->CR1, TIM_CR1_CEN);
+}
+
+/*****************************************************************************
+ * Function: DIO_pwmDutySet()
+*//**
+ *\b Description:
+ * This function is used to set the duty of a channel, in counts of the
+ * period. It takes effect on the next DIO_pwmCommit.
+ *
+ * PRE-CONDITION: The PWM is started by DIO_pwmInit. <br>
+ * PRE-CONDITION: channel is a channel of the configuration. <br>
+ *
+ * POST-CONDITION: The duty is staged for DIO_pwmCommit. <br>
+ *
+ * @param[in]   channel is the index of the channel in the configuration.
+ * @param[in]   duty is the high time in counts (period or more: 100%).
+ *
+ * @return  void
+ *
+ * @see DIO_pwmDutySet
+ * @see DIO_pwmCommit
+ *
+*****************************************************************************/
+void DIO_pwmDutySet(uint8_t channel, uint32_t duty)
+{
+    assert(channel < PwmConfig->channels);
+
+    ChannelDuty[channel] = duty;
+}
+
+/*****************************************************************************
+ * Function: DIO_pwmCommit()
+*//**
+ *\b Description:
+ * This function is used to apply the staged duties. They are sorted into
+ * the table the interrupt is not running; the interrupt swaps the tables
+ * at the start of the next period, so no period mixes old and new duties.
+ * A commit that has not been applied yet is replaced.
+ *
+ * PRE-CONDITION: The PWM is started by DIO_pwmInit. <br>
+ *
+ * POST-CONDITION: The duties apply from the next period. <br>
+ *
+ * @return  void
+ *
+ * @see DIO_pwmDutySet
+ * @see DIO_pwmCommit
+ *
+*****************************************************************************/
+void DIO_pwmCommit(void)
+{
+    /* Once Pending is low the interrupt does not swap, the back table is
+     * free to build
+    */
+    Pending = false;
+    DIO_pwmTableBuild(&Table[Front ^ 1U]);
+    Pending = true;
+}
+
+/*****************************************************************************
+ * Function: DIO_pwmStop()
+*//**
+ *\b Description:
+ * This function is used to stop the software PWM. The channels keep their
+ * level.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: TIM2 and its interrupt are stopped. <br>
+ *
+ * @return  void
+ *
+ * @see DIO_pwmInit
+ * @see DIO_pwmStop
+ *
+*****************************************************************************/
+void DIO_pwmStop(void)
+{
+    REG_CLEAR32(&TIM2->CR1, TIM_CR1_CEN);
+    REG_WRITE32(&TIM2->DIER, 0);
+    NVIC_DisableIRQ(TIM2_IRQn);
+    REG_WRITE32(&TIM2->SR, 0);
+}
+
+/*****************************************************************************
+ * Function: TIM2_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of TIM2. It applies the event of
+ * the compare with one BSRR store per port it changes, then the next 
+ * events that are already due, and sets the compare on the next event. 
+ * After the last event of the period, a pending table is swapped in. The
+ * update flag (UIF) is cleared with the start of each period: when the 
+ * handler runs so late that the counter has wrapped, the flag is set and
+ * the rest of the period is applied at once, then the start of the next 
+ * one (its compare match is dropped, so it does not run twice).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void TIM2_IRQHandler(void)
+{
+    const DioPwmTable_t *Run = &Table[Front];
+    uint8_t next = NextEvent;
+    bool due = true;
+
+    REG_WRITE32(&TIM2->SR, (next == 0U) ? ~(TIM_SR_CC1IF | TIM_SR_UIF) :
+                                          ~TIM_SR_CC1IF);
+
+    while(due)
+    {
+        const DioPwmEvent_t * const Event = &Run->Event[next];
+
+        for(uint8_t port=0; port<Ports; port++)
+        {
+            if(Event->Word[port] != 0U)
+            {
+                REG_WRITE32(PortBsrr[port], Event->Word[port]);
+            }
+        }
+
+        next++;
+        if(next == Run->Events)
+        {
+            /* The next event is the start of the next period */
+            if(Pending)
+            {
+                Front ^= 1U;
+                Pending = false;
+                Run = &Table[Front];
+            }
+            next = 0;
+        }
+
+        REG_WRITE32(&TIM2->CCR1, Run->Event[next].Time);
+
+        /* The counter is read before the flag: a wrap between the two reads
+         * is seen by the flag */
+        due = (next != 0U) &&
+              (REG_READ32(&TIM2->CNT) >= Run->Event[next].Time);
+
+        if((!due) && ((REG_READ32(&TIM2->SR) & TIM_SR_UIF) != 0U))
+        {
+            /* The counter has wrapped: what is left of the period is due */
+            due = true;
+            if(next == 0U)
+            {
+                REG_WRITE32(&TIM2->SR, ~(TIM_SR_CC1IF | TIM_SR_UIF));
+                NVIC_ClearPendingIRQ(TIM2_IRQn);
+            }
+        }
+    }
+
+    NextEvent = next;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file dio_stream.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DIO waveform stream.
+ * @version 1.0
+ * @date 2025-04-10
+ * @note Take into account the following considerations:
+ * + TIM1_UP requests DMA2 stream 5 (channel 6). Only DMA2 reaches the GPIO
+ *   ports (AHB1) through its peripheral port, so the stream is fixed.
+ * + The stream owns TIM1, DMA2 stream 5 and the DMA2_Stream5 interrupt.
+ *   The logic capture (dio_capture.c) uses TIM1 too, one runs at a time.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "dio_stream.h"     /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/** Defines the status and clear flags of DMA2 stream 5 (HISR/HIFCR) */
+#define DIO_STREAM_FLAGS    (DMA_HIFCR_CFEIF5 | DMA_HIFCR_CDMEIF5 | \
+                             DMA_HIFCR_CTEIF5 | DMA_HIFCR_CHTIF5 |  \
+                             DMA_HIFCR_CTCIF5)
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Stream running on DMA2 stream 5 (NULL when stopped) */
+static const DioStreamConfig_t *ActiveStream = NULL;
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_streamStart()
+*//**
+ *\b Description:
+ * This function is used to start a waveform stream. TIM1 counts period
+ * cycles per word and each update event requests DMA2 stream 5, which
+ * moves the next word of the buffer to the BSRR of the port. The buffer is
+ * circular: the half-transfer and transfer-complete interrupts hand the
+ * finished half to the callbacks, so it can be refilled while the other
+ * half is streamed. The pins change on the timer clock, whatever the CPU
+ * is doing.
+ *
+ * PRE-CONDITION: The clocks of TIM1 and DMA2 are enabled. <br>
+ * PRE-CONDITION: The logic capture is stopped (TIM1 is shared). <br>
+ * PRE-CONDITION: The pins driven by the words are configured as OUTPUT
+ * (DIO_init). <br>
+ * PRE-CONDITION: size is even and not zero, period is 2 or more. <br>
+ * PRE-CONDITION: The configuration and the buffer live until
+ * DIO_streamStop. <br>
+ *
+ * POST-CONDITION: The first word is written one period after the call,
+ * then one word per period. <br>
+ *
+ * @param[in]   Config is the stream to start.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static uint32_t Wave[64];
+ * static const DioStreamConfig_t WaveConfig =
+ * {
+ *      DIO_PA, Wave, 64, 84, WaveRefill, WaveRefill
+ * };
+ *
+ * for(uint16_t i=0; i<64; i++)
+ * {
+ *      Wave[i] = DIO_streamWordGet(1U<<DIO_PA0, (uint16_t)(i & 1U));
+ * }
+ * DIO_streamStart(&WaveConfig);
+ * @endcode
+ *
+ * @see DIO_streamStart
+ * @see DIO_streamStop
+ * @see DIO_streamWordGet
+ *
+*****************************************************************************/
+void DIO_streamStart(const DioStreamConfig_t * const Config)
+{
+    assert(Config->Port < DIO_MAX_PORT);
+    assert((Config->size != 0U) && ((Config->size % 2U) == 0U));
+    assert(Config->period >= 2U);
+
+    const DioPinConfig_t PortPin = {Config->Port, (DioPin_t)0};
+    const DioPinHandle_t Handle = DIO_pinHandleGet(&PortPin);
+
+    DIO_streamStop();
+    ActiveStream = Config;
+
+    /* TIM1: one update per period. UG loads the prescaler before the DMA
+     * request is enabled, so it does not move a word.
+    */
+    REG_WRITE32(&TIM1->CR1, 0);
+    REG_WRITE32(&TIM1->PSC, 0);
+    REG_WRITE32(&TIM1->ARR, Config->period - 1U);
+    REG_WRITE32(&TIM1->EGR, TIM_EGR_UG);
+    REG_WRITE32(&TIM1->SR, 0);
+    REG_WRITE32(&TIM1->DIER, TIM_DIER_UDE);
+
+    /* DMA2 stream 5: 32 bits memory to BSRR, circular, half/complete
+     * interrupts
+    */
+    REG_WRITE32(&DMA2->HIFCR, DIO_STREAM_FLAGS);
+    REG_WRITE32(&DMA2_Stream5->PAR, REG_DMA_ADDRESS(Handle.Bsrr));
+    REG_WRITE32(&DMA2_Stream5->M0AR, REG_DMA_ADDRESS(Config->Buffer));
+    REG_WRITE32(&DMA2_Stream5->NDTR, Config->size);
+    REG_WRITE32(&DMA2_Stream5->FCR, 0);
+    REG_WRITE32(&DMA2_Stream5->CR,
+                (DIO_STREAM_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) |
+                DMA_SxCR_PL_1 | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 |
+                DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_DIR_0 |
+                DMA_SxCR_TCIE | DMA_SxCR_HTIE);
+    REG_SET32(&DMA2_Stream5->CR, DMA_SxCR_EN);
+
+    NVIC_ClearPendingIRQ(DMA2_Stream5_IRQn);
+    NVIC_EnableIRQ(DMA2_Stream5_IRQn);
+
+    REG_SET32(&TIM1->CR1, TIM_CR1_CEN);
+}
+
+/*****************************************************************************
+ * Function: DIO_streamStop()
+*//**
+ *\b Description:
+ * This function is used to stop the waveform stream. The timer stops
+ * first, so no request is left half served, then the DMA stream is
+ * disabled. The pins keep the last word written.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: TIM1 and DMA2 stream 5 are stopped, the callbacks are
+ * no longer called. <br>
+ *
+ * @return  void
+ *
+ * @see DIO_streamStart
+ * @see DIO_streamStop
+ *
+*****************************************************************************/
+void DIO_streamStop(void)
+{
+    REG_CLEAR32(&TIM1->CR1, TIM_CR1_CEN);
+    REG_WRITE32(&TIM1->DIER, 0);
+    REG_CLEAR32(&DMA2_Stream5->CR, DMA_SxCR_EN);
+
+    /* The stream finishes its current transfer before it reads disabled */
+    while((REG_READ32(&DMA2_Stream5->CR) & DMA_SxCR_EN) != 0U)
+    {
+    }
+
+    NVIC_DisableIRQ(DMA2_Stream5_IRQn);
+    REG_WRITE32(&DMA2->HIFCR, DIO_STREAM_FLAGS);
+    ActiveStream = NULL;
+}
+
+/*****************************************************************************
+ * Function: DMA2_Stream5_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of DMA2 stream 5. It hands the
+ * half of the buffer that the DMA has just finished to the callbacks.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void DMA2_Stream5_IRQHandler(void)
+{
+    const uint32_t status = REG_READ32(&DMA2->HISR);
+    const DioStreamConfig_t * const Stream = ActiveStream;
+    const uint16_t half = (Stream != NULL) ? (Stream->size / 2U) : 0U;
+
+    REG_WRITE32(&DMA2->HIFCR, status & (DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTCIF5));
+
+    if(Stream == NULL)
+    {
+        return;
+    }
+
+    if((status & DMA_HISR_HTIF5) && (Stream->HalfComplete != NULL))
+    {
+        Stream->HalfComplete(&Stream->Buffer[0], half);
+    }
+    if((status & DMA_HISR_TCIF5) && (Stream->FullComplete != NULL))
+    {
+        Stream->FullComplete(&Stream->Buffer[half], half);
+    }
+}
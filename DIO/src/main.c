@@ -16,69 +16,65 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "dio.h"
+#include "dio_exti.h"
 
 int main()
 {
-    bool buttonFlag = false;
+    DioExtiEvent_t Event;
 
     /* Enable clock access to GPIOA, GPIOB and GPIOC*/
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN;   
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN;
+    /* Enable clock access to SYSCFG (EXTI line routing)*/
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
 
-    /* Get the address of the configuration table*/
-    const DioConfig_t * const DioConfig = DIO_configGet();
-    /* Get the size of the configuration table*/
-    size_t configSizeDio = DIO_configSizeGet();
-    /* Initialize the GPIO according to the configuration table*/
-    DIO_init(DioConfig, configSizeDio);
+    /* 
+     * Initialize the GPIO according to the configuration table, folded 
+     * into the register images at compile time
+    */
+    DIO_initImage(DIO_configImageGet());
+    /* Set up the EXTI lines of the pins with a trigger (PC13)*/
+    DIO_extiInit(DIO_configGet(), DIO_configSizeGet());
 
-    /*Define the pin configuration for PC13 (User button)*/
-    const DioPinConfig_t UserButton1= {DIO_PC, DIO_PC13};
     /*Define the pin configuration for PA5 (Embedded LED)*/
     const DioPinConfig_t UserLED1= {DIO_PA, DIO_PA5}; 
     /*Define the pin configuration for PA0*/
     const DioPinConfig_t UserLED2= {DIO_PA, DIO_PA0};
+    /*Build the handle of PA0 for the fast path functions*/
+    const DioPinHandle_t UserLED2Handle = DIO_pinHandleGet(&UserLED2);
     
     while(1)
     {
-        /* 
-         * Review PC13 pin (User button). A pull-up resistor circuit is
-         * embedded on board, when it is pressed a ground signal is send and
-         * embedded led of the board turns on.
-        */
-        if (DIO_pinRead(&UserButton1) == false)
-        {
-            /* Turn on the PA5 (Embedded LED)*/
-            DIO_pinWrite(&UserLED1, DIO_HIGH);
-
-            /* Write directly to the register GPIOB_ODR (clear PB0)*/
-            DIO_registerWrite(0x40020414, 0x00000000);
+        /* Sleep until the user button (PC13) changes */
+        DIO_extiWait();
 
-            buttonFlag = true;
-        }
-        else
+        while(DIO_extiEventGet(&Event))
         {
-            /* Turn off the PA5*/
-            DIO_pinWrite(&UserLED1, DIO_LOW);
+            /* 
+             * A pull-up resistor circuit is embedded on board, when the 
+             * button is pressed a ground signal is send and embedded led 
+             * of the board turns on.
+            */
+            if (Event.State == DIO_LOW)
+            {
+                /* Turn on the PA5 (Embedded LED)*/
+                DIO_pinWrite(&UserLED1, DIO_HIGH);
 
-            /* Write directly to the register GPIOB_ODR (set PB0)*/
-            DIO_registerWrite(0x40020414, 0x00000001);
-        }
-        
-        /* Toggle the PA0 pin. Add delay to be able to see the toggling pin*/
-        DIO_pinToggle(&UserLED2);
+                /* Write directly to the register GPIOB_ODR (clear PB0)*/
+                DIO_registerWrite(0x40020414, 0x00000000);
+            }
+            else
+            {
+                /* Turn off the PA5*/
+                DIO_pinWrite(&UserLED1, DIO_LOW);
 
-        /* 
-         * Read directly the register GPIOC_IDR (read PC13) in order to read 
-         * the button
-        */
-        uint16_t readButton = DIO_registerRead(0x40020810);
-        /* Make a mask to get IDR13 bit (PC13 pin)*/
-        uint16_t readButtonMask = readButton & 0x2000;
-        if (readButtonMask == 0x0000 && buttonFlag == true)
-        {
-            buttonFlag = false;
+                /* Write directly to the register GPIOB_ODR (set PB0)*/
+                DIO_registerWrite(0x40020414, 0x00000001);
+            }
+
+            /* Toggle the PA0 pin on every edge of the button*/
+            DIO_pinToggleFast(&UserLED2Handle);
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,328 @@
+/**
+ * @file bench.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the driver microbenchmarks.
+ * @version 1.0
+ * @date 2025-04-09
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include <stdio.h>
+#include "bench.h"      /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Cycle counter value when the measurement started */
+static uint32_t startCycles;
+
+/** Register accesses counter value when the measurement started */
+static uint32_t startAccesses;
+
+/** Cycles spent by the measurement itself (empty call) */
+static uint32_t overheadCycles;
+
+/** Number of results printed, used to separate the JSON array */
+static uint32_t resultsCount;
+
+/** Number of measurements above their threshold */
+static uint32_t failuresCount;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void BENCH_empty(uint32_t param);
+#if !defined(HOST_BUILD) && defined(BENCH_SEMIHOSTING)
+extern void initialise_monitor_handles(void);
+#endif
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: BENCH_empty()
+*//**
+ *\b Description:
+ * This function is used to calibrate the cost of the measurement (call
+ * through the function pointer plus the counter reads).
+ *
+ * @param[in]   param is not used.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void BENCH_empty(uint32_t param)
+{
+    (void)param;
+}
+
+/*****************************************************************************
+ * Function: BENCH_init()
+*//**
+ *\b Description:
+ * This function is used to start the cycle counter, calibrate the
+ * measurement overhead and open the JSON document.
+ *
+ * PRE-CONDITION: A debugger is attached when the output uses semihosting.
+ * <br>
+ *
+ * POST-CONDITION: The cycle counter runs and the JSON header is printed.
+ * <br>
+ *
+ * @param[in]   suite is the name of the benchmark suite.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * BENCH_init("spi");
+ * BENCH_run(BenchCases, sizeof(BenchCases)/sizeof(BenchCases[0]));
+ * return BENCH_finish();
+ * @endcode
+ *
+ * @see BENCH_init
+ * @see BENCH_measure
+ * @see BENCH_report
+ * @see BENCH_run
+ * @see BENCH_finish
+ *
+*****************************************************************************/
+void BENCH_init(const char * const suite)
+{
+#ifndef HOST_BUILD
+#ifdef BENCH_SEMIHOSTING
+    initialise_monitor_handles();
+#endif
+    /* Enable the trace unit and the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    overheadCycles = 0;
+    overheadCycles = BENCH_measure(BENCH_empty, 0).cycles;
+    resultsCount = 0;
+    failuresCount = 0;
+
+    printf("{\"suite\":\"%s\",", suite);
+#ifdef HOST_BUILD
+    printf("\"target\":\"host\",\"counter\":\"bus-cost-model\",");
+#else
+    printf("\"target\":\"nucleo_f401re\",\"counter\":\"dwt\",");
+#endif
+    printf("\"clock_hz\":%lu,\"results\":[\n",
+           (unsigned long)BENCH_CORE_CLOCK_HZ);
+}
+
+/*****************************************************************************
+ * Function: BENCH_start()
+*//**
+ *\b Description:
+ * This function is used to take the counters at the start of a measurement.
+ *
+ * @return  void
+ *
+ * @see BENCH_stop
+ *
+*****************************************************************************/
+void BENCH_start(void)
+{
+#ifdef HOST_BUILD
+    startAccesses = SIM_accessesGet();
+    startCycles = (uint32_t)SIM_cyclesGet();
+#else
+    startAccesses = 0;
+    startCycles = DWT->CYCCNT;
+#endif
+}
+
+/*****************************************************************************
+ * Function: BENCH_stop()
+*//**
+ *\b Description:
+ * This function is used to take the counters at the end of a measurement.
+ * Register accesses are only counted on the host.
+ *
+ * @return  The cycles and register accesses since BENCH_start.
+ *
+ * @see BENCH_start
+ *
+*****************************************************************************/
+BenchSample_t BENCH_stop(void)
+{
+    BenchSample_t sample;
+
+#ifdef HOST_BUILD
+    sample.cycles = (uint32_t)SIM_cyclesGet() - startCycles;
+    sample.accesses = (int32_t)(SIM_accessesGet() - startAccesses);
+#else
+    sample.cycles = DWT->CYCCNT - startCycles;
+    sample.accesses = -1;
+    (void)startAccesses;
+#endif
+
+    return sample;
+}
+
+/*****************************************************************************
+ * Function: BENCH_measure()
+*//**
+ *\b Description:
+ * This function is used to measure one call of the function under test.
+ * The call is repeated BENCH_RUNS times and the cheapest run is kept, minus
+ * the calibrated overhead of the measurement.
+ *
+ * @param[in]   Function is the wrapper that performs one call.
+ * @param[in]   param is the size of the case.
+ *
+ * @return  The cycles and register accesses of one call.
+ *
+ * @see BENCH_run
+ *
+*****************************************************************************/
+BenchSample_t BENCH_measure(BenchFunction_t Function, uint32_t param)
+{
+    BenchSample_t best = {UINT32_MAX, 0};
+
+    for(uint32_t run = 0; run < BENCH_RUNS; run++)
+    {
+        BENCH_start();
+        Function(param);
+        BenchSample_t sample = BENCH_stop();
+
+        if(sample.cycles < best.cycles)
+        {
+            best = sample;
+        }
+    }
+
+    best.cycles = (best.cycles > overheadCycles) ?
+                  (best.cycles - overheadCycles) : 0U;
+
+    return best;
+}
+
+/*****************************************************************************
+ * Function: BENCH_report()
+*//**
+ *\b Description:
+ * This function is used to print one measurement as a JSON object and
+ * check it against its threshold. The throughput at BENCH_CORE_CLOCK_HZ is
+ * added when the measurement moves data, the load (cycles of the call 
+ * over cycles of its period) when the call runs once per period, and the
+ * utilization (bus cycles over cycles of the call) when it uses a bus.
+ *
+ * @param[in]   name is the name of the measured function.
+ * @param[in]   param is the size of the case.
+ * @param[in]   sample is the measurement.
+ * @param[in]   limit is the threshold in cycles.
+ * @param[in]   bytes is the data moved by the call, 0 if none.
+ * @param[in]   period is the cycles of the call period, 0 if none.
+ * @param[in]   busCycles is the cycles the bus is busy, 0 if none.
+ *
+ * @return  void
+ *
+ * @see BENCH_run
+ *
+*****************************************************************************/
+void BENCH_report(const char * const name, uint32_t param,
+                  BenchSample_t sample, uint32_t limit, uint32_t bytes,
+                  uint32_t period, uint32_t busCycles)
+{
+    const bool pass = (sample.cycles <= limit);
+
+    if(!pass)
+    {
+        failuresCount++;
+    }
+
+    printf("%s {\"function\":\"%s\",\"param\":%lu,\"cycles\":%lu,"
+           "\"accesses\":%ld,\"limit\":%lu,\"pass\":%s",
+           (resultsCount == 0U) ? "" : ",\n", name, (unsigned long)param,
+           (unsigned long)sample.cycles, (long)sample.accesses,
+           (unsigned long)limit, pass ? "true" : "false");
+
+    if((bytes > 0U) && (sample.cycles > 0U))
+    {
+        /* Throughput in thousandths of MB/s, integer only (no float printf) */
+        const uint64_t rate = ((uint64_t)bytes * BENCH_CORE_CLOCK_HZ) /
+                              ((uint64_t)sample.cycles * 1000U);
+
+        printf(",\"bytes\":%lu,\"mb_per_s\":%lu.%03lu", (unsigned long)bytes,
+               (unsigned long)(rate / 1000U), (unsigned long)(rate % 1000U));
+    }
+    if(period > 0U)
+    {
+        /* Load in thousandths of the period */
+        const uint64_t load = ((uint64_t)sample.cycles * 1000U) / period;
+
+        printf(",\"load\":%lu.%03lu", (unsigned long)(load / 1000U),
+               (unsigned long)(load % 1000U));
+    }
+    if((busCycles > 0U) && (sample.cycles > 0U))
+    {
+        /* Utilization in thousandths of the call */
+        const uint64_t usage = ((uint64_t)busCycles * 1000U) / sample.cycles;
+
+        printf(",\"utilization\":%lu.%03lu", (unsigned long)(usage / 1000U),
+               (unsigned long)(usage % 1000U));
+    }
+    printf("}");
+    resultsCount++;
+}
+
+/*****************************************************************************
+ * Function: BENCH_run()
+*//**
+ *\b Description:
+ * This function is used to measure and report every size of every case of
+ * a benchmark table.
+ *
+ * @param[in]   Cases is the benchmark table.
+ * @param[in]   casesSize is the number of cases.
+ *
+ * @return  void
+ *
+ * @see BENCH_measure
+ * @see BENCH_report
+ *
+*****************************************************************************/
+void BENCH_run(const BenchCase_t * const Cases, size_t casesSize)
+{
+    for(size_t i = 0; i < casesSize; i++)
+    {
+        for(uint8_t j = 0; j < Cases[i].ParamsSize; j++)
+        {
+            const uint32_t param = Cases[i].Params[j];
+            const BenchSample_t sample =
+                BENCH_measure(Cases[i].Function, param);
+
+            BENCH_report(Cases[i].Name, param, sample,
+                         Cases[i].FixedLimit + (Cases[i].UnitLimit * param),
+                         Cases[i].UnitBytes * param, Cases[i].PeriodCycles,
+                         Cases[i].UnitBusCycles * param);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: BENCH_finish()
+*//**
+ *\b Description:
+ * This function is used to close the JSON document.
+ *
+ * @return  The number of measurements above their threshold.
+ *
+ * @see BENCH_init
+ *
+*****************************************************************************/
+uint32_t BENCH_finish(void)
+{
+    printf("\n],\"failures\":%lu}\n", (unsigned long)failuresCount);
+
+    return failuresCount;
+}
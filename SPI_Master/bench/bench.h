@@ -0,0 +1,113 @@
+/**
+ * @file bench.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the driver microbenchmarks. The
+ * benchmark measures core cycles per call with the DWT cycle counter on the
+ * Nucleo-F401RE, or with the bus-cost model of the simulated register file
+ * on a host build. The results are printed as a JSON document and every
+ * measurement is checked against a regression threshold.
+ * @version 1.0
+ * @date 2025-04-09
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "reg_backend.h"    /*For the cycle counter (DWT or simulation)*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the number of times each measurement is repeated. The minimum is
+ * reported, which filters out interrupts and flash wait-state noise.
+ */
+#define BENCH_RUNS          5U
+
+/**
+ * Defines the core clock used to convert cycles into time (HSI, 16 MHz).
+ */
+#define BENCH_CORE_CLOCK_HZ 16000000UL
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Select the regression threshold of the running platform. The host numbers
+ * come from the bus-cost model, the target numbers from the DWT counter.
+ */
+#ifdef HOST_BUILD
+#define BENCH_LIMIT(host, target)   (host)
+#else
+#define BENCH_LIMIT(host, target)   (target)
+#endif
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the function under test. The parameter is the size of the case
+ * (pins in the table, frames in the buffer, ...) or 1 when it has no size.
+ */
+typedef void (*BenchFunction_t)(uint32_t param);
+
+/**
+ * Defines one benchmark case. The threshold of a measurement is
+ * fixedLimit + unitLimit * param cycles. When a unit of param moves data
+ * (UnitBytes > 0), the throughput is also reported in MB/s. When the call
+ * runs once per period (PeriodCycles > 0), its CPU load is also reported.
+ * When a unit of param occupies a bus (UnitBusCycles > 0), the share of
+ * the call the bus is busy is also reported as its utilization.
+ */
+typedef struct
+{
+    const char *Name;           /**< Name of the measured function */
+    BenchFunction_t Function;   /**< Wrapper that performs one call */
+    const uint32_t *Params;     /**< Sizes to measure */
+    uint8_t ParamsSize;         /**< Number of sizes */
+    uint32_t FixedLimit;        /**< Threshold, cycles per call */
+    uint32_t UnitLimit;         /**< Threshold, cycles per unit of param */
+    uint32_t UnitBytes;         /**< Bytes per unit of param, 0 if none */
+    uint32_t PeriodCycles;      /**< Cycles of the call period, 0 if none */
+    uint32_t UnitBusCycles;     /**< Bus cycles per unit of param, or 0 */
+}BenchCase_t;
+
+/**
+ * Defines the result of one measurement.
+ */
+typedef struct
+{
+    uint32_t cycles;            /**< Core cycles per call */
+    int32_t accesses;           /**< Register accesses, -1 if not counted */
+}BenchSample_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void BENCH_init(const char * const suite);
+void BENCH_start(void);
+BenchSample_t BENCH_stop(void);
+BenchSample_t BENCH_measure(BenchFunction_t Function, uint32_t param);
+void BENCH_report(const char * const name, uint32_t param,
+                  BenchSample_t sample, uint32_t limit, uint32_t bytes,
+                  uint32_t period, uint32_t busCycles);
+void BENCH_run(const BenchCase_t * const Cases, size_t casesSize);
+uint32_t BENCH_finish(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*BENCH_H_*/
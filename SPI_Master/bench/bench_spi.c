@@ -0,0 +1,524 @@
+/**
+ * @file bench_spi.c
+ * @author Jose Luis Figueroa
+ * @brief Benchmark the SPI driver. Every entry point of the driver is
+ * measured in cycles and register accesses per call, and the results are
+ * printed as JSON (see bench.h).
+ * @version 1.0
+ * @date 2025-04-09
+ * @note Take into account the following considerations:
+ * + Build with the native_bench (host) or nucleo_f401re_bench environment.
+ * + The transfers run on SPI1 at FPCLK/4 with 8 bits frames (32 cycles per
+ *   frame on the wire). No slave is needed, MISO is not checked.
+ * + The software SPI runs the same settings on PB13 (SCK), PB15 (MOSI) and
+ *   PB14 (MISO).
+ * + The DMA transfers are started and waited for (SPI_dmaWait), so they are
+ *   measured at the speed of the wire; the core sleeps in between.
+ * + The device switches alternate SPI1 between a second device (mode 0,
+ *   FPCLK/2, LSB first, 16 bits) and the settings of its table row.
+ * + The queued transactions of 16 frames select PB12 as chip select, and
+ *   run back to back from the DMA interrupt of SPI1.
+ * + The CRC exchanges run the SPI1 row with the CRC-8 polynomial (0x07),
+ *   polled and by DMA; each call is a message ended by its CRC frame.
+ * + The interrupt exchanges run 256 frames on 1, 2 and 4 channels at once,
+ *   all at FPCLK/16 with 8 bits frames; they run last since they set up
+ *   the four channels again.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "spi.h"
+#include "spi_soft.h"
+#include "spi_dma.h"
+#include "spi_it.h"
+#include "spi_queue.h"
+#include "bench.h"
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Defines the size of the largest transfer in frames */
+#define BENCH_SPI_FRAMES    4096U
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void BENCH_spiInit(uint32_t param);
+static void BENCH_spiTransfer(uint32_t param);
+static void BENCH_spiReceive(uint32_t param);
+static void BENCH_spiTransferReceive(uint32_t param);
+static void BENCH_spiTransfer8(uint32_t param);
+static void BENCH_spiTransaction(uint32_t param);
+static void BENCH_spiDeviceSelect(uint32_t param);
+static void BENCH_spiSoftTransfer(uint32_t param);
+static void BENCH_spiSoftReceive(uint32_t param);
+static void BENCH_spiTransferDma(uint32_t param);
+static void BENCH_spiReceiveDma(uint32_t param);
+static void BENCH_spiTransferDma8(uint32_t param);
+static void BENCH_spiQueueSelect(void);
+static void BENCH_spiQueue(uint32_t param);
+static void BENCH_spiCrcSelect(void);
+static void BENCH_spiTransferReceiveCrc(uint32_t param);
+static void BENCH_spiTransferReceiveDmaCrc(uint32_t param);
+static void BENCH_spiItSelect(void);
+static void BENCH_spiTransferReceiveIt(uint32_t param);
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+/** Configuration table used to benchmark SPI_init, one row per channel */
+static const SpiConfig_t BenchConfig[] =
+{
+/*
+ * Channel        Mode       Hierarchy   Baud rate   NSS pin,
+ * Frame    Type             Size       CRC               Polynomial
+*/
+   {SPI_CHANNEL1, SPI_MODE3, SPI_MASTER, SPI_FPCLK4, SPI_HARDWARE_NSS_ENABLED,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
+   {SPI_CHANNEL2, SPI_MODE0, SPI_MASTER, SPI_FPCLK8, SPI_SOFTWARE_NSS,
+   SPI_LSB, SPI_FULL_DUPLEX, SPI_16BITS, SPI_CRC_DISABLED, 0x0007},
+   {SPI_CHANNEL3, SPI_MODE1, SPI_MASTER, SPI_FPCLK64, SPI_SOFTWARE_NSS,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
+   {SPI_CHANNEL4, SPI_MODE2, SPI_MASTER, SPI_FPCLK256, SPI_SOFTWARE_NSS,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
+};
+
+/** The SPI1 row with the CRC-8 appended and checked */
+static const SpiConfig_t BenchCrcConfig[] =
+{
+   {SPI_CHANNEL1, SPI_MODE3, SPI_MASTER, SPI_FPCLK4, SPI_HARDWARE_NSS_ENABLED,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_ENABLED, 0x0007},
+};
+
+/** Configuration table of the interrupt exchanges, one row per channel */
+static const SpiConfig_t BenchItConfig[] =
+{
+   {SPI_CHANNEL1, SPI_MODE0, SPI_MASTER, SPI_FPCLK16, SPI_SOFTWARE_NSS,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
+   {SPI_CHANNEL2, SPI_MODE0, SPI_MASTER, SPI_FPCLK16, SPI_SOFTWARE_NSS,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
+   {SPI_CHANNEL3, SPI_MODE0, SPI_MASTER, SPI_FPCLK16, SPI_SOFTWARE_NSS,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
+   {SPI_CHANNEL4, SPI_MODE0, SPI_MASTER, SPI_FPCLK16, SPI_SOFTWARE_NSS,
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
+};
+
+/** Software SPI with the settings of the SPI1 row */
+static const SpiSoftConfig_t BenchSoftConfig[] =
+{
+    {SPI_CHANNEL1, SPI_MODE3, SPI_MSB, SPI_8BITS,
+     {DIO_PB, DIO_PB13}, {DIO_PB, DIO_PB15}, {DIO_PB, DIO_PB14}},
+};
+
+/** Data sent and received by the transfer functions */
+static uint16_t BenchData[BENCH_SPI_FRAMES];
+
+/** Bytes sent by the 8 bits transfers, straight from flash */
+static const uint8_t BenchFlash[BENCH_SPI_FRAMES] = {0x9F, 0x03, 0x0B, 0x02};
+
+/** Number of channels in the SPI_init tables */
+static const uint32_t BenchInitSizes[] = {1, 2, 4};
+
+/** Number of frames of the transfers */
+static const uint32_t BenchFrames[] = {1, 16, 256, 4096};
+
+/** Number of transfers of 16 frames in a transaction */
+static const uint32_t BenchTransfers[] = {1, 16, 256};
+
+/** 
+ * Devices sharing SPI1: its table row on PB12 and a second one on PB1 
+ * (prepared by main)
+ */
+static SpiDevice_t BenchDevices[] =
+{
+    {SPI_CHANNEL1, {DIO_PB, DIO_PB1}, SPI_MODE0, SPI_FPCLK2, SPI_LSB,
+     SPI_16BITS, {0}, 0},
+    {SPI_CHANNEL1, {DIO_PB, DIO_PB12}, SPI_MODE3, SPI_FPCLK4, SPI_MSB,
+     SPI_8BITS, {0}, 0},
+};
+
+/** Chip select of the queued transactions */
+static const DioPinConfig_t BenchCs = {DIO_PB, DIO_PB12};
+
+/** Number of channels of the interrupt exchanges */
+static const uint32_t BenchItChannels[] = {1, 2, 4};
+
+/** Frames of each channel of the interrupt exchanges */
+#define BENCH_SPI_IT_FRAMES 256U
+
+/**
+ * The following array contains the benchmark cases of the SPI driver. The
+ * thresholds are the fixed cycles per call plus the cycles per channel of
+ * the table (SPI_init) or per frame (transfers), for the host bus-cost
+ * model and for the DWT counter. SPI_init writes three registers per
+ * channel (CR2, CR1, then SPE). The software SPI costs two BSRR stores and
+ * one IDR load per bit; its frame is compared with SPI_transfer. The
+ * transfers of a transaction follow each other on the wire, 512 cycles
+ * each. A device switch costs a CR1 write (two when DFF changes, SPE is
+ * cleared first), the transaction and the chip select, one BSRR store 
+ * through the handle resolved by SPI_deviceInit. The DMA
+ * transfers cost their setup plus the frames on the wire. The queued
+ * transactions cost 512 cycles each plus the gap of the interrupt that
+ * chains them. A CRC message adds the reset of the CRC (three CR1 
+ * writes), CRCNEXT, the CRC frame on the wire and the CRCERR check to the
+ * transfer; the DMA one also arms the receive stream for the CRC frame.
+ * The interrupt
+ * exchanges cost 128 cycles per frame on the wire plus the interrupt of
+ * each frame; their aggregate throughput grows with the channels until
+ * the interrupts fill the CPU. The bus utilization is reported from the 
+ * wire time of the frames (Bus cycles per unit); the interrupt exchanges
+ * add up the utilization of their buses.
+ */
+static const BenchCase_t BenchCases[] =
+{
+/*  Function         Wrapper             Sizes
+ *  Fixed limit                  Unit limit              Bytes  Period  Bus
+ */
+    {"SPI_init",      BENCH_spiInit,      BenchInitSizes, 3,
+     BENCH_LIMIT(0, 40),          BENCH_LIMIT(12, 60),    0,     0,      0},
+    {"SPI_transfer",  BENCH_spiTransfer,  BenchFrames,    4,
+     BENCH_LIMIT(40, 200),        BENCH_LIMIT(35, 60),    0,     0,      32},
+    {"SPI_receive",   BENCH_spiReceive,   BenchFrames,    4,
+     BENCH_LIMIT(40, 200),        BENCH_LIMIT(35, 60),    0,     0,      32},
+    {"SPI_transferReceive", BENCH_spiTransferReceive, BenchFrames, 4,
+     BENCH_LIMIT(40, 200),        BENCH_LIMIT(35, 60),    0,     0,      32},
+    {"SPI_transfer8", BENCH_spiTransfer8, BenchFrames,    4,
+     BENCH_LIMIT(40, 200),        BENCH_LIMIT(35, 60),    0,     0,      32},
+    {"SPI_transaction", BENCH_spiTransaction, BenchTransfers, 3,
+     BENCH_LIMIT(40, 200),        BENCH_LIMIT(520, 600),  0,     0,      512},
+    {"SPI_deviceSelect", BENCH_spiDeviceSelect, BenchTransfers, 3,
+     BENCH_LIMIT(0, 20),          BENCH_LIMIT(70, 150),   0,     0,      0},
+    {"SPI_softTransfer", BENCH_spiSoftTransfer, BenchFrames, 4,
+     BENCH_LIMIT(20, 60),         BENCH_LIMIT(60, 120),   0,     0,      0},
+    {"SPI_softReceive", BENCH_spiSoftReceive, BenchFrames, 4,
+     BENCH_LIMIT(20, 60),         BENCH_LIMIT(60, 120),   0,     0,      0},
+    {"SPI_transferDma", BENCH_spiTransferDma, BenchFrames, 4,
+     BENCH_LIMIT(150, 400),       BENCH_LIMIT(35, 45),    0,     0,      32},
+    {"SPI_receiveDma", BENCH_spiReceiveDma, BenchFrames, 4,
+     BENCH_LIMIT(150, 400),       BENCH_LIMIT(35, 45),    0,     0,      32},
+    {"SPI_transferDma8", BENCH_spiTransferDma8, BenchFrames, 4,
+     BENCH_LIMIT(150, 400),       BENCH_LIMIT(35, 45),    0,     0,      32},
+    {"SPI_queue",     BENCH_spiQueue,     BenchTransfers, 3,
+     BENCH_LIMIT(150, 400),       BENCH_LIMIT(570, 600),  0,     0,      512},
+    {"SPI_transferReceiveCrc", BENCH_spiTransferReceiveCrc, BenchFrames, 4,
+     BENCH_LIMIT(90, 260),        BENCH_LIMIT(35, 60),    0,     0,      32},
+    {"SPI_transferReceiveDmaCrc", BENCH_spiTransferReceiveDmaCrc, BenchFrames,
+     4, BENCH_LIMIT(200, 450),    BENCH_LIMIT(35, 45),    0,     0,      32},
+    {"SPI_transferReceiveIt", BENCH_spiTransferReceiveIt, BenchItChannels, 3,
+     BENCH_LIMIT(42000, 48000),   BENCH_LIMIT(0, 6000),
+     BENCH_SPI_IT_FRAMES, 0, BENCH_SPI_IT_FRAMES * 128U},
+};
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/* Wrappers performing one call of each function under test */
+static void BENCH_spiInit(uint32_t param)
+{
+    SPI_init(BenchConfig, param);
+}
+
+static void BENCH_spiTransfer(uint32_t param)
+{
+    const SpiTransferConfig_t TransferConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchData
+    };
+
+    SPI_transfer(&TransferConfig);
+}
+
+static void BENCH_spiReceive(uint32_t param)
+{
+    const SpiReceiveConfig_t ReceiveConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchData
+    };
+
+    SPI_receive(&ReceiveConfig);
+}
+
+static void BENCH_spiTransferReceive(uint32_t param)
+{
+    const SpiExchangeConfig_t ExchangeConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .txData = BenchData,
+        .rxData = BenchData
+    };
+
+    SPI_transferReceive(&ExchangeConfig);
+}
+
+static void BENCH_spiTransfer8(uint32_t param)
+{
+    const SpiTransfer8Config_t TransferConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchFlash
+    };
+
+    SPI_transfer8(&TransferConfig);
+}
+
+static void BENCH_spiTransaction(uint32_t param)
+{
+    SPI_transactionBegin(SPI_CHANNEL1);
+
+    for(uint32_t i = 0; i < param; i++)
+    {
+        const SpiTransferConfig_t TransferConfig =
+        {
+            .Channel = SPI_CHANNEL1,
+            .size = 16U,
+            .data = &BenchData[(i * 16U) % BENCH_SPI_FRAMES]
+        };
+
+        SPI_transfer(&TransferConfig);
+    }
+
+    SPI_transactionEnd(SPI_CHANNEL1);
+}
+
+static void BENCH_spiDeviceSelect(uint32_t param)
+{
+    for(uint32_t i = 0; i < param; i++)
+    {
+        for(uint32_t d = 0; d < 2U; d++)
+        {
+            SPI_deviceSelect(&BenchDevices[d]);
+            SPI_deviceDeselect(&BenchDevices[d]);
+        }
+    }
+}
+
+static void BENCH_spiSoftTransfer(uint32_t param)
+{
+    const SpiTransferConfig_t TransferConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchData
+    };
+
+    SPI_softTransfer(&TransferConfig);
+}
+
+static void BENCH_spiSoftReceive(uint32_t param)
+{
+    const SpiReceiveConfig_t ReceiveConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchData
+    };
+
+    SPI_softReceive(&ReceiveConfig);
+}
+
+static void BENCH_spiTransferDma(uint32_t param)
+{
+    const SpiTransferConfig_t TransferConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchData
+    };
+
+    SPI_transferDma(&TransferConfig);
+    SPI_dmaWait(SPI_CHANNEL1);
+}
+
+static void BENCH_spiReceiveDma(uint32_t param)
+{
+    const SpiReceiveConfig_t ReceiveConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchData
+    };
+
+    SPI_receiveDma(&ReceiveConfig);
+    SPI_dmaWait(SPI_CHANNEL1);
+}
+
+static void BENCH_spiTransferDma8(uint32_t param)
+{
+    const SpiTransfer8Config_t TransferConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .data = BenchFlash
+    };
+
+    SPI_transferDma8(&TransferConfig);
+    SPI_dmaWait(SPI_CHANNEL1);
+}
+
+static void BENCH_spiQueueSelect(void)
+{
+    static bool selected = false;
+
+    if(!selected)
+    {
+        SPI_queueInit(BenchConfig, 1);
+        selected = true;
+    }
+}
+
+static void BENCH_spiQueue(uint32_t param)
+{
+    BENCH_spiQueueSelect();
+
+    for(uint32_t i = 0; i < param; i++)
+    {
+        const SpiQueueTransaction_t Transaction =
+        {
+            .Cs = BenchCs,
+            .size = 16U,
+            .txData = &BenchFlash[(i * 16U) % BENCH_SPI_FRAMES],
+            .rxData = NULL
+        };
+
+        while(!SPI_queuePush(SPI_CHANNEL1, &Transaction))
+        {
+            __WFI();
+        }
+    }
+
+    SPI_queueWait(SPI_CHANNEL1);
+}
+
+static void BENCH_spiCrcSelect(void)
+{
+    static bool selected = false;
+
+    if(!selected)
+    {
+        SPI_init(BenchCrcConfig, 1);
+        SPI_dmaInit(BenchCrcConfig, 1);
+        selected = true;
+    }
+}
+
+static void BENCH_spiTransferReceiveCrc(uint32_t param)
+{
+    BENCH_spiCrcSelect();
+
+    const SpiExchangeConfig_t ExchangeConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .txData = BenchData,
+        .rxData = BenchData
+    };
+
+    (void)SPI_transferReceive(&ExchangeConfig);
+}
+
+static void BENCH_spiTransferReceiveDmaCrc(uint32_t param)
+{
+    BENCH_spiCrcSelect();
+
+    const SpiExchangeConfig_t ExchangeConfig =
+    {
+        .Channel = SPI_CHANNEL1,
+        .size = param,
+        .txData = BenchData,
+        .rxData = BenchData
+    };
+
+    SPI_transferReceiveDma(&ExchangeConfig);
+    SPI_dmaWait(SPI_CHANNEL1);
+}
+
+static void BENCH_spiItSelect(void)
+{
+    static bool selected = false;
+
+    if(!selected)
+    {
+        SPI_init(BenchItConfig,
+                 sizeof(BenchItConfig)/sizeof(BenchItConfig[0]));
+        SPI_itInit(BenchItConfig,
+                   sizeof(BenchItConfig)/sizeof(BenchItConfig[0]));
+        selected = true;
+    }
+}
+
+static void BENCH_spiTransferReceiveIt(uint32_t param)
+{
+    BENCH_spiItSelect();
+
+    for(uint32_t i = 0; i < param; i++)
+    {
+        const SpiExchangeConfig_t ExchangeConfig =
+        {
+            .Channel = (SpiChannel_t)i,
+            .size = BENCH_SPI_IT_FRAMES,
+            .txData = &BenchData[i * BENCH_SPI_IT_FRAMES],
+            .rxData = &BenchData[i * BENCH_SPI_IT_FRAMES]
+        };
+
+        SPI_transferReceiveIt(&ExchangeConfig);
+    }
+
+    for(uint32_t i = 0; i < param; i++)
+    {
+        SPI_itWait((SpiChannel_t)i);
+    }
+}
+
+int main(void)
+{
+    /* Enable clock access to SPI1-SPI4*/
+    RCC->APB2ENR |= RCC_APB2ENR_SPI1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_SPI2EN;
+    RCC->APB1ENR |= RCC_APB1ENR_SPI3EN;
+    RCC->APB2ENR |= RCC_APB2ENR_SPI4EN;
+    /* Enable clock access to GPIOB for the software SPI*/
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN;
+    /* Enable clock access to DMA1 and DMA2 for the DMA transfers*/
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+
+    SPI_softInit(BenchSoftConfig,
+                 sizeof(BenchSoftConfig)/sizeof(BenchSoftConfig[0]));
+    SPI_dmaInit(BenchConfig, sizeof(BenchConfig)/sizeof(BenchConfig[0]));
+    for(uint32_t i = 0; i < (sizeof(BenchDevices)/sizeof(BenchDevices[0])); 
+        i++)
+    {
+        SPI_deviceInit(&BenchDevices[i]);
+    }
+
+    for(uint32_t i = 0; i < BENCH_SPI_FRAMES; i++)
+    {
+        BenchData[i] = (uint16_t)(i & 0xFFU);
+    }
+
+    BENCH_init("spi");
+    BENCH_run(BenchCases, sizeof(BenchCases)/sizeof(BenchCases[0]));
+    uint32_t failures = BENCH_finish();
+
+#ifdef HOST_BUILD
+    return (failures == 0U) ? 0 : 1;
+#else
+    /* Stop here, the results are read through the debugger */
+    (void)failures;
+    while(1)
+    {
+    }
+#endif
+}
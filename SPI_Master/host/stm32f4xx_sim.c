@@ -0,0 +1,1789 @@
+/**
+ * @file stm32f4xx_sim.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the simulated STM32F401 register file. Every
+ * register access of the drivers is routed through this module on a host
+ * build. Plain registers behave as memory; the GPIO and SPI registers with
+ * side effects (BSRR, IDR, SR and DR) follow the reference manual closely
+ * enough for the drivers to run to completion. Every access is charged to
+ * a simulated core clock through a bus-cost model, and the SPI frames take
+ * the time set by the baud rate prescaler, so the host build can be used
+ * to benchmark the drivers. The timers count on the same clock, their 
+ * update and compare events request the DMA streams and raise interrupts,
+ * and the interrupt handlers of the application run between two register 
+ * accesses, as the core would take them. The edges of the input pins 
+ * raise the EXTI lines selected in SYSCFG. The SPI peripherals run on the
+ * same clock, request their DMA streams on TXE/RXNE and raise their 
+ * interrupts.
+ * @version 1.0
+ * @date 2025-04-07
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include "stm32f4xx_sim.h"  /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/** Number of GPIO ports in the AHB1 GPIO window (GPIOA-GPIOH) */
+#define SIM_GPIO_PORTS      8U
+/** Address space reserved to each GPIO port */
+#define SIM_GPIO_SIZE       0x400UL
+/** Number of SPI peripherals */
+#define SIM_SPI_PORTS       4U
+/** Number of simulated timers (TIM1-TIM5) */
+#define SIM_TIMERS          5U
+/** Number of DMA controllers and streams per controller */
+#define SIM_DMA_CONTROLLERS 2U
+#define SIM_DMA_STREAMS     8U
+/** Number of interrupt lines of the NVIC */
+#define SIM_IRQ_LINES       96U
+
+/** Base of the SRAM addresses handed to the DMA for host buffers */
+#define SIM_SRAM_BASE       0x20000000UL
+/** Number of host buffers that can be handed to the DMA */
+#define SIM_SRAM_SLOTS      32U
+/** Address space of each host buffer handed to the DMA (1 MB) */
+#define SIM_SRAM_SLOT_SIZE  0x00100000UL
+
+/* Core cycles of the exception entry (stacking) and return (unstacking) */
+#define SIM_IRQ_ENTRY_CYCLES    12U
+#define SIM_IRQ_EXIT_CYCLES     10U
+
+/* Bus-cost model, in core cycles per register access */
+#define SIM_AHB_READ_CYCLES     3U
+#define SIM_AHB_WRITE_CYCLES    2U
+#define SIM_APB_READ_CYCLES     5U
+#define SIM_APB_WRITE_CYCLES    3U
+
+/* Register offsets with side effects */
+#define GPIO_IDR_OFFSET     0x10UL
+#define GPIO_BSRR_OFFSET    0x18UL
+#define SPI_CR1_OFFSET      0x00UL
+#define SPI_SR_OFFSET       0x08UL
+#define SPI_DR_OFFSET       0x0CUL
+#define TIM_SR_OFFSET       0x10UL
+#define TIM_EGR_OFFSET      0x14UL
+#define DMA_LIFCR_OFFSET    0x08UL
+#define DMA_HIFCR_OFFSET    0x0CUL
+#define DMA_STREAM_OFFSET   0x10UL
+#define DMA_STREAM_SIZE     0x18UL
+#define EXTI_SWIER_OFFSET   0x10UL
+#define EXTI_PR_OFFSET      0x14UL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+/**
+ * Core cycles needed to shift one frame: 8 or 16 bits (DFF) at FPCLK divided
+ * by 2^(BR+1). The APB clocks run at the core clock (no prescaler). A
+ * disabled SPI completes its frames at once.
+ */
+#define SIM_spiFrameCycles(Regs)                                    \
+    (((Regs)->CR1 & SPI_CR1_SPE) == 0U ? 0U :                       \
+    ((((Regs)->CR1 & SPI_CR1_DFF) ? 16U : 8U) *                     \
+    (2U << (((Regs)->CR1 & SPI_CR1_BR) >> 3))))
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+/**
+ * Defines the state of a simulated SPI peripheral that is not visible in
+ * its registers (transmit buffer, shift register and MISO line).
+ */
+typedef struct
+{
+    uint16_t rxData;        /**< Frame waiting to be read from DR */
+    uint16_t misoData;      /**< Frame driven by the slave on MISO */
+    bool misoFixed;         /**< MISO set by the host, otherwise loopback */
+    bool ovrClearArmed;     /**< DR read after OVR, SR read clears it */
+    bool modfClearArmed;    /**< SR read with MODF, CR1 write clears it */
+    bool txFull;            /**< A frame waits in the transmit buffer */
+    uint16_t txData;        /**< Frame in the transmit buffer */
+    bool shifting;          /**< A frame is on the wire */
+    uint16_t shiftData;     /**< Frame in the shift register */
+    uint64_t shiftEnd;      /**< Cycle at which the frame on the wire ends */
+    bool shiftCrc;          /**< The frame on the wire is the CRC */
+    bool updating;          /**< Update running, the DMA accesses skip it */
+}SimSpi_t;
+
+/**
+ * Defines a simulated timer: its registers, interrupt lines and the state
+ * of its prescaler.
+ */
+typedef struct
+{
+    uint32_t base;          /**< Base address of the timer */
+    IRQn_Type updateIrq;    /**< Interrupt line of the update event */
+    IRQn_Type compareIrq;   /**< Interrupt line of the compare events */
+    uint64_t lastCycle;     /**< Cycle up to which the timer has counted */
+    uint32_t prescaler;     /**< Cycles counted by the prescaler */
+}SimTimer_t;
+
+/**
+ * Defines a DMA request line to a stream and channel: a timer event, 
+ * TIMx_UP (event 0) or TIMx_CHn (event n), or a SPI event, SPIx_RX (event
+ * 0) or SPIx_TX (event 1).
+ */
+typedef struct
+{
+    uint32_t source;        /**< Base address of the timer or SPI */
+    uint8_t event;          /**< Event of the request */
+    uint32_t dma;           /**< Base address of the DMA controller */
+    uint8_t stream;         /**< Stream of the request */
+    uint8_t channel;        /**< Channel of the request (CHSEL) */
+}SimDmaRequest_t;
+
+/**
+ * Defines the state of a simulated DMA stream that is not visible in its
+ * registers.
+ */
+typedef struct
+{
+    uint32_t items;         /**< NDTR latched when the stream is enabled */
+}SimDmaStream_t;
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** The simulated peripheral address space */
+uint32_t SimPeripheralMemory[SIM_PERIPH_SIZE / sizeof(uint32_t)];
+
+/** Simulated core clock cycles elapsed since the power-on reset */
+static uint64_t simCycles;
+
+/** Register accesses performed since the power-on reset */
+static uint32_t simAccesses;
+
+/** Levels driven on the input pins of every GPIO port by the host */
+static uint16_t gpioInput[SIM_GPIO_PORTS];
+
+/** Hidden state of the SPI peripherals */
+static SimSpi_t simSpi[SIM_SPI_PORTS];
+
+/** Base addresses of the SPI peripherals, ordered by SPI number */
+static const uint32_t spiBase[SIM_SPI_PORTS] =
+{
+    SPI1_BASE, SPI2_BASE, SPI3_BASE, SPI4_BASE
+};
+
+/** Timers, ordered by timer number */
+static SimTimer_t simTimer[SIM_TIMERS] =
+{
+    {TIM1_BASE, TIM1_UP_TIM10_IRQn, TIM1_CC_IRQn, 0, 0},
+    {TIM2_BASE, TIM2_IRQn, TIM2_IRQn, 0, 0},
+    {TIM3_BASE, TIM3_IRQn, TIM3_IRQn, 0, 0},
+    {TIM4_BASE, TIM4_IRQn, TIM4_IRQn, 0, 0},
+    {TIM5_BASE, TIM5_IRQn, TIM5_IRQn, 0, 0}
+};
+
+/** DMA request lines of the timer events (RM0368 DMA request mapping) */
+static const SimDmaRequest_t simTimerRequest[] =
+{
+    {TIM1_BASE, 0, DMA2_BASE, 5, 6},    /* TIM1_UP */
+    {TIM1_BASE, 1, DMA2_BASE, 1, 6},    /* TIM1_CH1 */
+    {TIM1_BASE, 1, DMA2_BASE, 3, 6},    /* TIM1_CH1 */
+    {TIM1_BASE, 1, DMA2_BASE, 6, 0},    /* TIM1_CH1 */
+    {TIM1_BASE, 2, DMA2_BASE, 2, 6},    /* TIM1_CH2 */
+    {TIM1_BASE, 3, DMA2_BASE, 6, 6},    /* TIM1_CH3 */
+    {TIM1_BASE, 4, DMA2_BASE, 4, 6},    /* TIM1_CH4 */
+    {TIM2_BASE, 0, DMA1_BASE, 1, 3},    /* TIM2_UP */
+    {TIM2_BASE, 0, DMA1_BASE, 7, 3},    /* TIM2_UP */
+    {TIM2_BASE, 1, DMA1_BASE, 5, 3},    /* TIM2_CH1 */
+    {TIM3_BASE, 0, DMA1_BASE, 2, 5},    /* TIM3_UP */
+    {TIM3_BASE, 1, DMA1_BASE, 4, 5},    /* TIM3_CH1 */
+    {TIM5_BASE, 0, DMA1_BASE, 0, 6},    /* TIM5_UP */
+};
+
+/** DMA request lines of the SPI events (RM0368 DMA request mapping) */
+static const SimDmaRequest_t simSpiRequest[] =
+{
+    {SPI1_BASE, 0, DMA2_BASE, 0, 3},    /* SPI1_RX */
+    {SPI1_BASE, 0, DMA2_BASE, 2, 3},    /* SPI1_RX */
+    {SPI1_BASE, 1, DMA2_BASE, 3, 3},    /* SPI1_TX */
+    {SPI1_BASE, 1, DMA2_BASE, 5, 3},    /* SPI1_TX */
+    {SPI2_BASE, 0, DMA1_BASE, 3, 0},    /* SPI2_RX */
+    {SPI2_BASE, 1, DMA1_BASE, 4, 0},    /* SPI2_TX */
+    {SPI3_BASE, 0, DMA1_BASE, 0, 0},    /* SPI3_RX */
+    {SPI3_BASE, 0, DMA1_BASE, 2, 0},    /* SPI3_RX */
+    {SPI3_BASE, 1, DMA1_BASE, 5, 0},    /* SPI3_TX */
+    {SPI3_BASE, 1, DMA1_BASE, 7, 0},    /* SPI3_TX */
+    {SPI4_BASE, 0, DMA2_BASE, 0, 4},    /* SPI4_RX */
+    {SPI4_BASE, 0, DMA2_BASE, 3, 5},    /* SPI4_RX */
+    {SPI4_BASE, 1, DMA2_BASE, 1, 4},    /* SPI4_TX */
+    {SPI4_BASE, 1, DMA2_BASE, 4, 5},    /* SPI4_TX */
+};
+
+/** Interrupt lines of the SPI peripherals, ordered by SPI number */
+static const IRQn_Type spiIrq[SIM_SPI_PORTS] =
+{
+    SPI1_IRQn, SPI2_IRQn, SPI3_IRQn, SPI4_IRQn
+};
+
+/** Hidden state of the DMA streams */
+static SimDmaStream_t simDma[SIM_DMA_CONTROLLERS][SIM_DMA_STREAMS];
+
+/** Host buffers handed to the DMA, slot n is SIM_SRAM_BASE + n MB */
+static volatile uint8_t *simSram[SIM_SRAM_SLOTS];
+
+/** NVIC interrupt enable and pending lines */
+static bool irqEnabled[SIM_IRQ_LINES];
+static bool irqPending[SIM_IRQ_LINES];
+
+/** Interrupts masked by the core (PRIMASK) */
+static bool irqMasked;
+
+/** The core is running an interrupt handler */
+static bool irqActive;
+
+/** Interrupts taken since the reset, to wake SIM_wfi */
+static uint32_t irqTaken;
+
+/*
+ * Interrupt handlers of the application. They are weak references: a
+ * handler that is not linked in reads as NULL and its line is ignored.
+ */
+extern void EXTI0_IRQHandler(void) __attribute__((weak));
+extern void EXTI1_IRQHandler(void) __attribute__((weak));
+extern void EXTI2_IRQHandler(void) __attribute__((weak));
+extern void EXTI3_IRQHandler(void) __attribute__((weak));
+extern void EXTI4_IRQHandler(void) __attribute__((weak));
+extern void EXTI9_5_IRQHandler(void) __attribute__((weak));
+extern void EXTI15_10_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream0_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream1_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream2_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream3_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream4_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream5_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream6_IRQHandler(void) __attribute__((weak));
+extern void DMA1_Stream7_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream0_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream1_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream2_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream3_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream4_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream5_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream6_IRQHandler(void) __attribute__((weak));
+extern void DMA2_Stream7_IRQHandler(void) __attribute__((weak));
+extern void TIM1_UP_TIM10_IRQHandler(void) __attribute__((weak));
+extern void TIM1_CC_IRQHandler(void) __attribute__((weak));
+extern void TIM2_IRQHandler(void) __attribute__((weak));
+extern void TIM3_IRQHandler(void) __attribute__((weak));
+extern void TIM4_IRQHandler(void) __attribute__((weak));
+extern void TIM5_IRQHandler(void) __attribute__((weak));
+extern void SPI1_IRQHandler(void) __attribute__((weak));
+extern void SPI2_IRQHandler(void) __attribute__((weak));
+extern void SPI3_IRQHandler(void) __attribute__((weak));
+extern void SPI4_IRQHandler(void) __attribute__((weak));
+
+/** Vector table of the simulated interrupt lines */
+static void (* const simVector[SIM_IRQ_LINES])(void) =
+{
+    [EXTI0_IRQn] = EXTI0_IRQHandler,
+    [EXTI1_IRQn] = EXTI1_IRQHandler,
+    [EXTI2_IRQn] = EXTI2_IRQHandler,
+    [EXTI3_IRQn] = EXTI3_IRQHandler,
+    [EXTI4_IRQn] = EXTI4_IRQHandler,
+    [EXTI9_5_IRQn] = EXTI9_5_IRQHandler,
+    [EXTI15_10_IRQn] = EXTI15_10_IRQHandler,
+    [DMA1_Stream0_IRQn] = DMA1_Stream0_IRQHandler,
+    [DMA1_Stream1_IRQn] = DMA1_Stream1_IRQHandler,
+    [DMA1_Stream2_IRQn] = DMA1_Stream2_IRQHandler,
+    [DMA1_Stream3_IRQn] = DMA1_Stream3_IRQHandler,
+    [DMA1_Stream4_IRQn] = DMA1_Stream4_IRQHandler,
+    [DMA1_Stream5_IRQn] = DMA1_Stream5_IRQHandler,
+    [DMA1_Stream6_IRQn] = DMA1_Stream6_IRQHandler,
+    [DMA1_Stream7_IRQn] = DMA1_Stream7_IRQHandler,
+    [DMA2_Stream0_IRQn] = DMA2_Stream0_IRQHandler,
+    [DMA2_Stream1_IRQn] = DMA2_Stream1_IRQHandler,
+    [DMA2_Stream2_IRQn] = DMA2_Stream2_IRQHandler,
+    [DMA2_Stream3_IRQn] = DMA2_Stream3_IRQHandler,
+    [DMA2_Stream4_IRQn] = DMA2_Stream4_IRQHandler,
+    [DMA2_Stream5_IRQn] = DMA2_Stream5_IRQHandler,
+    [DMA2_Stream6_IRQn] = DMA2_Stream6_IRQHandler,
+    [DMA2_Stream7_IRQn] = DMA2_Stream7_IRQHandler,
+    [TIM1_UP_TIM10_IRQn] = TIM1_UP_TIM10_IRQHandler,
+    [TIM1_CC_IRQn] = TIM1_CC_IRQHandler,
+    [TIM2_IRQn] = TIM2_IRQHandler,
+    [TIM3_IRQn] = TIM3_IRQHandler,
+    [TIM4_IRQn] = TIM4_IRQHandler,
+    [TIM5_IRQn] = TIM5_IRQHandler,
+    [SPI1_IRQn] = SPI1_IRQHandler,
+    [SPI2_IRQn] = SPI2_IRQHandler,
+    [SPI3_IRQn] = SPI3_IRQHandler,
+    [SPI4_IRQn] = SPI4_IRQHandler
+};
+
+/** DMA stream interrupt lines, ordered by controller and stream */
+static const IRQn_Type dmaIrq[SIM_DMA_CONTROLLERS][SIM_DMA_STREAMS] =
+{
+    {DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn,
+     DMA1_Stream3_IRQn, DMA1_Stream4_IRQn, DMA1_Stream5_IRQn,
+     DMA1_Stream6_IRQn, DMA1_Stream7_IRQn},
+    {DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn,
+     DMA2_Stream3_IRQn, DMA2_Stream4_IRQn, DMA2_Stream5_IRQn,
+     DMA2_Stream6_IRQn, DMA2_Stream7_IRQn}
+};
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint32_t SIM_physicalAddress(const volatile void * const reg);
+static uint32_t * SIM_word(uint32_t address);
+static int SIM_spiIndex(uint32_t base);
+static uint32_t SIM_busCost(uint32_t address, bool write);
+static uint16_t SIM_spiCrc(SPI_TypeDef * const Regs, uint32_t crc,
+                           uint16_t frame);
+static void SIM_spiLoad(uint32_t spi, uint16_t frame, bool crc, 
+                        uint64_t start);
+static void SIM_spiUpdate(uint32_t spi);
+static bool SIM_spiRequest(uint32_t spi, uint32_t event);
+static uint32_t SIM_registerAccess(uint32_t address, uint32_t value, 
+                                   bool write);
+static uint32_t SIM_access(uint32_t address, uint32_t value, bool write);
+static uint32_t SIM_memoryAccess(uint32_t address, uint32_t value, 
+                                 uint32_t size, bool write);
+static bool SIM_dmaRequest(uint32_t dma, uint32_t stream, uint32_t channel);
+static void SIM_timerEvent(SimTimer_t * const Timer, TIM_TypeDef * const Regs,
+                           uint32_t event);
+static void SIM_timersUpdate(void);
+static void SIM_spisUpdate(void);
+static void SIM_extiRaise(uint32_t lines);
+static void SIM_irqDispatch(void);
+static void SIM_hardwareUpdate(void);
+static void SIM_powerOn(void) __attribute__((constructor));
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SIM_physicalAddress()
+*//**
+ *\b Description:
+ * This function is used to translate a pointer into the simulated memory
+ * back into the physical STM32F401 address it represents.
+ *
+ * @param[in]   reg is a pointer into SimPeripheralMemory.
+ *
+ * @return  The physical address of the register.
+ *
+*****************************************************************************/
+static uint32_t SIM_physicalAddress(const volatile void * const reg)
+{
+    const volatile uint8_t * const start =
+        (const volatile uint8_t *)SimPeripheralMemory;
+    const volatile uint8_t * const byte = (const volatile uint8_t *)reg;
+
+    /* Drivers must only access registers inside the simulated window */
+    assert((byte >= start) && (byte < (start + SIM_PERIPH_SIZE)));
+
+    return (uint32_t)(PERIPH_BASE + (uint32_t)(byte - start));
+}
+
+/*****************************************************************************
+ * Function: SIM_word()
+*//**
+ *\b Description:
+ * This function is used to get the storage of the 32 bits register that
+ * contains the physical address.
+ *
+ * @param[in]   address is a physical address inside the simulated window.
+ *
+ * @return  A pointer to the register storage.
+ *
+*****************************************************************************/
+static uint32_t * SIM_word(uint32_t address)
+{
+    return &SimPeripheralMemory[(address - PERIPH_BASE) / sizeof(uint32_t)];
+}
+
+/*****************************************************************************
+ * Function: SIM_spiIndex()
+*//**
+ *\b Description:
+ * This function is used to find the SPI peripheral that owns a base address.
+ *
+ * @param[in]   base is the base address of a 0x400 bytes peripheral block.
+ *
+ * @return  The SPI index (0 for SPI1) or -1 when it is not a SPI block.
+ *
+*****************************************************************************/
+static int SIM_spiIndex(uint32_t base)
+{
+    for(int i = 0; i < (int)SIM_SPI_PORTS; i++)
+    {
+        if(spiBase[i] == base)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*****************************************************************************
+ * Function: SIM_busCost()
+*//**
+ *\b Description:
+ * This function is used to get the cost in core cycles of one register
+ * access. The model charges the AHB1 peripherals (GPIO, RCC, DMA) less than
+ * the APB peripherals, which go through the AHB/APB bridge, and charges
+ * reads more than the posted writes.
+ *
+ * @param[in]   address is the physical address of the register.
+ * @param[in]   write is true for a write access.
+ *
+ * @return  The number of core cycles spent on the bus.
+ *
+*****************************************************************************/
+static uint32_t SIM_busCost(uint32_t address, bool write)
+{
+    if(address >= AHB1PERIPH_BASE)
+    {
+        return write ? SIM_AHB_WRITE_CYCLES : SIM_AHB_READ_CYCLES;
+    }
+
+    return write ? SIM_APB_WRITE_CYCLES : SIM_APB_READ_CYCLES;
+}
+
+/*****************************************************************************
+ * Function: SIM_spiCrc()
+*//**
+ *\b Description:
+ * This function is used to add a frame to a CRC of a SPI: the CRC of 8 or 
+ * 16 bits (DFF) with the polynomial of CRCPR, most significant bit first.
+ *
+ * @param[in]   Regs is the SPI registers.
+ * @param[in]   crc is the CRC so far (TXCRCR or RXCRCR).
+ * @param[in]   frame is the data frame.
+ *
+ * @return  The new CRC.
+ *
+*****************************************************************************/
+static uint16_t SIM_spiCrc(SPI_TypeDef * const Regs, uint32_t crc,
+                           uint16_t frame)
+{
+    const uint32_t bits = (Regs->CR1 & SPI_CR1_DFF) ? 16U : 8U;
+    const uint32_t top = 1UL << (bits - 1U);
+
+    for(uint32_t bit = bits; bit > 0U; bit--)
+    {
+        const bool feedback = (((crc & top) != 0U) != 
+                               (((frame >> (bit - 1U)) & 1U) != 0U));
+
+        crc <<= 1;
+        if(feedback)
+        {
+            crc ^= Regs->CRCPR;
+        }
+    }
+
+    return (uint16_t)(crc & ((top << 1) - 1U));
+}
+
+/*****************************************************************************
+ * Function: SIM_spiLoad()
+*//**
+ *\b Description:
+ * This function is used to load a frame in the shift register of a SPI. 
+ * A data frame is added to TXCRCR while CRCEN is set.
+ *
+ * @param[in]   spi is the SPI index (0 for SPI1).
+ * @param[in]   frame is the frame to send.
+ * @param[in]   crc is true for the CRC frame.
+ * @param[in]   start is the cycle at which the frame starts.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_spiLoad(uint32_t spi, uint16_t frame, bool crc, 
+                        uint64_t start)
+{
+    SimSpi_t * const Spi = &simSpi[spi];
+    SPI_TypeDef * const Regs = (SPI_TypeDef *)SIM_PERIPHERAL(spiBase[spi]);
+
+    Spi->shiftData = frame;
+    Spi->shiftCrc = crc;
+    Spi->shifting = true;
+    Spi->shiftEnd = start + SIM_spiFrameCycles(Regs);
+
+    if(!crc && (Regs->CR1 & SPI_CR1_CRCEN))
+    {
+        Regs->TXCRCR = SIM_spiCrc(Regs, Regs->TXCRCR, frame);
+    }
+}
+
+/*****************************************************************************
+ * Function: SIM_spiUpdate()
+*//**
+ *\b Description:
+ * This function is used to bring a simulated SPI up to the current cycle.
+ * Frames on the wire that are complete are moved to DR (RXNE, or OVR when
+ * DR was not read) and the transmit buffer is loaded into the shift
+ * register without gap, as the hardware does. The DMA requests of the SPI
+ * are served between the frames, so the streams keep the wire busy. The
+ * interrupt of the SPI is pended while an enabled event (TXEIE, RXNEIE, 
+ * ERRIE) is raised. With CRCEN, the frames received are added to RXCRCR,
+ * TXCRCR is sent after the last frame once CRCNEXT is set, and the CRC
+ * received is compared with RXCRCR (CRCERR).
+ *
+ * @param[in]   spi is the SPI index (0 for SPI1).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_spiUpdate(uint32_t spi)
+{
+    SimSpi_t * const Spi = &simSpi[spi];
+    SPI_TypeDef * const Regs = (SPI_TypeDef *)SIM_PERIPHERAL(spiBase[spi]);
+    bool progress = true;
+
+    /* The DR accesses of the DMA requests below run inside the update */
+    if(Spi->updating)
+    {
+        return;
+    }
+    Spi->updating = true;
+
+    while(progress)
+    {
+        progress = false;
+
+        if((Regs->CR2 & SPI_CR2_RXDMAEN) && (Regs->SR & SPI_SR_RXNE))
+        {
+            progress = SIM_spiRequest(spi, 0);
+        }
+        if((Regs->CR2 & SPI_CR2_TXDMAEN) && (Regs->SR & SPI_SR_TXE))
+        {
+            progress = SIM_spiRequest(spi, 1) || progress;
+        }
+
+        if(Spi->shifting && (simCycles >= Spi->shiftEnd))
+        {
+            const uint16_t received = Spi->misoFixed ? Spi->misoData : 
+                                                       Spi->shiftData;
+
+            progress = true;
+
+            if(Regs->SR & SPI_SR_RXNE)
+            {
+                /* DR was not read in time: the new frame is lost */
+                Regs->SR |= SPI_SR_OVR;
+            }
+            else
+            {
+                Spi->rxData = received;
+                Regs->SR |= SPI_SR_RXNE;
+            }
+
+            if(Regs->CR1 & SPI_CR1_CRCEN)
+            {
+                if(!Spi->shiftCrc)
+                {
+                    Regs->RXCRCR = SIM_spiCrc(Regs, Regs->RXCRCR, received);
+                }
+                else if(received != Regs->RXCRCR)
+                {
+                    Regs->SR |= SPI_SR_CRCERR;
+                }
+            }
+
+            if(Spi->txFull)
+            {
+                Spi->txFull = false;
+                SIM_spiLoad((uint32_t)spi, Spi->txData, false, 
+                            Spi->shiftEnd);
+                Regs->SR |= SPI_SR_TXE;
+            }
+            else if((Regs->CR1 & (SPI_CR1_CRCEN | SPI_CR1_CRCNEXT)) ==
+                    (SPI_CR1_CRCEN | SPI_CR1_CRCNEXT))
+            {
+                /* The CRC phase follows the last frame */
+                Regs->CR1 &= ~SPI_CR1_CRCNEXT;
+                SIM_spiLoad((uint32_t)spi, (uint16_t)Regs->TXCRCR, true,
+                            Spi->shiftEnd);
+            }
+            else
+            {
+                Spi->shifting = false;
+            }
+        }
+    }
+
+    if(Spi->shifting)
+    {
+        Regs->SR |= SPI_SR_BSY;
+    }
+    else
+    {
+        Regs->SR &= ~SPI_SR_BSY;
+    }
+
+    if(((Regs->CR2 & SPI_CR2_TXEIE) && (Regs->SR & SPI_SR_TXE)) ||
+       ((Regs->CR2 & SPI_CR2_RXNEIE) && (Regs->SR & SPI_SR_RXNE)) ||
+       ((Regs->CR2 & SPI_CR2_ERRIE) && 
+        (Regs->SR & (SPI_SR_OVR | SPI_SR_MODF | SPI_SR_CRCERR))))
+    {
+        irqPending[spiIrq[spi]] = true;
+    }
+
+    Spi->updating = false;
+}
+
+/*****************************************************************************
+ * Function: SIM_spiRequest()
+*//**
+ *\b Description:
+ * This function is used to issue a DMA request of a SPI on every stream
+ * mapped to it.
+ *
+ * @param[in]   spi is the SPI index (0 for SPI1).
+ * @param[in]   event is 0 for RX (RXNE), 1 for TX (TXE).
+ *
+ * @return  true when a stream moved a data item.
+ *
+*****************************************************************************/
+static bool SIM_spiRequest(uint32_t spi, uint32_t event)
+{
+    bool served = false;
+
+    for(uint32_t i = 0; 
+        i < (sizeof(simSpiRequest)/sizeof(simSpiRequest[0])); i++)
+    {
+        const SimDmaRequest_t * const Request = &simSpiRequest[i];
+
+        if((Request->source == spiBase[spi]) && (Request->event == event))
+        {
+            const bool moved = SIM_dmaRequest(Request->dma, Request->stream,
+                                              Request->channel);
+            DMA_Stream_TypeDef * const Stream = 
+                SIM_DMA_STREAM(Request->dma, Request->stream);
+            SPI_TypeDef * const Regs = 
+                (SPI_TypeDef *)SIM_PERIPHERAL(spiBase[spi]);
+
+            /* The end of the transmit stream starts the CRC phase */
+            if(moved && (event == 1U) && (Stream->NDTR == 0U) &&
+               (Regs->CR1 & SPI_CR1_CRCEN))
+            {
+                Regs->CR1 |= SPI_CR1_CRCNEXT;
+            }
+            served = moved || served;
+        }
+    }
+
+    return served;
+}
+
+/*****************************************************************************
+ * Function: SIM_access()
+*//**
+ *\b Description:
+ * This function is used to apply one bus access of the core to the 
+ * register file. The access is charged to the simulated clock, the 
+ * peripherals are brought up to the new cycle (interrupt handlers may run
+ * here), then the access completes and the interrupts it raised are 
+ * taken.
+ *
+ * @param[in]   address is the physical address of the register.
+ * @param[in]   value is the value to write (ignored on reads).
+ * @param[in]   write is true for a write access.
+ *
+ * @return  The value read (reads) or zero (writes).
+ *
+*****************************************************************************/
+static uint32_t SIM_access(uint32_t address, uint32_t value, bool write)
+{
+    simCycles += SIM_busCost(address, write);
+    simAccesses++;
+
+    SIM_hardwareUpdate();
+
+    const uint32_t data = SIM_registerAccess(address, value, write);
+
+    /* An interrupt raised by the access is taken right after it */
+    SIM_irqDispatch();
+
+    return data;
+}
+
+/*****************************************************************************
+ * Function: SIM_registerAccess()
+*//**
+ *\b Description:
+ * This function is used to apply one bus access (core or DMA) to the 
+ * register file. The registers with hardware side effects are modelled 
+ * here, any other register behaves as plain memory.
+ *
+ * @param[in]   address is the physical address of the register.
+ * @param[in]   value is the value to write (ignored on reads).
+ * @param[in]   write is true for a write access.
+ *
+ * @return  The value read (reads) or zero (writes).
+ *
+*****************************************************************************/
+static uint32_t SIM_registerAccess(uint32_t address, uint32_t value, 
+                                   bool write)
+{
+    uint32_t * const word = SIM_word(address & ~3UL);
+    const uint32_t base = address & ~(SIM_GPIO_SIZE - 1UL);
+    const uint32_t offset = address & (SIM_GPIO_SIZE - 1UL) & ~3UL;
+
+    /* GPIO ports: BSRR drives ODR and IDR follows the pins */
+    if((base >= GPIOA_BASE) &&
+       (base < (GPIOA_BASE + (SIM_GPIO_PORTS * SIM_GPIO_SIZE))))
+    {
+        const uint32_t port = (base - GPIOA_BASE) / SIM_GPIO_SIZE;
+        GPIO_TypeDef * const Gpio = (GPIO_TypeDef *)SIM_PERIPHERAL(base);
+
+        if(write && (offset == GPIO_BSRR_OFFSET))
+        {
+            /* Set has priority over reset when both bits are written */
+            Gpio->ODR = (Gpio->ODR & ~(value >> 16)) | (value & 0xFFFFUL);
+            return 0;
+        }
+        if(!write && (offset == GPIO_IDR_OFFSET))
+        {
+            uint32_t outputs = 0;
+
+            /* Output pins (MODER = 01) read back the ODR level */
+            for(uint32_t pin = 0; pin < 16U; pin++)
+            {
+                if(((Gpio->MODER >> (pin * 2U)) & 3UL) == 1UL)
+                {
+                    outputs |= (1UL << pin);
+                }
+            }
+            *word = (Gpio->ODR & outputs) | (gpioInput[port] & ~outputs);
+            return *word;
+        }
+        if(!write && (offset == GPIO_BSRR_OFFSET))
+        {
+            return 0;
+        }
+    }
+
+    /* SPI peripherals: DR loads the shift register, SR reports it */
+    const int spi = SIM_spiIndex(base);
+    if(spi >= 0)
+    {
+        SimSpi_t * const Spi = &simSpi[spi];
+        SPI_TypeDef * const Regs = (SPI_TypeDef *)SIM_PERIPHERAL(base);
+
+        SIM_spiUpdate((uint32_t)spi);
+
+        if(offset == SPI_DR_OFFSET)
+        {
+            if(write)
+            {
+                if(!Spi->shifting)
+                {
+                    /* Idle: the frame goes straight to the shift register */
+                    SIM_spiLoad((uint32_t)spi, (uint16_t)value, false,
+                                simCycles);
+                    SIM_spiUpdate((uint32_t)spi);
+                }
+                else
+                {
+                    /* Busy: the frame waits in the transmit buffer */
+                    Spi->txData = (uint16_t)value;
+                    Spi->txFull = true;
+                    Regs->SR &= ~SPI_SR_TXE;
+                }
+                return 0;
+            }
+            Regs->SR &= ~SPI_SR_RXNE;
+            Spi->ovrClearArmed = ((Regs->SR & SPI_SR_OVR) != 0U);
+            return Spi->rxData;
+        }
+        if(write && (offset == SPI_CR1_OFFSET))
+        {
+            /* Clearing CRCEN resets the CRC registers */
+            *word = value;
+            if((value & SPI_CR1_CRCEN) == 0U)
+            {
+                Regs->TXCRCR = 0;
+                Regs->RXCRCR = 0;
+            }
+            if(Spi->modfClearArmed)
+            {
+                Regs->SR &= ~SPI_SR_MODF;
+                Spi->modfClearArmed = false;
+            }
+            return 0;
+        }
+        if(write && (offset == SPI_SR_OFFSET))
+        {
+            /* CRCERR is cleared by writing zero, the others are read only */
+            Regs->SR &= ~(SPI_SR_CRCERR & ~value);
+            return 0;
+        }
+        if(!write && (offset == SPI_SR_OFFSET))
+        {
+            const uint32_t status = Regs->SR;
+
+            if(Spi->ovrClearArmed)
+            {
+                Regs->SR &= ~SPI_SR_OVR;
+                Spi->ovrClearArmed = false;
+            }
+            Spi->modfClearArmed = ((status & SPI_SR_MODF) != 0U);
+            return status;
+        }
+    }
+
+    /* EXTI: PR is cleared by writing one, SWIER raises the lines */
+    if((base == EXTI_BASE) && write)
+    {
+        EXTI_TypeDef * const Regs = (EXTI_TypeDef *)SIM_PERIPHERAL(base);
+
+        if(offset == EXTI_PR_OFFSET)
+        {
+            /* Clearing a line also clears its software request */
+            Regs->PR &= ~value;
+            Regs->SWIER &= ~value;
+            return 0;
+        }
+        if(offset == EXTI_SWIER_OFFSET)
+        {
+            SIM_extiRaise(value & ~Regs->SWIER);
+            Regs->SWIER = value;
+            return 0;
+        }
+    }
+
+    /* Timers: SR flags are cleared by writing zero, UG restarts */
+    for(uint32_t i = 0; i < SIM_TIMERS; i++)
+    {
+        if((base == simTimer[i].base) && write)
+        {
+            TIM_TypeDef * const Regs = (TIM_TypeDef *)SIM_PERIPHERAL(base);
+
+            if(offset == TIM_SR_OFFSET)
+            {
+                Regs->SR &= value;
+                return 0;
+            }
+            if((offset == TIM_EGR_OFFSET) && (value & TIM_EGR_UG))
+            {
+                Regs->CNT = 0;
+                simTimer[i].prescaler = 0;
+                SIM_timerEvent(&simTimer[i], Regs, 0);
+                return 0;
+            }
+        }
+    }
+
+    /* DMA controllers: the clear registers clear the status flags, the
+     * streams latch NDTR when they are enabled
+    */
+    if((base == DMA1_BASE) || (base == DMA2_BASE))
+    {
+        DMA_TypeDef * const Regs = (DMA_TypeDef *)SIM_PERIPHERAL(base);
+        const uint32_t dma = (base == DMA1_BASE) ? 0U : 1U;
+
+        if((offset == DMA_LIFCR_OFFSET) || (offset == DMA_HIFCR_OFFSET))
+        {
+            if(write)
+            {
+                volatile uint32_t * const Status = 
+                    (offset == DMA_LIFCR_OFFSET) ? &Regs->LISR : &Regs->HISR;
+
+                *Status &= ~value;
+            }
+            return 0;
+        }
+        if(write && (offset >= DMA_STREAM_OFFSET) &&
+           (((offset - DMA_STREAM_OFFSET) % DMA_STREAM_SIZE) == 0U))
+        {
+            const uint32_t stream = 
+                (offset - DMA_STREAM_OFFSET) / DMA_STREAM_SIZE;
+            DMA_Stream_TypeDef * const Stream = 
+                SIM_DMA_STREAM(base, stream);
+
+            if(((Stream->CR & DMA_SxCR_EN) == 0U) && (value & DMA_SxCR_EN))
+            {
+                simDma[dma][stream].items = Stream->NDTR;
+            }
+        }
+    }
+
+    /* Plain register */
+    if(write)
+    {
+        *word = value;
+        return 0;
+    }
+
+    return *word;
+}
+
+/*****************************************************************************
+ * Function: SIM_memoryAccess()
+*//**
+ *\b Description:
+ * This function is used to apply one DMA access to the memory side of a 
+ * transfer: a host buffer handed through SIM_dmaAddress, or a register.
+ *
+ * @param[in]   address is the address programmed in the stream.
+ * @param[in]   value is the value to write (ignored on reads).
+ * @param[in]   size is the size of the access in bytes (1, 2 or 4).
+ * @param[in]   write is true for a write access.
+ *
+ * @return  The value read (reads) or zero (writes).
+ *
+*****************************************************************************/
+static uint32_t SIM_memoryAccess(uint32_t address, uint32_t value, 
+                                 uint32_t size, bool write)
+{
+    if((address >= PERIPH_BASE) && (address < (PERIPH_BASE + SIM_PERIPH_SIZE)))
+    {
+        return SIM_registerAccess(address, value, write);
+    }
+
+    const uint32_t slot = (address - SIM_SRAM_BASE) / SIM_SRAM_SLOT_SIZE;
+
+    assert((address >= SIM_SRAM_BASE) && (slot < SIM_SRAM_SLOTS) &&
+           (simSram[slot] != NULL));
+
+    volatile uint8_t * const byte = 
+        simSram[slot] + ((address - SIM_SRAM_BASE) % SIM_SRAM_SLOT_SIZE);
+    uint32_t data = 0;
+
+    for(uint32_t i = 0; i < size; i++)
+    {
+        if(write)
+        {
+            byte[i] = (uint8_t)(value >> (8U * i));
+        }
+        else
+        {
+            data |= (uint32_t)byte[i] << (8U * i);
+        }
+    }
+
+    return data;
+}
+
+/*****************************************************************************
+ * Function: SIM_dmaRequest()
+*//**
+ *\b Description:
+ * This function is used to serve one DMA request: when the stream is 
+ * enabled on the requesting channel, one data item is moved (direct mode)
+ * and the counters, the half/complete flags and the circular or double 
+ * buffer reload follow the reference manual. The transfer does not cost 
+ * core cycles.
+ *
+ * @param[in]   dma is the base address of the DMA controller.
+ * @param[in]   stream is the stream of the request.
+ * @param[in]   channel is the channel of the request.
+ *
+ * @return  true when a data item was moved.
+ *
+*****************************************************************************/
+static bool SIM_dmaRequest(uint32_t dma, uint32_t stream, uint32_t channel)
+{
+    DMA_TypeDef * const Regs = (DMA_TypeDef *)SIM_PERIPHERAL(dma);
+    DMA_Stream_TypeDef * const Stream = SIM_DMA_STREAM(dma, stream);
+    const uint32_t controller = (dma == DMA1_BASE) ? 0U : 1U;
+    SimDmaStream_t * const State = &simDma[controller][stream];
+    const uint32_t cr = Stream->CR;
+
+    if(((cr & DMA_SxCR_EN) == 0U) || 
+       (((cr & DMA_SxCR_CHSEL) >> DMA_SxCR_CHSEL_Pos) != channel) ||
+       (Stream->NDTR == 0U))
+    {
+        return false;
+    }
+
+    const uint32_t memorySize = 1UL << ((cr & DMA_SxCR_MSIZE) >> 13);
+    const uint32_t periphSize = 1UL << ((cr & DMA_SxCR_PSIZE) >> 11);
+    const uint32_t item = State->items - Stream->NDTR;
+    const uint32_t memoryBase = 
+        ((cr & DMA_SxCR_DBM) && (cr & DMA_SxCR_CT)) ? Stream->M1AR : 
+                                                      Stream->M0AR;
+    const uint32_t memory = memoryBase + 
+        ((cr & DMA_SxCR_MINC) ? (item * memorySize) : 0U);
+    const uint32_t periph = Stream->PAR + 
+        ((cr & DMA_SxCR_PINC) ? (item * periphSize) : 0U);
+
+    if((cr & DMA_SxCR_DIR) == DMA_SxCR_DIR_0)
+    {
+        /* Memory to peripheral */
+        const uint32_t data = SIM_memoryAccess(memory, 0, memorySize, false);
+        (void)SIM_registerAccess(periph, data, true);
+    }
+    else
+    {
+        /* Peripheral to memory */
+        uint32_t data = SIM_registerAccess(periph, 0, false);
+
+        if(periphSize < 4U)
+        {
+            data &= (1UL << (8U * periphSize)) - 1UL;
+        }
+        (void)SIM_memoryAccess(memory, data, memorySize, true);
+    }
+
+    Stream->NDTR--;
+
+    /* Status flags of the stream in LISR/HISR */
+    static const uint8_t flagShift[4] = {0, 6, 16, 22};
+    volatile uint32_t * const Status = (stream < 4U) ? &Regs->LISR : 
+                                                      &Regs->HISR;
+    const uint32_t shift = flagShift[stream % 4U];
+    bool irq = false;
+
+    if(Stream->NDTR == (State->items / 2U))
+    {
+        *Status |= DMA_LISR_HTIF0 << shift;
+        irq = irq || ((cr & DMA_SxCR_HTIE) != 0U);
+    }
+    if(Stream->NDTR == 0U)
+    {
+        *Status |= DMA_LISR_TCIF0 << shift;
+        irq = irq || ((cr & DMA_SxCR_TCIE) != 0U);
+
+        if(cr & (DMA_SxCR_CIRC | DMA_SxCR_DBM))
+        {
+            Stream->NDTR = State->items;
+            if(cr & DMA_SxCR_DBM)
+            {
+                Stream->CR ^= DMA_SxCR_CT;
+            }
+        }
+        else
+        {
+            Stream->CR &= ~DMA_SxCR_EN;
+        }
+    }
+
+    if(irq)
+    {
+        irqPending[dmaIrq[controller][stream]] = true;
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+ * Function: SIM_extiRaise()
+*//**
+ *\b Description:
+ * This function is used to raise EXTI lines: the lines are latched in PR
+ * and the unmasked ones (IMR) pend the interrupt of their group.
+ *
+ * @param[in]   lines is the mask of the lines raised (0-15).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_extiRaise(uint32_t lines)
+{
+    EXTI_TypeDef * const Regs = (EXTI_TypeDef *)SIM_PERIPHERAL(EXTI_BASE);
+    const uint32_t raised = lines & 0xFFFFUL;
+
+    Regs->PR |= raised;
+
+    for(uint32_t line = 0; line < 16U; line++)
+    {
+        if((raised & Regs->IMR) & (1UL << line))
+        {
+            const IRQn_Type irq = (line < 5U) ? 
+                (IRQn_Type)(EXTI0_IRQn + (int)line) :
+                ((line < 10U) ? EXTI9_5_IRQn : EXTI15_10_IRQn);
+
+            irqPending[irq] = true;
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: SIM_timerEvent()
+*//**
+ *\b Description:
+ * This function is used to raise an update (event 0) or a compare (event 
+ * n) of a timer: the status flag is set, the DMA request is issued when 
+ * it is enabled (UDE/CCxDE) and the interrupt is pended when it is 
+ * enabled (UIE/CCxIE).
+ *
+ * @param[in]   Timer is the simulated timer.
+ * @param[in]   Regs is the register block of the timer.
+ * @param[in]   event is 0 for the update, n for the compare n.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_timerEvent(SimTimer_t * const Timer, TIM_TypeDef * const Regs,
+                           uint32_t event)
+{
+    const uint32_t flag = 1UL << event;
+
+    Regs->SR |= flag;
+
+    if(Regs->DIER & (TIM_DIER_UDE << event))
+    {
+        for(uint32_t i = 0; 
+            i < (sizeof(simTimerRequest)/sizeof(simTimerRequest[0])); i++)
+        {
+            const SimDmaRequest_t * const Request = &simTimerRequest[i];
+
+            if((Request->source == Timer->base) && (Request->event == event))
+            {
+                (void)SIM_dmaRequest(Request->dma, Request->stream, 
+                                     Request->channel);
+            }
+        }
+    }
+
+    if(Regs->DIER & flag)
+    {
+        irqPending[(event == 0U) ? Timer->updateIrq : Timer->compareIrq] = 
+            true;
+    }
+}
+
+/*****************************************************************************
+ * Function: SIM_timersUpdate()
+*//**
+ *\b Description:
+ * This function is used to bring the enabled timers up to the current 
+ * cycle. The counters count up at the core clock divided by PSC+1, reload
+ * after ARR (update event) and match the CCRx of the channels in output 
+ * compare mode (compare events). The interrupts pended by an event are 
+ * taken at once, so the handlers run at the cycle of their event.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_timersUpdate(void)
+{
+    for(uint32_t i = 0; i < SIM_TIMERS; i++)
+    {
+        SimTimer_t * const Timer = &simTimer[i];
+        TIM_TypeDef * const Regs = (TIM_TypeDef *)SIM_PERIPHERAL(Timer->base);
+
+        /* The clock of the handlers run below keeps moving forward */
+        while(Timer->lastCycle < simCycles)
+        {
+            if((Regs->CR1 & TIM_CR1_CEN) == 0U)
+            {
+                Timer->lastCycle = simCycles;
+                break;
+            }
+
+            const uint64_t tick = (uint64_t)Regs->PSC + 1U - Timer->prescaler;
+
+            if((simCycles - Timer->lastCycle) < tick)
+            {
+                Timer->prescaler += (uint32_t)(simCycles - Timer->lastCycle);
+                Timer->lastCycle = simCycles;
+                break;
+            }
+
+            Timer->lastCycle += tick;
+            Timer->prescaler = 0;
+
+            if(Regs->CNT >= Regs->ARR)
+            {
+                Regs->CNT = 0;
+                SIM_timerEvent(Timer, Regs, 0);
+            }
+            else
+            {
+                Regs->CNT++;
+            }
+
+            const uint32_t compare[4] = {Regs->CCR1, Regs->CCR2, Regs->CCR3,
+                                         Regs->CCR4};
+            const uint32_t select[4] = 
+            {
+                Regs->CCMR1 & TIM_CCMR1_CC1S, Regs->CCMR1 & TIM_CCMR1_CC2S,
+                Regs->CCMR2 & TIM_CCMR2_CC3S, Regs->CCMR2 & TIM_CCMR2_CC4S
+            };
+
+            for(uint32_t channel = 0; channel < 4U; channel++)
+            {
+                if((select[channel] == 0U) && (Regs->CNT == compare[channel]))
+                {
+                    SIM_timerEvent(Timer, Regs, channel + 1U);
+                }
+            }
+
+            SIM_irqDispatch();
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: SIM_spisUpdate()
+*//**
+ *\b Description:
+ * This function is used to bring the SPI peripherals up to the current 
+ * cycle, with the DMA requests and the interrupts they raise.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_spisUpdate(void)
+{
+    for(uint32_t spi = 0; spi < SIM_SPI_PORTS; spi++)
+    {
+        SIM_spiUpdate(spi);
+    }
+}
+
+/*****************************************************************************
+ * Function: SIM_irqDispatch()
+*//**
+ *\b Description:
+ * This function is used to take the pending interrupts: every enabled and
+ * pending line runs its handler, charged with the exception entry and 
+ * return cycles. Handlers do not nest and wait while PRIMASK is set.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_irqDispatch(void)
+{
+    bool taken = true;
+
+    if(irqActive || irqMasked)
+    {
+        return;
+    }
+
+    while(taken)
+    {
+        taken = false;
+
+        for(uint32_t irq = 0; irq < SIM_IRQ_LINES; irq++)
+        {
+            if(irqPending[irq] && irqEnabled[irq] && (simVector[irq] != NULL))
+            {
+                irqPending[irq] = false;
+                irqActive = true;
+                simCycles += SIM_IRQ_ENTRY_CYCLES;
+                simVector[irq]();
+                simCycles += SIM_IRQ_EXIT_CYCLES;
+                irqActive = false;
+                irqTaken++;
+                taken = true;
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: SIM_hardwareUpdate()
+*//**
+ *\b Description:
+ * This function is used to bring the peripherals that run on their own 
+ * (timers, SPI and the DMA requests they issue) up to the current cycle, 
+ * and to take the interrupts they raise. The accesses of a handler call it 
+ * again, so the timers keep counting while the handler runs (the handlers
+ * do not nest).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_hardwareUpdate(void)
+{
+    SIM_timersUpdate();
+    SIM_spisUpdate();
+    SIM_irqDispatch();
+}
+
+/*****************************************************************************
+ * Function: SIM_reset()
+*//**
+ *\b Description:
+ * This function is used to put the simulated register file in the reset
+ * state of the STM32F401 (RM0368 reset values).
+ *
+ * POST-CONDITION: Every register holds its reset value. <br>
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_reset(void)
+{
+    memset(SimPeripheralMemory, 0, sizeof(SimPeripheralMemory));
+    memset(gpioInput, 0, sizeof(gpioInput));
+    memset(simSpi, 0, sizeof(simSpi));
+    memset(simDma, 0, sizeof(simDma));
+    memset((void *)simSram, 0, sizeof(simSram));
+    memset(irqEnabled, 0, sizeof(irqEnabled));
+    memset(irqPending, 0, sizeof(irqPending));
+    irqMasked = false;
+    irqActive = false;
+    simCycles = 0;
+    simAccesses = 0;
+
+    for(uint32_t i = 0; i < SIM_TIMERS; i++)
+    {
+        simTimer[i].lastCycle = 0;
+        simTimer[i].prescaler = 0;
+        /* TIM2 and TIM5 are 32 bits counters */
+        ((TIM_TypeDef *)SIM_PERIPHERAL(simTimer[i].base))->ARR = 
+            ((simTimer[i].base == TIM2_BASE) || 
+             (simTimer[i].base == TIM5_BASE)) ? 0xFFFFFFFFUL : 0xFFFFUL;
+    }
+
+    /* Debug pins (PA13-PA15, PB3-PB4) are configured out of reset */
+    GPIOA->MODER = 0xA8000000UL;
+    GPIOA->OSPEEDR = 0x0C000000UL;
+    GPIOA->PUPDR = 0x64000000UL;
+    GPIOB->MODER = 0x00000280UL;
+    GPIOB->OSPEEDR = 0x000000C0UL;
+    GPIOB->PUPDR = 0x00000100UL;
+
+    /* The transmit buffer of every SPI starts empty */
+    for(uint32_t i = 0; i < SIM_SPI_PORTS; i++)
+    {
+        ((SPI_TypeDef *)SIM_PERIPHERAL(spiBase[i]))->SR = SPI_SR_TXE;
+        ((SPI_TypeDef *)SIM_PERIPHERAL(spiBase[i]))->CRCPR = 0x0007UL;
+    }
+}
+
+/*****************************************************************************
+ * Function: SIM_powerOn()
+*//**
+ *\b Description:
+ * This function is run by the C runtime before main() to emulate the
+ * power-on reset of the microcontroller.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SIM_powerOn(void)
+{
+    SIM_reset();
+}
+
+/*****************************************************************************
+ * Function: SIM_read32()
+*//**
+ *\b Description:
+ * This function is used to read a 32 bits register of the simulated file.
+ *
+ * @param[in]   reg is a pointer to the register.
+ *
+ * @return  The register value.
+ *
+*****************************************************************************/
+uint32_t SIM_read32(volatile uint32_t * const reg)
+{
+    return SIM_access(SIM_physicalAddress(reg), 0, false);
+}
+
+/*****************************************************************************
+ * Function: SIM_write32()
+*//**
+ *\b Description:
+ * This function is used to write a 32 bits register of the simulated file.
+ *
+ * @param[in]   reg is a pointer to the register.
+ * @param[in]   value is the value to write.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_write32(volatile uint32_t * const reg, uint32_t value)
+{
+    (void)SIM_access(SIM_physicalAddress(reg), value, true);
+}
+
+/*****************************************************************************
+ * Function: SIM_read16()
+*//**
+ *\b Description:
+ * This function is used to read the lower half-word of a register of the
+ * simulated file (SPI registers are accessed as 16 bits).
+ *
+ * @param[in]   reg is a pointer to the register.
+ *
+ * @return  The register value.
+ *
+*****************************************************************************/
+uint16_t SIM_read16(volatile uint16_t * const reg)
+{
+    return (uint16_t)SIM_access(SIM_physicalAddress(reg), 0, false);
+}
+
+/*****************************************************************************
+ * Function: SIM_write16()
+*//**
+ *\b Description:
+ * This function is used to write the lower half-word of a register of the
+ * simulated file. The upper half-word of the register is cleared.
+ *
+ * @param[in]   reg is a pointer to the register.
+ * @param[in]   value is the value to write.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_write16(volatile uint16_t * const reg, uint16_t value)
+{
+    (void)SIM_access(SIM_physicalAddress(reg), value, true);
+}
+
+/*****************************************************************************
+ * Function: SIM_address()
+*//**
+ *\b Description:
+ * This function is used to translate a physical register address (as used
+ * by DIO_registerWrite or SPI_registerRead) into the simulated file.
+ *
+ * PRE-CONDITION: The address is inside the simulated window. <br>
+ *
+ * @param[in]   address is the physical address of the register.
+ *
+ * @return  A pointer to the simulated register.
+ *
+*****************************************************************************/
+volatile void * SIM_address(uint32_t address)
+{
+    assert((address >= PERIPH_BASE) &&
+           (address < (PERIPH_BASE + SIM_PERIPH_SIZE)));
+
+    return (volatile void *)SIM_PERIPHERAL(address);
+}
+
+/*****************************************************************************
+ * Function: SIM_gpioInputSet()
+*//**
+ *\b Description:
+ * This function is used to drive the input pins of a simulated GPIO port.
+ * Pins configured as output keep reading their ODR level. The edges raise
+ * the EXTI lines routed to the port, and their handlers run at once.
+ *
+ * @param[in]   Port is the GPIO port (GPIOA, GPIOB, ...).
+ * @param[in]   value is the level of the 16 pins of the port.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_gpioInputSet(const GPIO_TypeDef * const Port, uint16_t value)
+{
+    const uint32_t base = SIM_physicalAddress(Port);
+    const uint32_t port = (base - GPIOA_BASE) / SIM_GPIO_SIZE;
+    const SYSCFG_TypeDef * const Syscfg = 
+        (SYSCFG_TypeDef *)SIM_PERIPHERAL(SYSCFG_BASE);
+    const EXTI_TypeDef * const Exti = 
+        (EXTI_TypeDef *)SIM_PERIPHERAL(EXTI_BASE);
+    const uint32_t rising = value & ~gpioInput[port];
+    const uint32_t falling = ~value & gpioInput[port] & 0xFFFFUL;
+    uint32_t lines = 0;
+
+    /* Bring the clock up to now, so the edge lands after the handlers */
+    SIM_hardwareUpdate();
+    gpioInput[port] = value;
+
+    /* An edge raises its line when SYSCFG routes the port to it */
+    for(uint32_t pin = 0; pin < 16U; pin++)
+    {
+        const uint32_t source = 
+            (Syscfg->EXTICR[pin / 4U] >> ((pin % 4U) * 4U)) & 0xFUL;
+
+        if(source == port)
+        {
+            lines |= ((rising & Exti->RTSR) | (falling & Exti->FTSR)) & 
+                     (1UL << pin);
+        }
+    }
+
+    SIM_extiRaise(lines);
+    SIM_hardwareUpdate();
+}
+
+/*****************************************************************************
+ * Function: SIM_spiMisoSet()
+*//**
+ *\b Description:
+ * This function is used to set the frame a simulated slave returns on MISO.
+ * Until it is called, the SPI works as a loopback (MISO = MOSI).
+ *
+ * @param[in]   Spi is the SPI peripheral (SPI1, SPI2, ...).
+ * @param[in]   value is the frame returned on every transfer.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_spiMisoSet(const SPI_TypeDef * const Spi, uint16_t value)
+{
+    const int spi = SIM_spiIndex(SIM_physicalAddress(Spi));
+
+    assert(spi >= 0);
+    simSpi[spi].misoData = value;
+    simSpi[spi].misoFixed = true;
+}
+
+/*****************************************************************************
+ * Function: SIM_cyclesGet()
+*//**
+ *\b Description:
+ * This function is used to read the simulated core clock. It plays the role
+ * of the DWT cycle counter on the host.
+ *
+ * @return  The core cycles elapsed since the power-on reset.
+ *
+*****************************************************************************/
+uint64_t SIM_cyclesGet(void)
+{
+    return simCycles;
+}
+
+/*****************************************************************************
+ * Function: SIM_accessesGet()
+*//**
+ *\b Description:
+ * This function is used to read the number of register accesses performed
+ * by the drivers since the power-on reset.
+ *
+ * @return  The number of register accesses.
+ *
+*****************************************************************************/
+uint32_t SIM_accessesGet(void)
+{
+    return simAccesses;
+}
+
+/*****************************************************************************
+ * Function: SIM_idle()
+*//**
+ *\b Description:
+ * This function is used to let the simulated clock run without register
+ * accesses (CPU work, sleep, delays).
+ *
+ * @param[in]   cycles is the number of core cycles to elapse.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_idle(uint32_t cycles)
+{
+    simCycles += cycles;
+    SIM_hardwareUpdate();
+}
+
+/*****************************************************************************
+ * Function: SIM_dmaAddress()
+*//**
+ *\b Description:
+ * This function is used to get the 32 bits bus address of a pointer that
+ * is programmed in a DMA stream. A simulated register gives its physical 
+ * address; a host buffer is given an SRAM address (1 MB window per 
+ * buffer), so the simulated DMA can reach it.
+ *
+ * @param[in]   pointer is a register or a buffer of the application.
+ *
+ * @return  The bus address of the pointer.
+ *
+*****************************************************************************/
+uint32_t SIM_dmaAddress(const volatile void * const pointer)
+{
+    const volatile uint8_t * const start =
+        (const volatile uint8_t *)SimPeripheralMemory;
+    const volatile uint8_t * const byte = (const volatile uint8_t *)pointer;
+    uint32_t slot = 0;
+
+    if((byte >= start) && (byte < (start + SIM_PERIPH_SIZE)))
+    {
+        return SIM_physicalAddress(pointer);
+    }
+
+    /* Reuse the window of the buffer, or open the next free one */
+    while((slot < SIM_SRAM_SLOTS) && (simSram[slot] != NULL) && 
+          ((byte < simSram[slot]) || 
+           (byte >= (simSram[slot] + SIM_SRAM_SLOT_SIZE))))
+    {
+        slot++;
+    }
+    assert(slot < SIM_SRAM_SLOTS);
+
+    if(simSram[slot] == NULL)
+    {
+        simSram[slot] = (volatile uint8_t *)byte;
+    }
+
+    return SIM_SRAM_BASE + (slot * SIM_SRAM_SLOT_SIZE) + 
+           (uint32_t)(byte - simSram[slot]);
+}
+
+/*****************************************************************************
+ * Function: SIM_irqEnable()
+*//**
+ *\b Description:
+ * This function is used to clear PRIMASK (__enable_irq). The interrupts 
+ * pended while they were masked are taken at once.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_irqEnable(void)
+{
+    irqMasked = false;
+    SIM_hardwareUpdate();
+}
+
+/*****************************************************************************
+ * Function: SIM_irqDisable()
+*//**
+ *\b Description:
+ * This function is used to set PRIMASK (__disable_irq).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_irqDisable(void)
+{
+    irqMasked = true;
+}
+
+/*****************************************************************************
+ * Function: SIM_primaskGet()
+*//**
+ *\b Description:
+ * This function is used to read PRIMASK (__get_PRIMASK), to restore it
+ * after a critical section with __set_PRIMASK.
+ *
+ * @return  1 while the interrupts are masked, else 0.
+ *
+*****************************************************************************/
+uint32_t SIM_primaskGet(void)
+{
+    return irqMasked ? 1U : 0U;
+}
+
+/*****************************************************************************
+ * Function: SIM_wfi()
+*//**
+ *\b Description:
+ * This function is used to sleep until an interrupt (__WFI). The clock 
+ * runs until an enabled line is pending (masked by PRIMASK) or has been 
+ * taken; it gives up after one simulated second when nothing can wake 
+ * the core.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SIM_wfi(void)
+{
+    const uint32_t taken = irqTaken;
+
+    for(uint32_t cycle = 0; cycle < 16000000UL; cycle++)
+    {
+        if(irqTaken != taken)
+        {
+            return;
+        }
+
+        for(uint32_t irq = 0; irq < SIM_IRQ_LINES; irq++)
+        {
+            if(irqPending[irq] && irqEnabled[irq])
+            {
+                SIM_hardwareUpdate();
+                return;
+            }
+        }
+
+        simCycles++;
+        SIM_hardwareUpdate();
+    }
+}
+
+/*****************************************************************************
+ * Function: NVIC_EnableIRQ()
+*//**
+ *\b Description:
+ * This function is used to enable an interrupt line (CMSIS NVIC).
+ *
+ * @param[in]   IRQn is the interrupt line.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    irqEnabled[IRQn] = true;
+    SIM_hardwareUpdate();
+}
+
+/*****************************************************************************
+ * Function: NVIC_DisableIRQ()
+*//**
+ *\b Description:
+ * This function is used to disable an interrupt line (CMSIS NVIC).
+ *
+ * @param[in]   IRQn is the interrupt line.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    irqEnabled[IRQn] = false;
+}
+
+/*****************************************************************************
+ * Function: NVIC_SetPendingIRQ()
+*//**
+ *\b Description:
+ * This function is used to pend an interrupt line by software (CMSIS 
+ * NVIC).
+ *
+ * @param[in]   IRQn is the interrupt line.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    irqPending[IRQn] = true;
+    SIM_hardwareUpdate();
+}
+
+/*****************************************************************************
+ * Function: NVIC_ClearPendingIRQ()
+*//**
+ *\b Description:
+ * This function is used to clear a pending interrupt line (CMSIS NVIC).
+ *
+ * @param[in]   IRQn is the interrupt line.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    irqPending[IRQn] = false;
+}
+
+/*****************************************************************************
+ * Function: NVIC_SetPriority()
+*//**
+ *\b Description:
+ * This function is used to set the priority of an interrupt line (CMSIS 
+ * NVIC). The simulation does not nest handlers, the priority is ignored.
+ *
+ * @param[in]   IRQn is the interrupt line.
+ * @param[in]   priority is the priority of the line.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    (void)IRQn;
+    (void)priority;
+}
@@ -0,0 +1,520 @@
+/**
+ * @file stm32f4xx_sim.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the simulated STM32F401 register file.
+ * This header replaces the microcontroller family header on a host build
+ * (HOST_BUILD defined). It keeps the CMSIS register layouts, base addresses
+ * and bit definitions used by the drivers, but the peripherals are mapped
+ * into a RAM array so the drivers can run and be measured on a Linux host.
+ * @version 1.0
+ * @date 2025-04-07
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef STM32F4XX_SIM_H_
+#define STM32F4XX_SIM_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/** Physical address of the first simulated peripheral (APB1) */
+#define PERIPH_BASE         0x40000000UL
+/** Size in bytes of the simulated peripheral address space (APB1-AHB1) */
+#define SIM_PERIPH_SIZE     0x00028000UL
+
+#define APB1PERIPH_BASE     PERIPH_BASE
+#define APB2PERIPH_BASE     (PERIPH_BASE + 0x00010000UL)
+#define AHB1PERIPH_BASE     (PERIPH_BASE + 0x00020000UL)
+
+#define TIM2_BASE           (APB1PERIPH_BASE + 0x0000UL)
+#define TIM3_BASE           (APB1PERIPH_BASE + 0x0400UL)
+#define TIM4_BASE           (APB1PERIPH_BASE + 0x0800UL)
+#define TIM5_BASE           (APB1PERIPH_BASE + 0x0C00UL)
+#define SPI2_BASE           (APB1PERIPH_BASE + 0x3800UL)
+#define SPI3_BASE           (APB1PERIPH_BASE + 0x3C00UL)
+#define TIM1_BASE           (APB2PERIPH_BASE + 0x0000UL)
+#define SPI1_BASE           (APB2PERIPH_BASE + 0x3000UL)
+#define SPI4_BASE           (APB2PERIPH_BASE + 0x3400UL)
+#define SYSCFG_BASE         (APB2PERIPH_BASE + 0x3800UL)
+#define EXTI_BASE           (APB2PERIPH_BASE + 0x3C00UL)
+#define GPIOA_BASE          (AHB1PERIPH_BASE + 0x0000UL)
+#define GPIOB_BASE          (AHB1PERIPH_BASE + 0x0400UL)
+#define GPIOC_BASE          (AHB1PERIPH_BASE + 0x0800UL)
+#define GPIOD_BASE          (AHB1PERIPH_BASE + 0x0C00UL)
+#define GPIOE_BASE          (AHB1PERIPH_BASE + 0x1000UL)
+#define GPIOH_BASE          (AHB1PERIPH_BASE + 0x1C00UL)
+#define RCC_BASE            (AHB1PERIPH_BASE + 0x3800UL)
+#define DMA1_BASE           (AHB1PERIPH_BASE + 0x6000UL)
+#define DMA2_BASE           (AHB1PERIPH_BASE + 0x6400UL)
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * General Purpose I/O register layout.
+ */
+typedef struct
+{
+    volatile uint32_t MODER;    /**< Port mode register, 0x00 */
+    volatile uint32_t OTYPER;   /**< Port output type register, 0x04 */
+    volatile uint32_t OSPEEDR;  /**< Port output speed register, 0x08 */
+    volatile uint32_t PUPDR;    /**< Port pull-up/pull-down register, 0x0C */
+    volatile uint32_t IDR;      /**< Port input data register, 0x10 */
+    volatile uint32_t ODR;      /**< Port output data register, 0x14 */
+    volatile uint32_t BSRR;     /**< Port bit set/reset register, 0x18 */
+    volatile uint32_t LCKR;     /**< Port configuration lock register, 0x1C */
+    volatile uint32_t AFR[2];   /**< Alternate function registers, 0x20-0x24 */
+}GPIO_TypeDef;
+
+/**
+ * Serial Peripheral Interface register layout.
+ */
+typedef struct
+{
+    volatile uint32_t CR1;      /**< Control register 1, 0x00 */
+    volatile uint32_t CR2;      /**< Control register 2, 0x04 */
+    volatile uint32_t SR;       /**< Status register, 0x08 */
+    volatile uint32_t DR;       /**< Data register, 0x0C */
+    volatile uint32_t CRCPR;    /**< CRC polynomial register, 0x10 */
+    volatile uint32_t RXCRCR;   /**< RX CRC register, 0x14 */
+    volatile uint32_t TXCRCR;   /**< TX CRC register, 0x18 */
+    volatile uint32_t I2SCFGR;  /**< I2S configuration register, 0x1C */
+    volatile uint32_t I2SPR;    /**< I2S prescaler register, 0x20 */
+}SPI_TypeDef;
+
+/**
+ * Reset and Clock Control register layout.
+ */
+typedef struct
+{
+    volatile uint32_t CR;           /**< Clock control register, 0x00 */
+    volatile uint32_t PLLCFGR;      /**< PLL configuration register, 0x04 */
+    volatile uint32_t CFGR;         /**< Clock configuration register, 0x08 */
+    volatile uint32_t CIR;          /**< Clock interrupt register, 0x0C */
+    volatile uint32_t AHB1RSTR;     /**< AHB1 peripheral reset, 0x10 */
+    volatile uint32_t AHB2RSTR;     /**< AHB2 peripheral reset, 0x14 */
+    volatile uint32_t AHB3RSTR;     /**< AHB3 peripheral reset, 0x18 */
+    uint32_t RESERVED0;             /**< Reserved, 0x1C */
+    volatile uint32_t APB1RSTR;     /**< APB1 peripheral reset, 0x20 */
+    volatile uint32_t APB2RSTR;     /**< APB2 peripheral reset, 0x24 */
+    uint32_t RESERVED1[2];          /**< Reserved, 0x28-0x2C */
+    volatile uint32_t AHB1ENR;      /**< AHB1 peripheral clock enable, 0x30 */
+    volatile uint32_t AHB2ENR;      /**< AHB2 peripheral clock enable, 0x34 */
+    volatile uint32_t AHB3ENR;      /**< AHB3 peripheral clock enable, 0x38 */
+    uint32_t RESERVED2;             /**< Reserved, 0x3C */
+    volatile uint32_t APB1ENR;      /**< APB1 peripheral clock enable, 0x40 */
+    volatile uint32_t APB2ENR;      /**< APB2 peripheral clock enable, 0x44 */
+}RCC_TypeDef;
+
+/**
+ * General purpose and advanced-control timer register layout.
+ */
+typedef struct
+{
+    volatile uint32_t CR1;      /**< Control register 1, 0x00 */
+    volatile uint32_t CR2;      /**< Control register 2, 0x04 */
+    volatile uint32_t SMCR;     /**< Slave mode control register, 0x08 */
+    volatile uint32_t DIER;     /**< DMA/interrupt enable register, 0x0C */
+    volatile uint32_t SR;       /**< Status register, 0x10 */
+    volatile uint32_t EGR;      /**< Event generation register, 0x14 */
+    volatile uint32_t CCMR1;    /**< Capture/compare mode register 1, 0x18 */
+    volatile uint32_t CCMR2;    /**< Capture/compare mode register 2, 0x1C */
+    volatile uint32_t CCER;     /**< Capture/compare enable register, 0x20 */
+    volatile uint32_t CNT;      /**< Counter, 0x24 */
+    volatile uint32_t PSC;      /**< Prescaler, 0x28 */
+    volatile uint32_t ARR;      /**< Auto-reload register, 0x2C */
+    volatile uint32_t RCR;      /**< Repetition counter register, 0x30 */
+    volatile uint32_t CCR1;     /**< Capture/compare register 1, 0x34 */
+    volatile uint32_t CCR2;     /**< Capture/compare register 2, 0x38 */
+    volatile uint32_t CCR3;     /**< Capture/compare register 3, 0x3C */
+    volatile uint32_t CCR4;     /**< Capture/compare register 4, 0x40 */
+    volatile uint32_t BDTR;     /**< Break and dead-time register, 0x44 */
+    volatile uint32_t DCR;      /**< DMA control register, 0x48 */
+    volatile uint32_t DMAR;     /**< DMA address for burst mode, 0x4C */
+    volatile uint32_t OR;       /**< Option register, 0x50 */
+}TIM_TypeDef;
+
+/**
+ * System configuration controller register layout.
+ */
+typedef struct
+{
+    volatile uint32_t MEMRMP;   /**< Memory remap register, 0x00 */
+    volatile uint32_t PMC;      /**< Peripheral mode configuration, 0x04 */
+    volatile uint32_t EXTICR[4];/**< External interrupt configuration, 0x08 */
+    uint32_t RESERVED[2];       /**< Reserved, 0x18-0x1C */
+    volatile uint32_t CMPCR;    /**< Compensation cell control, 0x20 */
+}SYSCFG_TypeDef;
+
+/**
+ * External interrupt/event controller register layout.
+ */
+typedef struct
+{
+    volatile uint32_t IMR;      /**< Interrupt mask register, 0x00 */
+    volatile uint32_t EMR;      /**< Event mask register, 0x04 */
+    volatile uint32_t RTSR;     /**< Rising trigger selection, 0x08 */
+    volatile uint32_t FTSR;     /**< Falling trigger selection, 0x0C */
+    volatile uint32_t SWIER;    /**< Software interrupt event, 0x10 */
+    volatile uint32_t PR;       /**< Pending register, 0x14 */
+}EXTI_TypeDef;
+
+/**
+ * DMA stream register layout.
+ */
+typedef struct
+{
+    volatile uint32_t CR;       /**< Stream configuration register, 0x00 */
+    volatile uint32_t NDTR;     /**< Number of data register, 0x04 */
+    volatile uint32_t PAR;      /**< Peripheral address register, 0x08 */
+    volatile uint32_t M0AR;     /**< Memory 0 address register, 0x0C */
+    volatile uint32_t M1AR;     /**< Memory 1 address register, 0x10 */
+    volatile uint32_t FCR;      /**< FIFO control register, 0x14 */
+}DMA_Stream_TypeDef;
+
+/**
+ * DMA controller register layout (interrupt status and clear registers).
+ */
+typedef struct
+{
+    volatile uint32_t LISR;     /**< Low interrupt status register, 0x00 */
+    volatile uint32_t HISR;     /**< High interrupt status register, 0x04 */
+    volatile uint32_t LIFCR;    /**< Low interrupt flag clear, 0x08 */
+    volatile uint32_t HIFCR;    /**< High interrupt flag clear, 0x0C */
+}DMA_TypeDef;
+
+/**
+ * Interrupt numbers of the simulated peripherals (STM32F401 vector table).
+ */
+typedef enum
+{
+    EXTI0_IRQn              = 6,
+    EXTI1_IRQn              = 7,
+    EXTI2_IRQn              = 8,
+    EXTI3_IRQn              = 9,
+    EXTI4_IRQn              = 10,
+    DMA1_Stream0_IRQn       = 11,
+    DMA1_Stream1_IRQn       = 12,
+    DMA1_Stream2_IRQn       = 13,
+    DMA1_Stream3_IRQn       = 14,
+    DMA1_Stream4_IRQn       = 15,
+    DMA1_Stream5_IRQn       = 16,
+    DMA1_Stream6_IRQn       = 17,
+    EXTI9_5_IRQn            = 23,
+    TIM1_UP_TIM10_IRQn      = 25,
+    TIM1_CC_IRQn            = 27,
+    TIM2_IRQn               = 28,
+    TIM3_IRQn               = 29,
+    TIM4_IRQn               = 30,
+    SPI1_IRQn               = 35,
+    SPI2_IRQn               = 36,
+    EXTI15_10_IRQn          = 40,
+    DMA1_Stream7_IRQn       = 47,
+    TIM5_IRQn               = 50,
+    SPI3_IRQn               = 51,
+    DMA2_Stream0_IRQn       = 56,
+    DMA2_Stream1_IRQn       = 57,
+    DMA2_Stream2_IRQn       = 58,
+    DMA2_Stream3_IRQn       = 59,
+    DMA2_Stream4_IRQn       = 60,
+    DMA2_Stream5_IRQn       = 68,
+    DMA2_Stream6_IRQn       = 69,
+    DMA2_Stream7_IRQn       = 70,
+    SPI4_IRQn               = 84
+}IRQn_Type;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+/** The simulated peripheral address space (PERIPH_BASE onwards) */
+extern uint32_t SimPeripheralMemory[SIM_PERIPH_SIZE / sizeof(uint32_t)];
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/** Translate a physical peripheral address into the simulated memory */
+#define SIM_PERIPHERAL(address)     \
+    ((uint8_t *)SimPeripheralMemory + ((address) - PERIPH_BASE))
+
+#define SPI1                ((SPI_TypeDef *) SIM_PERIPHERAL(SPI1_BASE))
+#define SPI2                ((SPI_TypeDef *) SIM_PERIPHERAL(SPI2_BASE))
+#define SPI3                ((SPI_TypeDef *) SIM_PERIPHERAL(SPI3_BASE))
+#define SPI4                ((SPI_TypeDef *) SIM_PERIPHERAL(SPI4_BASE))
+#define GPIOA               ((GPIO_TypeDef *) SIM_PERIPHERAL(GPIOA_BASE))
+#define GPIOB               ((GPIO_TypeDef *) SIM_PERIPHERAL(GPIOB_BASE))
+#define GPIOC               ((GPIO_TypeDef *) SIM_PERIPHERAL(GPIOC_BASE))
+#define GPIOD               ((GPIO_TypeDef *) SIM_PERIPHERAL(GPIOD_BASE))
+#define GPIOE               ((GPIO_TypeDef *) SIM_PERIPHERAL(GPIOE_BASE))
+#define GPIOH               ((GPIO_TypeDef *) SIM_PERIPHERAL(GPIOH_BASE))
+#define RCC                 ((RCC_TypeDef *) SIM_PERIPHERAL(RCC_BASE))
+#define SYSCFG              ((SYSCFG_TypeDef *) SIM_PERIPHERAL(SYSCFG_BASE))
+#define EXTI                ((EXTI_TypeDef *) SIM_PERIPHERAL(EXTI_BASE))
+#define TIM1                ((TIM_TypeDef *) SIM_PERIPHERAL(TIM1_BASE))
+#define TIM2                ((TIM_TypeDef *) SIM_PERIPHERAL(TIM2_BASE))
+#define TIM3                ((TIM_TypeDef *) SIM_PERIPHERAL(TIM3_BASE))
+#define TIM4                ((TIM_TypeDef *) SIM_PERIPHERAL(TIM4_BASE))
+#define TIM5                ((TIM_TypeDef *) SIM_PERIPHERAL(TIM5_BASE))
+#define DMA1                ((DMA_TypeDef *) SIM_PERIPHERAL(DMA1_BASE))
+#define DMA2                ((DMA_TypeDef *) SIM_PERIPHERAL(DMA2_BASE))
+#define SIM_DMA_STREAM(dma, n)      \
+    ((DMA_Stream_TypeDef *) SIM_PERIPHERAL((dma) + 0x10UL + (0x18UL * (n))))
+#define DMA1_Stream0        SIM_DMA_STREAM(DMA1_BASE, 0)
+#define DMA1_Stream1        SIM_DMA_STREAM(DMA1_BASE, 1)
+#define DMA1_Stream2        SIM_DMA_STREAM(DMA1_BASE, 2)
+#define DMA1_Stream3        SIM_DMA_STREAM(DMA1_BASE, 3)
+#define DMA1_Stream4        SIM_DMA_STREAM(DMA1_BASE, 4)
+#define DMA1_Stream5        SIM_DMA_STREAM(DMA1_BASE, 5)
+#define DMA1_Stream6        SIM_DMA_STREAM(DMA1_BASE, 6)
+#define DMA1_Stream7        SIM_DMA_STREAM(DMA1_BASE, 7)
+#define DMA2_Stream0        SIM_DMA_STREAM(DMA2_BASE, 0)
+#define DMA2_Stream1        SIM_DMA_STREAM(DMA2_BASE, 1)
+#define DMA2_Stream2        SIM_DMA_STREAM(DMA2_BASE, 2)
+#define DMA2_Stream3        SIM_DMA_STREAM(DMA2_BASE, 3)
+#define DMA2_Stream4        SIM_DMA_STREAM(DMA2_BASE, 4)
+#define DMA2_Stream5        SIM_DMA_STREAM(DMA2_BASE, 5)
+#define DMA2_Stream6        SIM_DMA_STREAM(DMA2_BASE, 6)
+#define DMA2_Stream7        SIM_DMA_STREAM(DMA2_BASE, 7)
+
+/* Core functions of the CMSIS (cmsis_gcc.h), run by the simulation */
+#define __enable_irq()      SIM_irqEnable()
+#define __disable_irq()     SIM_irqDisable()
+#define __WFI()             SIM_wfi()
+#define __get_PRIMASK()     SIM_primaskGet()
+#define __set_PRIMASK(mask) (((mask) & 1U) ? SIM_irqDisable() :          \
+                                             SIM_irqEnable())
+#define __DMB()             ((void)0)
+#define __DSB()             ((void)0)
+#define __ISB()             ((void)0)
+
+/* RCC bit definitions (subset of the CMSIS device header) */
+#define RCC_AHB1ENR_GPIOAEN         (1UL << 0)
+#define RCC_AHB1ENR_GPIOBEN         (1UL << 1)
+#define RCC_AHB1ENR_GPIOCEN         (1UL << 2)
+#define RCC_AHB1ENR_GPIODEN         (1UL << 3)
+#define RCC_AHB1ENR_GPIOEEN         (1UL << 4)
+#define RCC_AHB1ENR_GPIOHEN         (1UL << 7)
+#define RCC_APB1ENR_SPI2EN          (1UL << 14)
+#define RCC_APB1ENR_SPI3EN          (1UL << 15)
+#define RCC_APB2ENR_SPI1EN          (1UL << 12)
+#define RCC_APB2ENR_SPI4EN          (1UL << 13)
+
+/* SPI bit definitions (subset of the CMSIS device header) */
+#define SPI_CR1_CPHA                (1UL << 0)
+#define SPI_CR1_CPOL                (1UL << 1)
+#define SPI_CR1_MSTR                (1UL << 2)
+#define SPI_CR1_BR_0                (1UL << 3)
+#define SPI_CR1_BR_1                (1UL << 4)
+#define SPI_CR1_BR_2                (1UL << 5)
+#define SPI_CR1_BR                  (7UL << 3)
+#define SPI_CR1_SPE                 (1UL << 6)
+#define SPI_CR1_LSBFIRST            (1UL << 7)
+#define SPI_CR1_SSI                 (1UL << 8)
+#define SPI_CR1_SSM                 (1UL << 9)
+#define SPI_CR1_RXONLY              (1UL << 10)
+#define SPI_CR1_DFF                 (1UL << 11)
+#define SPI_CR1_CRCNEXT             (1UL << 12)
+#define SPI_CR1_CRCEN               (1UL << 13)
+#define SPI_CR1_BIDIOE              (1UL << 14)
+#define SPI_CR1_BIDIMODE            (1UL << 15)
+#define SPI_CR2_RXDMAEN             (1UL << 0)
+#define SPI_CR2_TXDMAEN             (1UL << 1)
+#define SPI_CR2_SSOE                (1UL << 2)
+#define SPI_CR2_FRF                 (1UL << 4)
+#define SPI_CR2_ERRIE               (1UL << 5)
+#define SPI_CR2_RXNEIE              (1UL << 6)
+#define SPI_CR2_TXEIE               (1UL << 7)
+#define SPI_SR_RXNE                 (1UL << 0)
+#define SPI_SR_TXE                  (1UL << 1)
+#define SPI_SR_CHSIDE               (1UL << 2)
+#define SPI_SR_UDR                  (1UL << 3)
+#define SPI_SR_CRCERR               (1UL << 4)
+#define SPI_SR_MODF                 (1UL << 5)
+#define SPI_SR_OVR                  (1UL << 6)
+#define SPI_SR_BSY                  (1UL << 7)
+#define SPI_SR_FRE                  (1UL << 8)
+
+/* RCC bit definitions for the DMA controllers and the timers */
+#define RCC_AHB1ENR_DMA1EN          (1UL << 21)
+#define RCC_AHB1ENR_DMA2EN          (1UL << 22)
+#define RCC_APB1ENR_TIM2EN          (1UL << 0)
+#define RCC_APB1ENR_TIM3EN          (1UL << 1)
+#define RCC_APB1ENR_TIM4EN          (1UL << 2)
+#define RCC_APB1ENR_TIM5EN          (1UL << 3)
+#define RCC_APB2ENR_TIM1EN          (1UL << 0)
+
+/* RCC bit definition of the system configuration controller */
+#define RCC_APB2ENR_SYSCFGEN        (1UL << 14)
+
+/* TIM bit definitions (subset of the CMSIS device header) */
+#define TIM_CR1_CEN                 (1UL << 0)
+#define TIM_CR1_UDIS                (1UL << 1)
+#define TIM_CR1_URS                 (1UL << 2)
+#define TIM_CR1_ARPE                (1UL << 7)
+#define TIM_DIER_UIE                (1UL << 0)
+#define TIM_DIER_CC1IE              (1UL << 1)
+#define TIM_DIER_CC2IE              (1UL << 2)
+#define TIM_DIER_CC3IE              (1UL << 3)
+#define TIM_DIER_CC4IE              (1UL << 4)
+#define TIM_DIER_UDE                (1UL << 8)
+#define TIM_DIER_CC1DE              (1UL << 9)
+#define TIM_DIER_CC2DE              (1UL << 10)
+#define TIM_DIER_CC3DE              (1UL << 11)
+#define TIM_DIER_CC4DE              (1UL << 12)
+#define TIM_SR_UIF                  (1UL << 0)
+#define TIM_SR_CC1IF                (1UL << 1)
+#define TIM_SR_CC2IF                (1UL << 2)
+#define TIM_SR_CC3IF                (1UL << 3)
+#define TIM_SR_CC4IF                (1UL << 4)
+#define TIM_EGR_UG                  (1UL << 0)
+#define TIM_CCMR1_CC1S              (3UL << 0)
+#define TIM_CCMR1_CC2S              (3UL << 8)
+#define TIM_CCMR2_CC3S              (3UL << 0)
+#define TIM_CCMR2_CC4S              (3UL << 8)
+
+/* DMA bit definitions (subset of the CMSIS device header) */
+#define DMA_SxCR_EN                 (1UL << 0)
+#define DMA_SxCR_DMEIE              (1UL << 1)
+#define DMA_SxCR_TEIE               (1UL << 2)
+#define DMA_SxCR_HTIE               (1UL << 3)
+#define DMA_SxCR_TCIE               (1UL << 4)
+#define DMA_SxCR_PFCTRL             (1UL << 5)
+#define DMA_SxCR_DIR_0              (1UL << 6)
+#define DMA_SxCR_DIR_1              (1UL << 7)
+#define DMA_SxCR_DIR                (3UL << 6)
+#define DMA_SxCR_CIRC               (1UL << 8)
+#define DMA_SxCR_PINC               (1UL << 9)
+#define DMA_SxCR_MINC               (1UL << 10)
+#define DMA_SxCR_PSIZE_0            (1UL << 11)
+#define DMA_SxCR_PSIZE_1            (1UL << 12)
+#define DMA_SxCR_PSIZE              (3UL << 11)
+#define DMA_SxCR_MSIZE_0            (1UL << 13)
+#define DMA_SxCR_MSIZE_1            (1UL << 14)
+#define DMA_SxCR_MSIZE              (3UL << 13)
+#define DMA_SxCR_PL_0               (1UL << 16)
+#define DMA_SxCR_PL_1               (1UL << 17)
+#define DMA_SxCR_PL                 (3UL << 16)
+#define DMA_SxCR_DBM                (1UL << 18)
+#define DMA_SxCR_CT                 (1UL << 19)
+#define DMA_SxCR_CHSEL_Pos          (25U)
+#define DMA_SxCR_CHSEL              (7UL << 25)
+#define DMA_LISR_FEIF0              (1UL << 0)
+#define DMA_LISR_DMEIF0             (1UL << 2)
+#define DMA_LISR_TEIF0              (1UL << 3)
+#define DMA_LISR_HTIF0              (1UL << 4)
+#define DMA_LISR_TCIF0              (1UL << 5)
+#define DMA_LISR_FEIF1              (1UL << 6)
+#define DMA_LISR_DMEIF1             (1UL << 8)
+#define DMA_LISR_TEIF1              (1UL << 9)
+#define DMA_LISR_HTIF1              (1UL << 10)
+#define DMA_LISR_TCIF1              (1UL << 11)
+#define DMA_LISR_FEIF2              (1UL << 16)
+#define DMA_LISR_DMEIF2             (1UL << 18)
+#define DMA_LISR_TEIF2              (1UL << 19)
+#define DMA_LISR_HTIF2              (1UL << 20)
+#define DMA_LISR_TCIF2              (1UL << 21)
+#define DMA_LISR_FEIF3              (1UL << 22)
+#define DMA_LISR_DMEIF3             (1UL << 24)
+#define DMA_LISR_TEIF3              (1UL << 25)
+#define DMA_LISR_HTIF3              (1UL << 26)
+#define DMA_LISR_TCIF3              (1UL << 27)
+#define DMA_LIFCR_CFEIF0            (1UL << 0)
+#define DMA_LIFCR_CDMEIF0           (1UL << 2)
+#define DMA_LIFCR_CTEIF0            (1UL << 3)
+#define DMA_LIFCR_CHTIF0            (1UL << 4)
+#define DMA_LIFCR_CTCIF0            (1UL << 5)
+#define DMA_LIFCR_CFEIF1            (1UL << 6)
+#define DMA_LIFCR_CDMEIF1           (1UL << 8)
+#define DMA_LIFCR_CTEIF1            (1UL << 9)
+#define DMA_LIFCR_CHTIF1            (1UL << 10)
+#define DMA_LIFCR_CTCIF1            (1UL << 11)
+#define DMA_LIFCR_CFEIF2            (1UL << 16)
+#define DMA_LIFCR_CDMEIF2           (1UL << 18)
+#define DMA_LIFCR_CTEIF2            (1UL << 19)
+#define DMA_LIFCR_CHTIF2            (1UL << 20)
+#define DMA_LIFCR_CTCIF2            (1UL << 21)
+#define DMA_LIFCR_CFEIF3            (1UL << 22)
+#define DMA_LIFCR_CDMEIF3           (1UL << 24)
+#define DMA_LIFCR_CTEIF3            (1UL << 25)
+#define DMA_LIFCR_CHTIF3            (1UL << 26)
+#define DMA_LIFCR_CTCIF3            (1UL << 27)
+#define DMA_HISR_FEIF4              (1UL << 0)
+#define DMA_HISR_DMEIF4             (1UL << 2)
+#define DMA_HISR_TEIF4              (1UL << 3)
+#define DMA_HISR_HTIF4              (1UL << 4)
+#define DMA_HISR_TCIF4              (1UL << 5)
+#define DMA_HISR_FEIF5              (1UL << 6)
+#define DMA_HISR_DMEIF5             (1UL << 8)
+#define DMA_HISR_TEIF5              (1UL << 9)
+#define DMA_HISR_HTIF5              (1UL << 10)
+#define DMA_HISR_TCIF5              (1UL << 11)
+#define DMA_HISR_FEIF6              (1UL << 16)
+#define DMA_HISR_DMEIF6             (1UL << 18)
+#define DMA_HISR_TEIF6              (1UL << 19)
+#define DMA_HISR_HTIF6              (1UL << 20)
+#define DMA_HISR_TCIF6              (1UL << 21)
+#define DMA_HISR_FEIF7              (1UL << 22)
+#define DMA_HISR_DMEIF7             (1UL << 24)
+#define DMA_HISR_TEIF7              (1UL << 25)
+#define DMA_HISR_HTIF7              (1UL << 26)
+#define DMA_HISR_TCIF7              (1UL << 27)
+#define DMA_HIFCR_CFEIF4            (1UL << 0)
+#define DMA_HIFCR_CDMEIF4           (1UL << 2)
+#define DMA_HIFCR_CTEIF4            (1UL << 3)
+#define DMA_HIFCR_CHTIF4            (1UL << 4)
+#define DMA_HIFCR_CTCIF4            (1UL << 5)
+#define DMA_HIFCR_CFEIF5            (1UL << 6)
+#define DMA_HIFCR_CDMEIF5           (1UL << 8)
+#define DMA_HIFCR_CTEIF5            (1UL << 9)
+#define DMA_HIFCR_CHTIF5            (1UL << 10)
+#define DMA_HIFCR_CTCIF5            (1UL << 11)
+#define DMA_HIFCR_CFEIF6            (1UL << 16)
+#define DMA_HIFCR_CDMEIF6           (1UL << 18)
+#define DMA_HIFCR_CTEIF6            (1UL << 19)
+#define DMA_HIFCR_CHTIF6            (1UL << 20)
+#define DMA_HIFCR_CTCIF6            (1UL << 21)
+#define DMA_HIFCR_CFEIF7            (1UL << 22)
+#define DMA_HIFCR_CDMEIF7           (1UL << 24)
+#define DMA_HIFCR_CTEIF7            (1UL << 25)
+#define DMA_HIFCR_CHTIF7            (1UL << 26)
+#define DMA_HIFCR_CTCIF7            (1UL << 27)
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void SIM_reset(void);
+uint32_t SIM_read32(volatile uint32_t * const reg);
+void SIM_write32(volatile uint32_t * const reg, uint32_t value);
+uint16_t SIM_read16(volatile uint16_t * const reg);
+void SIM_write16(volatile uint16_t * const reg, uint16_t value);
+volatile void * SIM_address(uint32_t address);
+void SIM_gpioInputSet(const GPIO_TypeDef * const Port, uint16_t value);
+void SIM_spiMisoSet(const SPI_TypeDef * const Spi, uint16_t value);
+uint64_t SIM_cyclesGet(void);
+uint32_t SIM_accessesGet(void);
+void SIM_idle(uint32_t cycles);
+uint32_t SIM_dmaAddress(const volatile void * const pointer);
+void SIM_irqEnable(void);
+void SIM_irqDisable(void);
+uint32_t SIM_primaskGet(void);
+void SIM_wfi(void);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*STM32F4XX_SIM_H_*/
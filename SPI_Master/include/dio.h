@@ -21,11 +21,13 @@
 //#define NDEBUG          /*To disable assert function*/  
 #include <assert.h>
 #include "dio_cfg.h"    /*For dio configuration*/
-#include "stm32f4xx.h"  /*Microcontroller family header*/  
+#include "reg_backend.h" /*Register access (target or host simulation)*/
 
 /*****************************************************************************
 * Preprocessor Constants
 *****************************************************************************/
+/** Defines the maximum number of pins of a group (bits of the value) */
+#define DIO_GROUP_MAX_PINS  32U
 
 /*****************************************************************************
 * Configuration Constants
@@ -44,6 +46,43 @@ typedef struct
     DioPin_t Pin;               /**< The I/O pin */
 }DioPinConfig_t;
 
+/**
+ * Defines the handle of a pin for the fast path functions. It is built once
+ * by DIO_pinHandleGet and caches the registers of the port and the mask of
+ * the pin.
+ */
+typedef struct
+{
+    uint32_t volatile *Idr;     /**< Input data register of the port */
+    uint32_t volatile *Odr;     /**< Output data register of the port */
+    uint32_t volatile *Bsrr;    /**< Bit set/reset register of the port */
+    uint32_t Mask;              /**< Mask of the pin (low half of BSRR) */
+}DioPinHandle_t;
+
+/**
+ * Defines a group of pins that can span several ports. It is built once by
+ * DIO_groupInit: the pin i of the group is the bit i of the value written
+ * or read, and the pins are gathered into a mask per port so a group write
+ * is one BSRR store per port and a group read one IDR load per port.
+ */
+typedef struct
+{
+    uint16_t Mask[NUMBER_OF_PORTS];     /**< Pins of the group on each port */
+    uint8_t Port[DIO_GROUP_MAX_PINS];   /**< Port of the pin i */
+    uint8_t Pin[DIO_GROUP_MAX_PINS];    /**< Pin i on its port */
+    uint8_t Size;                       /**< Number of pins of the group */
+}DioPinGroup_t;
+
+/**
+ * Defines a batch of deferred pin writes. It is a small object (one BSRR 
+ * word per port) meant to live on the stack between DIO_batchBegin and 
+ * DIO_batchCommit.
+ */
+typedef struct
+{
+    uint32_t Bsrr[NUMBER_OF_PORTS];     /**< Set (low) and reset (high) bits */
+}DioBatch_t;
+
 /*****************************************************************************
 * Variables
 *****************************************************************************/
@@ -56,9 +95,25 @@ extern "C"{
 #endif
 
 void DIO_init(const DioConfig_t * const Config, size_t configSize);
+void DIO_initImage(const DioPortImage_t * const Image);
+void DIO_pinConfigure(const DioConfig_t * const Config);
 DioPinState_t DIO_pinRead(const DioPinConfig_t * const PinConfig);
 void DIO_pinWrite(const DioPinConfig_t * const PinConfig, DioPinState_t State);
 void DIO_pinToggle(const DioPinConfig_t * const PinConfig);
+DioPinHandle_t DIO_pinHandleGet(const DioPinConfig_t * const PinConfig);
+void DIO_portWrite(DioPort_t Port, uint16_t mask, uint16_t value);
+uint16_t DIO_portRead(DioPort_t Port);
+void DIO_portModeWrite(DioPort_t Port, uint16_t mask, DioMode_t Mode);
+void DIO_groupInit(DioPinGroup_t * const Group, 
+                   const DioPinConfig_t * const Pins, size_t size);
+void DIO_groupWrite(const DioPinGroup_t * const Group, uint32_t value);
+uint32_t DIO_groupRead(const DioPinGroup_t * const Group);
+void DIO_batchBegin(DioBatch_t * const Batch);
+void DIO_batchSet(DioBatch_t * const Batch, 
+                  const DioPinConfig_t * const PinConfig);
+void DIO_batchClear(DioBatch_t * const Batch, 
+                    const DioPinConfig_t * const PinConfig);
+void DIO_batchCommit(const DioBatch_t * const Batch);
 void DIO_registerWrite(uint32_t address, uint32_t value);
 uint32_t DIO_registerRead(uint32_t address);
 
@@ -66,4 +121,47 @@ uint32_t DIO_registerRead(uint32_t address);
 } // extern C
 #endif
 
+/*****************************************************************************
+* Inline Function Definitions
+*****************************************************************************/
+/**
+ * Set the pin of a handle with a single store on BSRR. 
+ * PRE-CONDITION: The handle is built by DIO_pinHandleGet. <br>
+ */
+static inline void DIO_pinSet(const DioPinHandle_t * const Handle)
+{
+    REG_WRITE32(Handle->Bsrr, Handle->Mask);
+}
+
+/**
+ * Clear the pin of a handle with a single store on BSRR (reset half).
+ * PRE-CONDITION: The handle is built by DIO_pinHandleGet. <br>
+ */
+static inline void DIO_pinClear(const DioPinHandle_t * const Handle)
+{
+    REG_WRITE32(Handle->Bsrr, Handle->Mask << 16U);
+}
+
+/**
+ * Read the pin of a handle with a single IDR load.
+ * PRE-CONDITION: The handle is built by DIO_pinHandleGet. <br>
+ */
+static inline DioPinState_t DIO_pinReadFast(const DioPinHandle_t * const Handle)
+{
+    return (REG_READ32(Handle->Idr) & Handle->Mask) ? DIO_HIGH : DIO_LOW;
+}
+
+/**
+ * Toggle the pin of a handle: one load of ODR and one store on BSRR, the
+ * other pins of the port are not written back.
+ * PRE-CONDITION: The handle is built by DIO_pinHandleGet. <br>
+ */
+static inline void DIO_pinToggleFast(const DioPinHandle_t * const Handle)
+{
+    const uint32_t odr = REG_READ32(Handle->Odr);
+
+    REG_WRITE32(Handle->Bsrr, ((odr & Handle->Mask) << 16U) |
+                              (~odr & Handle->Mask));
+}
+
 #endif /*DIO_H_*/
\ No newline at end of file
@@ -17,11 +17,14 @@
 * Includes
 *****************************************************************************/
 #include <stdint.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdbool.h>
 //#define NDEBUG          /*To disable assert function*/  
 #include <assert.h>
 #include "spi_cfg.h"
-#include "stm32f4xx.h"   
+#include "reg_backend.h" /*Register access (target or host simulation)*/
+#include "dio.h"        /*For the chip select of the devices*/
 
 /*****************************************************************************
 * Preprocessor Constants
@@ -38,13 +41,95 @@
 /*****************************************************************************
 * Typedefs
 *****************************************************************************/
+/**
+ * Defines the status of a polled transfer. SPI_CRC_ERROR is returned on a
+ * channel set to SPI_CRC_ENABLED when the CRC received does not match the
+ * one computed on the frames received.
+ */
+typedef enum
+{
+    SPI_OK,                         /**< The transfer is done */
+    SPI_CRC_ERROR,                  /**< The CRC received does not match */
+    SPI_MAX_STATUS                  /**< Defines the maximum status */
+}SpiStatus_t;
+
+/**
+ * Defines the transfers of 16 bits items: one item per frame, an 8 bits
+ * frame is the low byte of its item. The data to be sent may be a const
+ * table in flash.
+ */
 typedef struct
 {
     SpiChannel_t Channel;           /**< The SPI channel */
-    uint16_t size;                  /**< The size of the data */
-    uint16_t *data;                 /**< The data to be sent */
+    size_t size;                    /**< The size of the data, in frames */
+    const uint16_t *data;           /**< The data to be sent */
 }SpiTransferConfig_t;
 
+typedef struct
+{
+    SpiChannel_t Channel;           /**< The SPI channel */
+    size_t size;                    /**< The size of the data, in frames */
+    uint16_t *data;                 /**< The data received */
+}SpiReceiveConfig_t;
+
+/**
+ * Defines the transfers of bytes, for the channels set to SPI_8BITS: one
+ * byte per frame, so the payload is not widened to 16 bits items.
+ */
+typedef struct
+{
+    SpiChannel_t Channel;           /**< The SPI channel */
+    size_t size;                    /**< The size of the data, in frames */
+    const uint8_t *data;            /**< The data to be sent */
+}SpiTransfer8Config_t;
+
+typedef struct
+{
+    SpiChannel_t Channel;           /**< The SPI channel */
+    size_t size;                    /**< The size of the data, in frames */
+    uint8_t *data;                  /**< The data received */
+}SpiReceive8Config_t;
+
+/**
+ * Defines a full-duplex exchange: the frame i of txData is sent while the
+ * frame i of rxData is received. A NULL txData sends zeros, a NULL rxData
+ * drops the frames received. Both may point to the same buffer.
+ */
+typedef struct
+{
+    SpiChannel_t Channel;           /**< The SPI channel */
+    size_t size;                    /**< The size of the data, in frames */
+    const uint16_t *txData;         /**< The data to be sent, or NULL */
+    uint16_t *rxData;               /**< The data received, or NULL */
+}SpiExchangeConfig_t;
+
+typedef struct
+{
+    SpiChannel_t Channel;           /**< The SPI channel */
+    size_t size;                    /**< The size of the data, in frames */
+    const uint8_t *txData;          /**< The data to be sent, or NULL */
+    uint8_t *rxData;                /**< The data received, or NULL */
+}SpiExchange8Config_t;
+
+/**
+ * Defines a slave on a channel shared by several devices: its chip select
+ * (active low) and the settings of its bus. SPI_deviceInit resolves them
+ * once into a pin handle and CR1 bits, SPI_deviceSelect applies them to
+ * the channel set up by SPI_init, the other settings of the channel 
+ * (hierarchy, NSS and transfer type) are kept.
+ */
+typedef struct
+{
+    SpiChannel_t Channel;           /**< The SPI channel */
+    DioPinConfig_t Cs;              /**< Chip select, active low */
+    SpiMode_t Mode;                 /**< Mode 0,1,2, and 3 */
+    SpiBaudRate_t BaudRate;         /**< FPCLK2 - Max FPCLK */
+    SpiFrameFormat_t FrameFormat;   /**< MSB and LSB */
+    SpiDataSize_t DataSize;         /**< 8 bits and 16 bits*/
+    DioPinHandle_t CsHandle;        /**< Chip select, set by SPI_deviceInit */
+    uint16_t cr1Bits;               /**< CR1 settings, set by SPI_deviceInit */
+}SpiDevice_t;
+
 /*****************************************************************************
 * Variables
 *****************************************************************************/
@@ -57,8 +142,21 @@ extern "C"{
 #endif
 
 void SPI_init(const SpiConfig_t * const Config, size_t configSize);
-void SPI_transfer(const SpiTransferConfig_t * const TransferConfig);
-void SPI_receive(const SpiTransferConfig_t * const TransferConfig);
+SpiStatus_t SPI_transfer(const SpiTransferConfig_t * const TransferConfig);
+SpiStatus_t SPI_receive(const SpiReceiveConfig_t * const ReceiveConfig);
+SpiStatus_t SPI_transferReceive(
+                    const SpiExchangeConfig_t * const ExchangeConfig);
+SpiStatus_t SPI_transfer8(const SpiTransfer8Config_t * const TransferConfig);
+SpiStatus_t SPI_receive8(const SpiReceive8Config_t * const ReceiveConfig);
+SpiStatus_t SPI_transferReceive8(
+                    const SpiExchange8Config_t * const ExchangeConfig);
+void SPI_transactionBegin(SpiChannel_t Channel);
+void SPI_transactionEnd(SpiChannel_t Channel);
+void SPI_deviceInit(SpiDevice_t * const Device);
+void SPI_deviceSelect(const SpiDevice_t * const Device);
+void SPI_deviceDeselect(const SpiDevice_t * const Device);
+void SPI_settingsRestore(SpiChannel_t Channel);
+void SPI_crcReset(SpiChannel_t Channel);
 void SPI_registerWrite(uint32_t address, uint32_t value);
 uint16_t SPI_registerRead(uint32_t address);
 
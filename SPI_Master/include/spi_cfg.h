@@ -17,6 +17,7 @@
 * Includes
 *****************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
 
 /****************************************************************************
 * Preprocessor Constants
@@ -127,6 +128,18 @@ typedef enum
     SPI_MAX_BITS    /**< Maximum number of bits*/
 }SpiDataSize_t;
 
+/**
+ * Define the hardware CRC of the channel. When enabled, the CRC of the 
+ * frames sent is appended to each transfer and the CRC received after the
+ * last frame is checked (CRCERR).
+ */
+typedef enum
+{
+    SPI_CRC_DISABLED,   /**< No CRC frame*/
+    SPI_CRC_ENABLED,    /**< CRC frame appended and checked*/
+    SPI_MAX_CRC         /**< Maximum CRC setting*/
+}SpiCrc_t;
+
 /**
  * Defines the Serial Peripheral Interface configuration table's 
  * elements that are used by Spi_Init to configure the SPI peripheral.
@@ -141,6 +154,8 @@ typedef struct
     SpiFrameFormat_t FrameFormat;   /**< MSB and LSB */
     SpiTypeTransfer_t TypeTransfer; /**< Full duplex and Receive mode*/
     SpiDataSize_t DataSize;         /**< 8 bits and 16 bits*/
+    SpiCrc_t Crc;                   /**< Hardware CRC disabled or enabled*/
+    uint16_t crcPolynomial;         /**< CRC polynomial (CRCPR), if enabled*/
 }SpiConfig_t;
 
 
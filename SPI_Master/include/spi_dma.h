@@ -0,0 +1,69 @@
+/**
+ * @file spi_dma.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the SPI DMA transfers. This is the
+ * header file for the definition of non-blocking SPI_transfer and
+ * SPI_receive: the frames are moved by the DMA streams of the channel and
+ * the call returns at once, the completion is reported by a callback or a
+ * pollable status.
+ * @version 1.0
+ * @date 2025-04-14
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef SPI_DMA_H_
+#define SPI_DMA_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "spi.h"        /*For the SPI settings and transfer configuration*/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the status of the DMA transfers of a channel.
+ */
+typedef enum
+{
+    SPI_DMA_IDLE,       /**< No transfer, the last one completed */
+    SPI_DMA_BUSY,       /**< A transfer is running */
+    SPI_DMA_ERROR,      /**< The last transfer stopped on a DMA error */
+    SPI_DMA_CRC_ERROR,  /**< The CRC received by the last one mismatched */
+    SPI_DMA_MAX_STATUS  /**< Maximum status */
+}SpiDmaStatus_t;
+
+/**
+ * Defines the callback of the completion of a transfer. It runs in the
+ * interrupt of the receive stream, the channel is already idle (a new
+ * transfer can be started from it).
+ */
+typedef void (*SpiDmaCallback_t)(SpiChannel_t Channel, SpiDmaStatus_t Status);
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void SPI_dmaInit(const SpiConfig_t * const Config, size_t configSize);
+void SPI_dmaCallbackRegister(SpiChannel_t Channel, SpiDmaCallback_t Callback);
+void SPI_transferDma(const SpiTransferConfig_t * const TransferConfig);
+void SPI_receiveDma(const SpiReceiveConfig_t * const ReceiveConfig);
+void SPI_transferDma8(const SpiTransfer8Config_t * const TransferConfig);
+void SPI_receiveDma8(const SpiReceive8Config_t * const ReceiveConfig);
+void SPI_transferReceiveDma(const SpiExchangeConfig_t * const ExchangeConfig);
+void SPI_transferReceiveDma8(const SpiExchange8Config_t * const ExchangeConfig);
+SpiDmaStatus_t SPI_dmaStatusGet(SpiChannel_t Channel);
+void SPI_dmaWait(SpiChannel_t Channel);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*SPI_DMA_H_*/
@@ -0,0 +1,64 @@
+/**
+ * @file spi_it.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the SPI interrupt transfers. This is
+ * the header file for the definition of an interrupt driven exchange: each
+ * channel keeps its own context, served by its SPI interrupt, so SPI1-SPI4
+ * run at the same time while the main loop does other work.
+ * @version 1.0
+ * @date 2025-04-15
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef SPI_IT_H_
+#define SPI_IT_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "spi.h"        /*For the SPI settings and exchange configuration*/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the status of the interrupt exchanges of a channel.
+ */
+typedef enum
+{
+    SPI_IT_IDLE,        /**< No exchange, the last one completed */
+    SPI_IT_BUSY,        /**< An exchange is running */
+    SPI_IT_ERROR,       /**< The last exchange stopped on OVR */
+    SPI_IT_MODE_FAULT,  /**< It stopped on MODF, the master is restored */
+    SPI_IT_MAX_STATUS   /**< Maximum status */
+}SpiItStatus_t;
+
+/**
+ * Defines the callback of the completion of an exchange. It runs in the
+ * SPI interrupt, the channel is already idle (a new exchange can be
+ * started from it).
+ */
+typedef void (*SpiItCallback_t)(SpiChannel_t Channel, SpiItStatus_t Status);
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void SPI_itInit(const SpiConfig_t * const Config, size_t configSize);
+void SPI_itCallbackRegister(SpiChannel_t Channel, SpiItCallback_t Callback);
+void SPI_transferReceiveIt(const SpiExchangeConfig_t * const ExchangeConfig);
+void SPI_transferReceiveIt8(const SpiExchange8Config_t * const ExchangeConfig);
+SpiItStatus_t SPI_itStatusGet(SpiChannel_t Channel);
+void SPI_itWait(SpiChannel_t Channel);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*SPI_IT_H_*/
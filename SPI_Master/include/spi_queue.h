@@ -0,0 +1,73 @@
+/**
+ * @file spi_queue.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the SPI transaction queue. This is
+ * the header file for the definition of a queue of transactions per
+ * channel: each transaction selects its slave (chip select), exchanges its
+ * frames by DMA and releases the slave, and the next one starts from the
+ * interrupt of the previous one, back to back.
+ * @version 1.0
+ * @date 2025-04-17
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef SPI_QUEUE_H_
+#define SPI_QUEUE_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "spi.h"        /*For the SPI settings*/
+#include "spi_dma.h"    /*For the status of the transfers*/
+#include "dio.h"        /*For the chip select pins*/
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+/**
+ * Defines the transactions held by the queue of a channel, a power of 2.
+ */
+#ifndef SPI_QUEUE_DEPTH
+#define SPI_QUEUE_DEPTH     8U
+#endif
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines a transaction of the queue: the chip select is low during the
+ * exchange of its frames. The frames are 16 bits items, or bytes on the
+ * channels set to SPI_8BITS. A NULL txData sends zeros, a NULL rxData
+ * drops the frames received.
+ */
+typedef struct
+{
+    DioPinConfig_t Cs;              /**< Chip select, active low */
+    size_t size;                    /**< The size of the data, in frames */
+    const void *txData;             /**< The data to be sent, or NULL */
+    void *rxData;                   /**< The data received, or NULL */
+}SpiQueueTransaction_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void SPI_queueInit(const SpiConfig_t * const Config, size_t configSize);
+bool SPI_queuePush(SpiChannel_t Channel,
+                   const SpiQueueTransaction_t * const Transaction);
+size_t SPI_queueCountGet(SpiChannel_t Channel);
+SpiDmaStatus_t SPI_queueStatusGet(SpiChannel_t Channel);
+void SPI_queueWait(SpiChannel_t Channel);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*SPI_QUEUE_H_*/
@@ -0,0 +1,60 @@
+/**
+ * @file spi_soft.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the software SPI. This is the header
+ * file for the definition of a bit-banged SPI master on DIO pins, for the
+ * buses that do not fit in SPI_CHANNEL1..4. The frame loop is specialized
+ * at compile time for each mode, bit order and data size.
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef SPI_SOFT_H_
+#define SPI_SOFT_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "spi.h"        /*For the SPI settings and transfer configuration*/
+#include "dio.h"        /*For the DIO driver*/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the configuration table's elements that are used by SPI_softInit
+ * to set up a software SPI master. Mode, FrameFormat and DataSize have the
+ * meaning they have in SpiConfig_t. Channel names the software bus in the
+ * transfers; it is not related to the SPI peripheral of the same number.
+ */
+typedef struct
+{
+    SpiChannel_t Channel;           /**< The software SPI channel */
+    SpiMode_t Mode;                 /**< Mode 0,1,2, and 3 */
+    SpiFrameFormat_t FrameFormat;   /**< MSB and LSB */
+    SpiDataSize_t DataSize;         /**< 8 bits and 16 bits */
+    DioPinConfig_t Sck;             /**< SCK pin, output */
+    DioPinConfig_t Mosi;            /**< MOSI pin, output on the SCK port */
+    DioPinConfig_t Miso;            /**< MISO pin, input */
+}SpiSoftConfig_t;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void SPI_softInit(const SpiSoftConfig_t * const Config, size_t configSize);
+void SPI_softTransfer(const SpiTransferConfig_t * const TransferConfig);
+void SPI_softReceive(const SpiReceiveConfig_t * const ReceiveConfig);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*SPI_SOFT_H_*/
@@ -24,40 +24,49 @@
 /*****************************************************************************
 * Module Typedefs
 *****************************************************************************/
-
-/*****************************************************************************
-* Module Variable Definitions
-*****************************************************************************/
-/* Defines a array of pointers to the GPIO port mode register */
-static uint32_t volatile * const moderRegister[NUMBER_OF_PORTS] =
+/**
+ * Defines the settings of DioConfig_t, each one is a field per pin.
+ */
+typedef enum
 {
-    (uint32_t*)&GPIOA->MODER, (uint32_t*)&GPIOB->MODER, 
-    (uint32_t*)&GPIOC->MODER, (uint32_t*)&GPIOD->MODER,
-    (uint32_t*)&GPIOH->MODER
-};
+    DIO_FIELD_MODE,     /**< Mode (MODER) */
+    DIO_FIELD_TYPE,     /**< Output type (OTYPER) */
+    DIO_FIELD_SPEED,    /**< Output speed (OSPEEDR) */
+    DIO_FIELD_RESISTOR, /**< Pull-up/pull-down (PUPDR) */
+    DIO_FIELD_FUNCTION, /**< Alternate function (AFRL/AFRH) */
+    DIO_MAX_FIELD       /**< Defines the maximum field value */
+}DioField_t;
 
-/* Defines a array of pointers to the GPIO port output type register. */
-static uint32_t volatile * const otyperRegister[NUMBER_OF_PORTS] =
+/**
+ * Defines the encoding of a setting in the configuration registers.
+ */
+typedef struct
 {
-    (uint32_t*)&GPIOA->OTYPER, (uint32_t*)&GPIOB->OTYPER,
-    (uint32_t*)&GPIOC->OTYPER, (uint32_t*)&GPIOD->OTYPER, 
-    (uint32_t*)&GPIOH->OTYPER
-};
+    uint8_t Width;              /**< Bits per pin */
+    DioRegister_t Register;     /**< First register of the field */
+}DioFieldEncoding_t;
 
-/* Define a array of pointers to the GPIO port output speed register. */
-static uint32_t volatile * const ospeedrRegister[NUMBER_OF_PORTS] =
-{
-    (uint32_t*)&GPIOA->OSPEEDR, (uint32_t*)&GPIOB->OSPEEDR,
-    (uint32_t*)&GPIOC->OSPEEDR, (uint32_t*)&GPIOD->OSPEEDR, 
-    (uint32_t*)&GPIOH->OSPEEDR
-};
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines a array of pointers to the GPIO port configuration registers, in
+ * the order of DioRegister_t. The alternate function is compound for two 32
+ * bits registers, AFR[0] (AFRL) for the pins 0-7 and AFR[1] (AFRH) for the
+ * pins 8-15.
+*/
+#define DIO_CONFIG_REGISTERS(GPIOx)                                         \
+    {                                                                       \
+        (uint32_t*)&GPIOx->MODER, (uint32_t*)&GPIOx->OTYPER,                \
+        (uint32_t*)&GPIOx->OSPEEDR, (uint32_t*)&GPIOx->PUPDR,               \
+        (uint32_t*)&GPIOx->AFR[0], (uint32_t*)&GPIOx->AFR[1]                \
+    }
 
-/* Defines a array of pointers to the GPIO port pull-up/pull-down register.*/
-static uint32_t volatile * const pupdrRegister[NUMBER_OF_PORTS] =
+static uint32_t volatile * const configRegister[NUMBER_OF_PORTS]
+                                               [DIO_MAX_REGISTER] =
 {
-    (uint32_t*)&GPIOA->PUPDR, (uint32_t*)&GPIOB->PUPDR,
-    (uint32_t*)&GPIOC->PUPDR, (uint32_t*)&GPIOD->PUPDR, 
-    (uint32_t*)&GPIOH->PUPDR
+    DIO_CONFIG_REGISTERS(GPIOA), DIO_CONFIG_REGISTERS(GPIOB),
+    DIO_CONFIG_REGISTERS(GPIOC), DIO_CONFIG_REGISTERS(GPIOD),
+    DIO_CONFIG_REGISTERS(GPIOH)
 };
 
 /* Defines a array of pointers to the GPIO port input data register. */
@@ -74,29 +83,141 @@ static uint32_t volatile * const odrRegister[NUMBER_OF_PORTS] =
     (uint32_t*)&GPIOD->ODR, (uint32_t*)&GPIOH->ODR
 };
 
-/* Defines a array of pointers to the GPIO alternate function low register.
- * This is compound for two 32 bits registers.
+/* Defines a array of pointers to the GPIO port bit set/reset register. The
+ * low half sets the pins and the high half resets them, in a single store
+ * that does not affect the other pins of the port.
 */
-static uint32_t volatile * const afrRegister[NUMBER_OF_PORTS] =
+static uint32_t volatile * const bsrrRegister[NUMBER_OF_PORTS] =
+{
+    (uint32_t*)&GPIOA->BSRR, (uint32_t*)&GPIOB->BSRR, 
+    (uint32_t*)&GPIOC->BSRR, (uint32_t*)&GPIOD->BSRR, 
+    (uint32_t*)&GPIOH->BSRR
+};
+
+/**
+ * The following array contains the encoding of each setting of DioConfig_t,
+ * in the order of DioField_t. Every setting is a field of Width bits per
+ * pin, the pin n lays on bits n*Width of the register sequence starting at
+ * Register (AFRL, AFRH for the alternate function).
+ */
+static const DioFieldEncoding_t FieldEncoding[DIO_MAX_FIELD] =
 {
-    (uint32_t*)&GPIOA->AFR[0], (uint32_t*)&GPIOB->AFR[0], 
-    (uint32_t*)&GPIOC->AFR[0], (uint32_t*)&GPIOD->AFR[0], 
-    (uint32_t*)&GPIOH->AFR[0]
+/*   Width  Register */
+    {2U,    DIO_MODER},
+    {1U,    DIO_OTYPER},
+    {2U,    DIO_OSPEEDR},
+    {2U,    DIO_PUPDR},
+    {4U,    DIO_AFRL}
 };
 
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
+static DioRegister_t DIO_fieldEncode(DioField_t field, uint32_t pin,
+                                     uint32_t setting,
+                                     DioRegisterImage_t * const Field);
+static void DIO_imageFieldSet(DioRegisterImage_t * const Image, 
+                              uint32_t fieldMask, uint32_t fieldValue);
+static void DIO_imageCommit(uint32_t volatile * const reg, 
+                            const DioRegisterImage_t * const Image);
 
 /*****************************************************************************
 * Function Definitions
 *****************************************************************************/
+/*****************************************************************************
+ * Function: DIO_fieldEncode()
+*//**
+*\b Description:
+ * This function is used to encode a setting of a pin into its register,
+ * mask and value. The encoding is computed from the width of the field 
+ * with no branch: the bit position pin*width selects the register (AFRL or
+ * AFRH for the 4 bits fields) and the shift inside it.
+ * 
+ * @param[in]   field is the setting to encode.
+ * @param[in]   pin is the pin of the port (0-15).
+ * @param[in]   setting is the value of the setting (register encoding).
+ * @param[out]  Field is the mask and the shifted value of the field.
+ * 
+ * @return  The register of the field.
+ * 
+*****************************************************************************/
+static DioRegister_t DIO_fieldEncode(DioField_t field, uint32_t pin,
+                                     uint32_t setting,
+                                     DioRegisterImage_t * const Field)
+{
+    const uint32_t width = FieldEncoding[field].Width;
+    const uint32_t bit = pin * width;
+    const uint32_t shift = bit % 32U;
+
+    Field->Mask = ((1UL << width) - 1UL) << shift;
+    Field->Value = setting << shift;
+
+    return (DioRegister_t)(FieldEncoding[field].Register + (bit / 32U));
+}
+
+/*****************************************************************************
+ * Function: DIO_imageFieldSet()
+*//**
+*\b Description:
+ * This function is used to set a field (the bits of one pin) on a register
+ * image. A field set before for the same pin is overwritten.
+ * 
+ * @param[in]   Image is the register image to update.
+ * @param[in]   fieldMask is the mask of the field in the register.
+ * @param[in]   fieldValue is the value of the field, already shifted.
+ * 
+ * @return  void
+ * 
+*****************************************************************************/
+static void DIO_imageFieldSet(DioRegisterImage_t * const Image, 
+                              uint32_t fieldMask, uint32_t fieldValue)
+{
+    Image->Mask |= fieldMask;
+    Image->Value = (Image->Value & ~fieldMask) | fieldValue;
+}
+
+/*****************************************************************************
+ * Function: DIO_imageCommit()
+*//**
+*\b Description:
+ * This function is used to write a register image to its register with a 
+ * single store. The register is read first only when the image does not 
+ * own all its bits, and it is not accessed when the image is empty.
+ * 
+ * @param[in]   reg is a pointer to the configuration register.
+ * @param[in]   Image is the register image to write.
+ * 
+ * @return  void
+ * 
+*****************************************************************************/
+static void DIO_imageCommit(uint32_t volatile * const reg, 
+                            const DioRegisterImage_t * const Image)
+{
+    if(Image->Mask == 0xFFFFFFFFUL)
+    {
+        REG_WRITE32(reg, Image->Value);
+    }
+    else if(Image->Mask != 0UL)
+    {
+        REG_WRITE32(reg, (REG_READ32(reg) & ~Image->Mask) | Image->Value);
+    }
+    else
+    {
+        /* The port is not in the configuration table */
+    }
+}
+
 /*****************************************************************************
  * Function: DIO_init()
 *//**
 *\b Description:
  * This function is used to initialize the DIO based on the configuration  
- * table defined in dio_cfg module.
+ * table defined in dio_cfg module. The whole table is first gathered into
+ * an image (mask and value) of the MODER, OTYPER, OSPEEDR, PUPDR, AFRL and
+ * AFRH registers of each port, then each register is committed with a
+ * single read-modify-write (or a single write when the table owns all its
+ * bits). Ports absent from the table are not accessed. When a pin appears
+ * more than once, the last entry wins.
  * 
  * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
  * PRE-CONDITION: Configuration table needs to be populated (sizeof > 0) <br>
@@ -123,17 +244,24 @@ static uint32_t volatile * const afrRegister[NUMBER_OF_PORTS] =
  * @see DIO_configGet
  * @see DIO_configSizeGet
  * @see DIO_init
+ * @see DIO_initImage
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinHandleGet
+ * @see DIO_portWrite
+ * @see DIO_portRead
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
 *****************************************************************************/
 void DIO_init(const DioConfig_t * const Config, size_t configSize)
 {
+    /* Image of the configuration registers of every port */
+    DioPortImage_t Image[NUMBER_OF_PORTS] = {0};
+
     /* Loop through all the elements of the configuration table. */
-    for(uint8_t i=0; i<configSize; i++)
+    for(size_t i=0; i<configSize; i++)
     {
         /* Prevent to assign a value out of the range of the port and pin.
          * The registers arrays are limited to the NUMBER_OF_PORTS, higher 
@@ -141,233 +269,138 @@ void DIO_init(const DioConfig_t * const Config, size_t configSize)
         */
         assert(Config[i].Port < DIO_MAX_PORT);
         assert(Config[i].Pin < DIO_MAX_PIN);
+        assert(Config[i].Mode < DIO_MAX_MODE);
+        assert(Config[i].Type < DIO_MAX_TYPE);
+        assert(Config[i].Speed < DIO_MAX_SPEED);
+        assert(Config[i].Resistor < DIO_MAX_RESISTOR);
+        assert(Config[i].Function < DIO_MAX_FUNCTION);
 
-        /* 
-         * Set the mode of the Dio pin on the GPIO port mode register. 
-         * Multiply the pin number (Config[i].Pin) by two as MODER uses two 
-         * bits to configure one pin.
-        */
-        if(Config[i].Mode == DIO_INPUT)
+        /* The enumerations follow the register encoding */
+        const uint32_t setting[DIO_MAX_FIELD] =
         {
-            *moderRegister[Config[i].Port] &=~ (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] &=~ (2UL<<(Config[i].Pin*2));
+            Config[i].Mode, Config[i].Type, Config[i].Speed,
+            Config[i].Resistor, Config[i].Function
+        };
 
-        }
-        else if (Config[i].Mode == DIO_OUTPUT)
-        {
-            *moderRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] &=~ (2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Mode == DIO_FUNCTION)
-        {
-            *moderRegister[Config[i].Port] &=~ (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Mode == DIO_ANALOG)
-        {
-            *moderRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else
+        for(uint8_t field=0; field<DIO_MAX_FIELD; field++)
         {
-            assert(Config[i].Mode < DIO_MAX_MODE);
-        }
+            DioRegisterImage_t Field;
+            const DioRegister_t reg = DIO_fieldEncode((DioField_t)field,
+                                          Config[i].Pin, setting[field],
+                                          &Field);
 
-        /*
-         * Set the output type of the Dio pin on the GPIO port output type 
-         * register.
-         */
-        if(Config[i].Type == DIO_PUSH_PULL)
-        {
-            *otyperRegister[Config[i].Port] &= ~(1UL<<Config[i].Pin);
-        }
-        else if (Config[i].Type == DIO_OPEN_DRAIN)
-        {
-            *otyperRegister[Config[i].Port] |= (1UL<<Config[i].Pin);
-        }
-        else
-        {
-            assert(Config[i].Type < DIO_MAX_TYPE);
+            DIO_imageFieldSet(&Image[Config[i].Port].Register[reg],
+                              Field.Mask, Field.Value);
         }
+    }
 
-        /*
-         * Set the speed of the Dio pin on the GPIO port output speed 
-         * register. Multiply the pin number (Config[i].Pin) by two as 
-         * OSPEEDR uses two bits to configure one pin. 
-         */
-        if(Config[i].Speed == DIO_LOW_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Speed == DIO_MEDIUM_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Speed == DIO_HIGH_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else if(Config[i].Speed == DIO_VERY_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else
+    /* Commit every register once, only on the ports used by the table */
+    DIO_initImage(Image);
+}
+
+/*****************************************************************************
+ * Function: DIO_initImage()
+*//**
+*\b Description:
+ * This function is used to initialize the DIO from the image of the 
+ * configuration registers folded at compile time by the dio_cfg module.
+ * The registers used by the table are written whole, with no read, so the
+ * initialization is a fixed list of stores (six per port at most). The 
+ * fields not set by the table take their reset value.
+ * 
+ * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+ * PRE-CONDITION: The image holds NUMBER_OF_PORTS ports. <br>
+ * PRE-CONDITION: The pins not set by the table are at their reset 
+ * configuration (boot time). <br>
+ * 
+ * POST-CONDITION: The DIO peripheral is set up with the configuration 
+ * settings.
+ * 
+ * @param[in]   Image is a pointer to the image of the configuration 
+ *               registers of each port.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DIO_initImage(DIO_configImageGet());
+ * @endcode
+ * 
+ * @see DIO_configImageGet
+ * @see DIO_init
+ * @see DIO_initImage
+ * 
+*****************************************************************************/
+void DIO_initImage(const DioPortImage_t * const Image)
+{
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        for(uint8_t reg=0; reg<DIO_MAX_REGISTER; reg++)
         {
-            assert(Config[i].Speed < DIO_MAX_SPEED);
+            DIO_imageCommit(configRegister[port][reg],
+                            &Image[port].Register[reg]);
         }
+    }
+}
 
-        /*
-         * Set the internal resistor of the Dio pin on the GPIO port 
-         * pull-up/pull-down register. Multiply the pin number 
-         * (Config[i].Pin) by two as PUPDR uses two bits to configure 
-         * one pin. 
-        */
-       if(Config[i].Resistor == DIO_NO_RESISTOR)
-       {
-            *pupdrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *pupdrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-       }
-       else if (Config[i].Resistor == DIO_PULLUP)
-       {
-            *pupdrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *pupdrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-       }
-       else if (Config[i].Resistor == DIO_PULLDOWN)
-       {
-            *pupdrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *pupdrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-       }
-       else
-       {
-            assert(Config[i].Resistor < DIO_MAX_RESISTOR);
-       }
-
-        /*
-         * Set the alternate function of the Dio pin on the GPIO alternate 
-         * function. Multiply the pin number (Config[i].Pin) by four as AFR 
-         * uses four bits to configure one pin. 
-        */
-       if(Config[i].Function == DIO_AF0)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF1)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF2)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF3)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF4)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF5)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF6)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF7)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF8)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF9)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF10)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF11)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF12)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF13)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF14)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF15)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else
-       {
-            assert(Config[i].Function < DIO_MAX_FUNCTION);
-       }
+/*****************************************************************************
+ * Function: DIO_pinConfigure()
+*//**
+*\b Description:
+ * This function is used to configure a single pin at run time, for 
+ * example to hand a pin over to a peripheral. Each setting is encoded by
+ * the field encoder and written with one masked store (read-modify-write)
+ * on its register, the other pins of the port are not modified.
+ * 
+ * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+ * PRE-CONDITION: The setting is within the maximum values (DIO_MAX). <br>
+ * 
+ * POST-CONDITION: The pin is set up with the configuration settings.
+ * 
+ * @param[in]   Config is a pointer to the configuration of the pin.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * const DioConfig_t Sck = {DIO_PA, DIO_PA5, DIO_FUNCTION, DIO_PUSH_PULL,
+ *                          DIO_HIGH_SPEED, DIO_NO_RESISTOR, DIO_AF5,
+ *                          DIO_NO_TRIGGER};
+ * 
+ * DIO_pinConfigure(&Sck);
+ * @endcode
+ * 
+ * @see DIO_init
+ * @see DIO_initImage
+ * @see DIO_pinConfigure
+ * 
+*****************************************************************************/
+void DIO_pinConfigure(const DioConfig_t * const Config)
+{
+    assert(Config->Port < DIO_MAX_PORT);
+    assert(Config->Pin < DIO_MAX_PIN);
+    assert(Config->Mode < DIO_MAX_MODE);
+    assert(Config->Type < DIO_MAX_TYPE);
+    assert(Config->Speed < DIO_MAX_SPEED);
+    assert(Config->Resistor < DIO_MAX_RESISTOR);
+    assert(Config->Function < DIO_MAX_FUNCTION);
 
+    /* The enumerations follow the register encoding */
+    const uint32_t setting[DIO_MAX_FIELD] =
+    {
+        Config->Mode, Config->Type, Config->Speed, Config->Resistor,
+        Config->Function
+    };
+
+    for(uint8_t field=0; field<DIO_MAX_FIELD; field++)
+    {
+        DioRegisterImage_t Field;
+        const DioRegister_t reg = DIO_fieldEncode((DioField_t)field,
+                                      Config->Pin, setting[field], &Field);
+        uint32_t volatile * const Register = configRegister[Config->Port][reg];
+
+        REG_WRITE32(Register, (REG_READ32(Register) & ~Field.Mask) |
+                               Field.Value);
     }
 }
 
@@ -406,9 +439,13 @@ void DIO_init(const DioConfig_t * const Config, size_t configSize)
  * @see DIO_ConfigGet
  * @see DIO_configSizeGet
  * @see DIO_init
+ * @see DIO_initImage
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinHandleGet
+ * @see DIO_portWrite
+ * @see DIO_portRead
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
@@ -423,7 +460,7 @@ DioPinState_t DIO_pinRead(const DioPinConfig_t * const PinConfig)
     assert(PinConfig->Pin < DIO_MAX_PIN);
 
     /* Read the port associated with the desired pin */
-    uint16_t portState = *idrRegister[PinConfig->Port];
+    uint16_t portState = REG_READ32(idrRegister[PinConfig->Port]);
     /* Determinate the Port bit associated with this pin*/
     uint16_t pinMask = (1UL<<(PinConfig->Pin));
 
@@ -475,9 +512,13 @@ DioPinState_t DIO_pinRead(const DioPinConfig_t * const PinConfig)
  * @see DIO_ConfigGet
  * @see DIO_configSizeGet
  * @see DIO_init
+ * @see DIO_initImage
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinHandleGet
+ * @see DIO_portWrite
+ * @see DIO_portRead
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
@@ -491,13 +532,15 @@ void DIO_pinWrite(const DioPinConfig_t * const PinConfig, DioPinState_t State)
     assert(PinConfig->Port < DIO_MAX_PORT);
     assert(PinConfig->Pin < DIO_MAX_PIN);
 
+    /* BSRR sets (low half) or resets (high half) the pin atomically */
     if(State == DIO_HIGH)
     {
-        *odrRegister[PinConfig->Port] |= (1UL<<(PinConfig->Pin));
+        REG_WRITE32(bsrrRegister[PinConfig->Port], (1UL<<(PinConfig->Pin)));
     }
     else if (State == DIO_LOW)
     {
-        *odrRegister[PinConfig->Port] &= ~(1UL<<(PinConfig->Pin));
+        REG_WRITE32(bsrrRegister[PinConfig->Port], 
+                    (1UL<<(PinConfig->Pin + 16U)));
     }
     else
     {
@@ -540,9 +583,13 @@ void DIO_pinWrite(const DioPinConfig_t * const PinConfig, DioPinState_t State)
  * @see DIO_ConfigGet
  * @see DIO_configSizeGet
  * @see DIO_init
+ * @see DIO_initImage
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinHandleGet
+ * @see DIO_portWrite
+ * @see DIO_portRead
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
@@ -556,7 +603,491 @@ void DIO_pinToggle(const DioPinConfig_t * const PinConfig)
     assert(PinConfig->Port < DIO_MAX_PORT);
     assert(PinConfig->Pin < DIO_MAX_PIN);
 
-    *odrRegister[PinConfig->Port] ^= (1UL<<(PinConfig->Pin));
+    const uint32_t mask = 1UL<<(PinConfig->Pin);
+    const uint32_t odr = REG_READ32(odrRegister[PinConfig->Port]);
+
+    /* Reset the pin if it is high, set it if it is low, through BSRR so
+     * the other pins of the port are not written back.
+    */
+    REG_WRITE32(bsrrRegister[PinConfig->Port], 
+                ((odr & mask) << 16U) | (~odr & mask));
+}
+
+/**********************************************************************
+ * Function: DIO_pinHandleGet()
+*//**
+ *\b Description:
+ * This function is used to build the handle of a pin for the fast path 
+ * functions (DIO_pinSet, DIO_pinClear and DIO_pinToggleFast). The handle
+ * caches the IDR, ODR and BSRR addresses of the port and the mask of the pin,
+ * so the range checks and table lookups are paid once.
+ * 
+ * PRE-CONDITION: DioPinConfig_t needs to be populated (sizeof > 0) <br>
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ * PRE-CONDITION: The Pin is within the maximum DioPin_t. <br>
+ *
+ * POST-CONDITION: The handle of the pin is returned. <br>
+ * 
+ * @param[in]   pinConfig A pointer to a structure containing the port 
+ *              and pin of the handle.
+ * 
+ * @return  The handle of the pin.
+ * 
+ * \b Example:
+ * @code
+ * const DioPinConfig_t  UserLED1= 
+ * {
+ *      .Port = DIO_PA, 
+ *      .Pin = DIO_PA5
+ * };
+ * const DioPinHandle_t Led = DIO_pinHandleGet(&UserLED1);
+ * 
+ * DIO_pinSet(&Led);
+ * DIO_pinToggleFast(&Led);
+ * @endcode
+ * 
+ * @see DIO_pinHandleGet
+ * @see DIO_pinSet
+ * @see DIO_pinClear
+ * @see DIO_pinToggleFast
+ * @see DIO_pinWrite
+ * @see DIO_pinToggle
+ * 
+ **********************************************************************/
+DioPinHandle_t DIO_pinHandleGet(const DioPinConfig_t * const PinConfig)
+{
+    assert(PinConfig->Port < DIO_MAX_PORT);
+    assert(PinConfig->Pin < DIO_MAX_PIN);
+
+    const DioPinHandle_t Handle =
+    {
+        .Idr = idrRegister[PinConfig->Port],
+        .Odr = odrRegister[PinConfig->Port],
+        .Bsrr = bsrrRegister[PinConfig->Port],
+        .Mask = 1UL<<(PinConfig->Pin)
+    };
+
+    return Handle;
+}
+
+/**********************************************************************
+ * Function: DIO_portWrite()
+*//**
+ *\b Description:
+ * This function is used to write several pins of a port at once. The pins
+ * of mask take the level of the same bits of value, with a single BSRR 
+ * store: they change on the same cycle and the other pins of the port 
+ * are not affected.
+ * 
+ * PRE-CONDITION: The pins of mask are configured as OUTPUT <br>
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ *
+ * POST-CONDITION: The pins of mask are set to value. <br>
+ * 
+ * @param[in]   Port is the port to write.
+ * @param[in]   mask is the pins to write (bit n is the pin n).
+ * @param[in]   value is the level of the pins (bit n is the pin n).
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DIO_portWrite(DIO_PA, 0x00FF, 0x0056);  //Drive PA0-PA7 with 0x56
+ * @endcode
+ * 
+ * @see DIO_portWrite
+ * @see DIO_portRead
+ * @see DIO_groupWrite
+ * @see DIO_groupRead
+ * 
+ **********************************************************************/
+void DIO_portWrite(DioPort_t Port, uint16_t mask, uint16_t value)
+{
+    assert(Port < DIO_MAX_PORT);
+
+    const uint32_t set = (uint32_t)(mask & value);
+    const uint32_t reset = (uint32_t)(mask & (uint16_t)~value);
+
+    REG_WRITE32(bsrrRegister[Port], (reset << 16U) | set);
+}
+
+/**********************************************************************
+ * Function: DIO_portRead()
+*//**
+ *\b Description:
+ * This function is used to read all the pins of a port with a single IDR
+ * load.
+ * 
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ *
+ * POST-CONDITION: The state of the pins is returned. <br>
+ * 
+ * @param[in]   Port is the port to read.
+ * 
+ * @return  The state of the pins of the port (bit n is the pin n).
+ * 
+ * \b Example:
+ * @code
+ * uint16_t bus = DIO_portRead(DIO_PC) & 0x00FF;    //Read PC0-PC7
+ * @endcode
+ * 
+ * @see DIO_portWrite
+ * @see DIO_portRead
+ * @see DIO_groupWrite
+ * @see DIO_groupRead
+ * 
+ **********************************************************************/
+uint16_t DIO_portRead(DioPort_t Port)
+{
+    assert(Port < DIO_MAX_PORT);
+
+    return (uint16_t)REG_READ32(idrRegister[Port]);
+}
+
+/**********************************************************************
+ * Function: DIO_portModeWrite()
+*//**
+ *\b Description:
+ * This function is used to change the mode of several pins of a port with
+ * a single read-modify-write of MODER, for example to turn a data bus 
+ * around between output and input.
+ * 
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ * PRE-CONDITION: The Mode is within the maximum DioMode_t. <br>
+ *
+ * POST-CONDITION: The pins of mask are in Mode. <br>
+ * 
+ * @param[in]   Port is the port to configure.
+ * @param[in]   mask is the pins to configure (bit n is the pin n).
+ * @param[in]   Mode is the new mode of the pins.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DIO_portModeWrite(DIO_PA, 0x00FF, DIO_INPUT);    //PA0-PA7 as inputs
+ * @endcode
+ * 
+ * @see DIO_portWrite
+ * @see DIO_portRead
+ * @see DIO_portModeWrite
+ * 
+ **********************************************************************/
+void DIO_portModeWrite(DioPort_t Port, uint16_t mask, DioMode_t Mode)
+{
+    assert(Port < DIO_MAX_PORT);
+    assert(Mode < DIO_MAX_MODE);
+
+    uint32_t fieldMask = 0;
+    uint32_t fieldValue = 0;
+
+    /* Spread the pins into the two bits fields of MODER */
+    for(uint32_t pin=0; pin<DIO_MAX_PIN; pin++)
+    {
+        const uint32_t selected = ((uint32_t)mask >> pin) & 1UL;
+
+        fieldMask |= (selected * 3UL) << (pin * 2U);
+        fieldValue |= (selected * (uint32_t)Mode) << (pin * 2U);
+    }
+
+    uint32_t volatile * const Register = configRegister[Port][DIO_MODER];
+
+    REG_WRITE32(Register, (REG_READ32(Register) & ~fieldMask) | fieldValue);
+}
+
+/**********************************************************************
+ * Function: DIO_groupInit()
+*//**
+ *\b Description:
+ * This function is used to build a group of pins. The pin Pins[i] is the
+ * bit i of the group value, the pins can be on any port and in any order.
+ * The mask of the group on each port is precomputed here, so the group
+ * functions only touch the ports involved.
+ * 
+ * PRE-CONDITION: size <= DIO_GROUP_MAX_PINS <br>
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ * PRE-CONDITION: The Pin is within the maximum DioPin_t. <br>
+ *
+ * POST-CONDITION: The group is ready for DIO_groupWrite/DIO_groupRead. <br>
+ * 
+ * @param[out]  Group is the group to build.
+ * @param[in]   Pins is the list of pins, bit 0 first.
+ * @param[in]   size is the number of pins.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * const DioPinConfig_t BusPins[] =
+ * {
+ *      {DIO_PA, DIO_PA0}, {DIO_PA, DIO_PA1}, {DIO_PB, DIO_PB0}, 
+ *      {DIO_PC, DIO_PC5}
+ * };
+ * DioPinGroup_t Bus;
+ * 
+ * DIO_groupInit(&Bus, BusPins, 4);
+ * DIO_groupWrite(&Bus, 0x9);       //PA0 and PC5 high, PA1 and PB0 low
+ * @endcode
+ * 
+ * @see DIO_groupInit
+ * @see DIO_groupWrite
+ * @see DIO_groupRead
+ * 
+ **********************************************************************/
+void DIO_groupInit(DioPinGroup_t * const Group, 
+                   const DioPinConfig_t * const Pins, size_t size)
+{
+    assert(size <= DIO_GROUP_MAX_PINS);
+
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        Group->Mask[port] = 0;
+    }
+
+    for(size_t i=0; i<size; i++)
+    {
+        assert(Pins[i].Port < DIO_MAX_PORT);
+        assert(Pins[i].Pin < DIO_MAX_PIN);
+
+        Group->Port[i] = (uint8_t)Pins[i].Port;
+        Group->Pin[i] = (uint8_t)Pins[i].Pin;
+        Group->Mask[Pins[i].Port] |= (uint16_t)(1UL<<(Pins[i].Pin));
+    }
+
+    Group->Size = (uint8_t)size;
+}
+
+/**********************************************************************
+ * Function: DIO_groupWrite()
+*//**
+ *\b Description:
+ * This function is used to write the pins of a group. The value is first
+ * spread into the set bits of each port, then every port involved takes 
+ * one BSRR store: the pins of the group are set or reset, the other pins
+ * are not affected.
+ * 
+ * PRE-CONDITION: The group is built by DIO_groupInit. <br>
+ * PRE-CONDITION: The pins of the group are configured as OUTPUT <br>
+ *
+ * POST-CONDITION: The pin i of the group takes the bit i of value. <br>
+ * 
+ * @param[in]   Group is the group to write.
+ * @param[in]   value is the level of the pins (bit i is the pin i).
+ * 
+ * @return  void
+ * 
+ * @see DIO_groupInit
+ * @see DIO_groupWrite
+ * @see DIO_groupRead
+ * 
+ **********************************************************************/
+void DIO_groupWrite(const DioPinGroup_t * const Group, uint32_t value)
+{
+    uint32_t set[NUMBER_OF_PORTS] = {0};
+
+    for(uint8_t i=0; i<Group->Size; i++)
+    {
+        set[Group->Port[i]] |= ((value >> i) & 1UL) << Group->Pin[i];
+    }
+
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        if(Group->Mask[port] != 0U)
+        {
+            const uint32_t reset = Group->Mask[port] & ~set[port];
+
+            REG_WRITE32(bsrrRegister[port], (reset << 16U) | set[port]);
+        }
+    }
+}
+
+/**********************************************************************
+ * Function: DIO_groupRead()
+*//**
+ *\b Description:
+ * This function is used to read the pins of a group, with one IDR load 
+ * per port involved.
+ * 
+ * PRE-CONDITION: The group is built by DIO_groupInit. <br>
+ *
+ * POST-CONDITION: The state of the pins is returned. <br>
+ * 
+ * @param[in]   Group is the group to read.
+ * 
+ * @return  The state of the pins (bit i is the pin i).
+ * 
+ * @see DIO_groupInit
+ * @see DIO_groupWrite
+ * @see DIO_groupRead
+ * 
+ **********************************************************************/
+uint32_t DIO_groupRead(const DioPinGroup_t * const Group)
+{
+    uint32_t idr[NUMBER_OF_PORTS] = {0};
+    uint32_t value = 0;
+
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        if(Group->Mask[port] != 0U)
+        {
+            idr[port] = REG_READ32(idrRegister[port]);
+        }
+    }
+
+    for(uint8_t i=0; i<Group->Size; i++)
+    {
+        value |= ((idr[Group->Port[i]] >> Group->Pin[i]) & 1UL) << i;
+    }
+
+    return value;
+}
+
+/**********************************************************************
+ * Function: DIO_batchBegin()
+*//**
+ *\b Description:
+ * This function is used to start a batch of deferred pin writes. The pin
+ * writes are collected by DIO_batchSet and DIO_batchClear without any 
+ * register access, and flushed by DIO_batchCommit.
+ * 
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: The batch is empty. <br>
+ * 
+ * @param[out]  Batch is the batch to start.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DioBatch_t Batch;
+ * 
+ * DIO_batchBegin(&Batch);
+ * DIO_batchSet(&Batch, &UserLED1);
+ * DIO_batchClear(&Batch, &UserLED2);
+ * DIO_batchSet(&Batch, &UserLED3);
+ * DIO_batchCommit(&Batch);
+ * @endcode
+ * 
+ * @see DIO_batchBegin
+ * @see DIO_batchSet
+ * @see DIO_batchClear
+ * @see DIO_batchCommit
+ * 
+ **********************************************************************/
+void DIO_batchBegin(DioBatch_t * const Batch)
+{
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        Batch->Bsrr[port] = 0;
+    }
+}
+
+/**********************************************************************
+ * Function: DIO_batchSet()
+*//**
+ *\b Description:
+ * This function is used to add a pin set (logic high) to a batch. A 
+ * previous clear of the same pin in the batch is dropped.
+ * 
+ * PRE-CONDITION: The batch is started by DIO_batchBegin. <br>
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ * PRE-CONDITION: The Pin is within the maximum DioPin_t. <br>
+ *
+ * POST-CONDITION: The pin is set when the batch is committed. <br>
+ * 
+ * @param[in,out]   Batch is the batch to update.
+ * @param[in]       PinConfig is the pin to set.
+ * 
+ * @return  void
+ * 
+ * @see DIO_batchBegin
+ * @see DIO_batchSet
+ * @see DIO_batchClear
+ * @see DIO_batchCommit
+ * 
+ **********************************************************************/
+void DIO_batchSet(DioBatch_t * const Batch, 
+                  const DioPinConfig_t * const PinConfig)
+{
+    assert(PinConfig->Port < DIO_MAX_PORT);
+    assert(PinConfig->Pin < DIO_MAX_PIN);
+
+    const uint32_t mask = 1UL<<(PinConfig->Pin);
+    uint32_t * const Bsrr = &Batch->Bsrr[PinConfig->Port];
+
+    *Bsrr = (*Bsrr & ~(mask << 16U)) | mask;
+}
+
+/**********************************************************************
+ * Function: DIO_batchClear()
+*//**
+ *\b Description:
+ * This function is used to add a pin clear (logic low) to a batch. A 
+ * previous set of the same pin in the batch is dropped.
+ * 
+ * PRE-CONDITION: The batch is started by DIO_batchBegin. <br>
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ * PRE-CONDITION: The Pin is within the maximum DioPin_t. <br>
+ *
+ * POST-CONDITION: The pin is cleared when the batch is committed. <br>
+ * 
+ * @param[in,out]   Batch is the batch to update.
+ * @param[in]       PinConfig is the pin to clear.
+ * 
+ * @return  void
+ * 
+ * @see DIO_batchBegin
+ * @see DIO_batchSet
+ * @see DIO_batchClear
+ * @see DIO_batchCommit
+ * 
+ **********************************************************************/
+void DIO_batchClear(DioBatch_t * const Batch, 
+                    const DioPinConfig_t * const PinConfig)
+{
+    assert(PinConfig->Port < DIO_MAX_PORT);
+    assert(PinConfig->Pin < DIO_MAX_PIN);
+
+    const uint32_t mask = 1UL<<(PinConfig->Pin);
+    uint32_t * const Bsrr = &Batch->Bsrr[PinConfig->Port];
+
+    *Bsrr = (*Bsrr & ~mask) | (mask << 16U);
+}
+
+/**********************************************************************
+ * Function: DIO_batchCommit()
+*//**
+ *\b Description:
+ * This function is used to flush a batch: one BSRR store per port with 
+ * pending writes, back to back. The pins of a port change on the same 
+ * cycle and the cost is proportional to the number of ports, not pins.
+ * 
+ * PRE-CONDITION: The batch is started by DIO_batchBegin. <br>
+ * PRE-CONDITION: The pins of the batch are configured as OUTPUT <br>
+ *
+ * POST-CONDITION: The pins of the batch take their levels. The batch is
+ * not modified and can be committed again. <br>
+ * 
+ * @param[in]   Batch is the batch to commit.
+ * 
+ * @return  void
+ * 
+ * @see DIO_batchBegin
+ * @see DIO_batchSet
+ * @see DIO_batchClear
+ * @see DIO_batchCommit
+ * 
+ **********************************************************************/
+void DIO_batchCommit(const DioBatch_t * const Batch)
+{
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        if(Batch->Bsrr[port] != 0UL)
+        {
+            REG_WRITE32(bsrrRegister[port], Batch->Bsrr[port]);
+        }
+    }
 }
 
 /**********************************************************************
@@ -588,17 +1119,21 @@ void DIO_pinToggle(const DioPinConfig_t * const PinConfig)
  * @see DIO_ConfigGet
  * @see DIO_configSizeGet
  * @see DIO_init
+ * @see DIO_initImage
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinHandleGet
+ * @see DIO_portWrite
+ * @see DIO_portRead
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
 **********************************************************************/ 
 void DIO_registerWrite(uint32_t address, uint32_t value)
 {
-    volatile uint32_t * const registerPointer = (uint32_t*)address;
-    *registerPointer = value;
+    volatile uint32_t * const registerPointer = REG_ADDRESS32(address);
+    REG_WRITE32(registerPointer, value);
 }
 
 /**********************************************************************
@@ -628,16 +1163,20 @@ void DIO_registerWrite(uint32_t address, uint32_t value)
  * @see DIO_ConfigGet
  * @see DIO_configSizeGet
  * @see DIO_init
+ * @see DIO_initImage
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinHandleGet
+ * @see DIO_portWrite
+ * @see DIO_portRead
  * @see DIO_registerWrite
  * @see DIO_registerRead
  *
  **********************************************************************/ 
 uint32_t DIO_registerRead(uint32_t address)
 {
-    volatile uint32_t * const registerPointer = (uint32_t*)address;
+    volatile uint32_t * const registerPointer = REG_ADDRESS32(address);
 
-    return *registerPointer;
+    return REG_READ32(registerPointer);
 }
\ No newline at end of file
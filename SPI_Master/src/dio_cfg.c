@@ -18,10 +18,137 @@
 /*****************************************************************************
 * Module Preprocessor Constants
 *****************************************************************************/
+/**
+ * The following table contains the configuration data for each digital
+ * input/output peripheral channel (pin). Each row represent a single pin.
+ * Each column is representing a member of the DioConfig_t structure. The 
+ * table is an X-macro: it is expanded into the DioConfig array read in by
+ * DIO_init, and folded at compile time into the DioImage array read in by
+ * DIO_initImage. A port/pin used twice is rejected by the build.
+*/
+/*                                                          
+ *        Port    Pin      Mode        Type           Speed          Resistor         Function Trigger
+ *                
+*/
+#define DIO_CONFIG_TABLE(ENTRY, ARG) \
+   ENTRY(ARG, DIO_PA, DIO_PA4, DIO_OUTPUT,   DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5, DIO_NO_TRIGGER) \
+   ENTRY(ARG, DIO_PA, DIO_PA5, DIO_FUNCTION, DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5, DIO_NO_TRIGGER) \
+   ENTRY(ARG, DIO_PA, DIO_PA6, DIO_FUNCTION, DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5, DIO_NO_TRIGGER) \
+   ENTRY(ARG, DIO_PA, DIO_PA7, DIO_FUNCTION, DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5, DIO_NO_TRIGGER)
 
 /*****************************************************************************
 * Module Preprocessor Macros
 *****************************************************************************/
+/** Expands a row of the table into a DioConfig_t initializer */
+#define DIO_CONFIG_ENTRY(unused, Port, Pin, Mode, Type, Speed, Resistor, \
+                         Function, Trigger)                             \
+    {Port, Pin, Mode, Type, Speed, Resistor, Function, Trigger},
+
+/** Expands a row of the table into its range check */
+#define DIO_CONFIG_RANGE(unused, Port, Pin, Mode, Type, Speed, Resistor, \
+                         Function, Trigger)                             \
+    ((Port) < DIO_MAX_PORT) && ((Pin) < DIO_MAX_PIN) &&                 \
+    ((Mode) < DIO_MAX_MODE) && ((Type) < DIO_MAX_TYPE) &&               \
+    ((Speed) < DIO_MAX_SPEED) && ((Resistor) < DIO_MAX_RESISTOR) &&     \
+    ((Function) < DIO_MAX_FUNCTION) && ((Trigger) < DIO_MAX_TRIGGER) &&
+
+/** Expands a row of the table into its pin bit, only on the given port */
+#define DIO_PIN_BIT(port, Port, Pin)                                    \
+    (((Port) == (port)) ? (1UL << (uint32_t)(Pin)) : 0UL)
+#define DIO_PIN_SUM(port, Port, Pin, Mode, Type, Speed, Resistor,       \
+                    Function, Trigger)                                  \
+    DIO_PIN_BIT(port, Port, Pin) +
+#define DIO_PIN_OR(port, Port, Pin, Mode, Type, Speed, Resistor,        \
+                   Function, Trigger)                                   \
+    DIO_PIN_BIT(port, Port, Pin) |
+
+/**
+ * Returns a setting shifted to the pin position when the row matches the
+ * port (and the AFR half), zero otherwise.
+ */
+#define DIO_FIELD(match, setting, shift)                                \
+    ((match) ? ((uint32_t)(setting) << (shift)) : 0UL)
+
+/**
+ * Expand a row of the table into the mask and the value of its field in
+ * each configuration register. MODER, OSPEEDR and PUPDR use two bits per
+ * pin, OTYPER one bit and AFR four bits, pins 0-7 in AFRL and 8-15 in AFRH.
+ */
+#define DIO_MODER_MASK(port, Port, Pin, Mode, Type, Speed, Resistor,    \
+                       Function, Trigger)                               \
+    DIO_FIELD((Port) == (port), 3U, (uint32_t)(Pin) * 2U) |
+#define DIO_MODER_VALUE(port, Port, Pin, Mode, Type, Speed, Resistor,   \
+                        Function, Trigger)                              \
+    DIO_FIELD((Port) == (port), Mode, (uint32_t)(Pin) * 2U) |
+#define DIO_OTYPER_MASK(port, Port, Pin, Mode, Type, Speed, Resistor,   \
+                        Function, Trigger)                              \
+    DIO_FIELD((Port) == (port), 1U, (uint32_t)(Pin)) |
+#define DIO_OTYPER_VALUE(port, Port, Pin, Mode, Type, Speed, Resistor,  \
+                         Function, Trigger)                             \
+    DIO_FIELD((Port) == (port), Type, (uint32_t)(Pin)) |
+#define DIO_OSPEEDR_MASK(port, Port, Pin, Mode, Type, Speed, Resistor,  \
+                         Function, Trigger)                             \
+    DIO_FIELD((Port) == (port), 3U, (uint32_t)(Pin) * 2U) |
+#define DIO_OSPEEDR_VALUE(port, Port, Pin, Mode, Type, Speed, Resistor, \
+                          Function, Trigger)                            \
+    DIO_FIELD((Port) == (port), Speed, (uint32_t)(Pin) * 2U) |
+#define DIO_PUPDR_MASK(port, Port, Pin, Mode, Type, Speed, Resistor,    \
+                       Function, Trigger)                               \
+    DIO_FIELD((Port) == (port), 3U, (uint32_t)(Pin) * 2U) |
+#define DIO_PUPDR_VALUE(port, Port, Pin, Mode, Type, Speed, Resistor,   \
+                        Function, Trigger)                              \
+    DIO_FIELD((Port) == (port), Resistor, (uint32_t)(Pin) * 2U) |
+#define DIO_AFRL_MASK(port, Port, Pin, Mode, Type, Speed, Resistor,     \
+                      Function, Trigger)                                \
+    DIO_FIELD(((Port) == (port)) && ((Pin) < 8U), 15U,                  \
+              ((uint32_t)(Pin) % 8U) * 4U) |
+#define DIO_AFRL_VALUE(port, Port, Pin, Mode, Type, Speed, Resistor,    \
+                       Function, Trigger)                               \
+    DIO_FIELD(((Port) == (port)) && ((Pin) < 8U), Function,             \
+              ((uint32_t)(Pin) % 8U) * 4U) |
+#define DIO_AFRH_MASK(port, Port, Pin, Mode, Type, Speed, Resistor,     \
+                      Function, Trigger)                                \
+    DIO_FIELD(((Port) == (port)) && ((Pin) >= 8U), 15U,                 \
+              ((uint32_t)(Pin) % 8U) * 4U) |
+#define DIO_AFRH_VALUE(port, Port, Pin, Mode, Type, Speed, Resistor,    \
+                       Function, Trigger)                               \
+    DIO_FIELD(((Port) == (port)) && ((Pin) >= 8U), Function,            \
+              ((uint32_t)(Pin) % 8U) * 4U) |
+
+/**
+ * Folds the table into the image of a register of a port. A register used
+ * by the table is written whole: the fields of the table over the reset
+ * value. A register not used by the table is not written.
+ */
+#define DIO_REGISTER_IMAGE(port, REG, reset)                            \
+    {                                                                   \
+        ((DIO_CONFIG_TABLE(REG##_MASK, port) 0UL) != 0UL) ?             \
+            0xFFFFFFFFUL : 0UL,                                         \
+        ((reset) & ~(DIO_CONFIG_TABLE(REG##_MASK, port) 0UL)) |         \
+            (DIO_CONFIG_TABLE(REG##_VALUE, port) 0UL)                   \
+    }
+
+/** Folds the table into the image of the configuration registers of a port */
+#define DIO_PORT_IMAGE(port)                                            \
+    {                                                                   \
+        {                                                               \
+            DIO_REGISTER_IMAGE(port, DIO_MODER, DIO_RESET_MODER(port)), \
+            DIO_REGISTER_IMAGE(port, DIO_OTYPER, DIO_RESET_OTYPER(port)), \
+            DIO_REGISTER_IMAGE(port, DIO_OSPEEDR, DIO_RESET_OSPEEDR(port)), \
+            DIO_REGISTER_IMAGE(port, DIO_PUPDR, DIO_RESET_PUPDR(port)), \
+            DIO_REGISTER_IMAGE(port, DIO_AFRL, DIO_RESET_AFR(port)),    \
+            DIO_REGISTER_IMAGE(port, DIO_AFRH, DIO_RESET_AFR(port))     \
+        }                                                               \
+    }
+
+/**
+ * Rejects a port/pin used twice: the pin bits of a port only add up to
+ * their union when every pin is unique.
+ */
+#define DIO_PORT_UNIQUE(port)                                           \
+    _Static_assert((DIO_CONFIG_TABLE(DIO_PIN_SUM, port) 0UL) ==         \
+                   (DIO_CONFIG_TABLE(DIO_PIN_OR, port) 0UL),            \
+                   "Duplicate pin of " #port " in the DIO configuration")
 
 /*****************************************************************************
 * Module Typedefs
@@ -31,25 +158,40 @@
 * Module Variable Definitions
 *****************************************************************************/
 /**
- * The following array contains the configuration data for each digital
- * input/output peripheral channel (pin). Each row represent a single pin.
- * Each column is representing a member of the DioConfig_t structure. This 
- * table is read in by Dio_Init, where each channel is then set up based on 
- * this table. The NUMBER_DIGITAL_PINS constant should be accorded with the
- * number of rows.
+ * The following array contains the configuration table expanded into the
+ * DioConfig_t structure. This table is read in by Dio_Init, where each
+ * channel is then set up based on this table.
 */
 const DioConfig_t DioConfig[] = 
 {
-/*                                                          
- *  Port    Pin      Mode        Type           Speed          Resistor         Function
- *                
+   DIO_CONFIG_TABLE(DIO_CONFIG_ENTRY, 0)
+};
+
+/**
+ * The following array contains the configuration table folded into the
+ * final image of the configuration registers of each port. This table is
+ * read in by DIO_initImage, which writes it as is.
 */
-   {DIO_PA, DIO_PA4, DIO_OUTPUT,   DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5},
-   {DIO_PA, DIO_PA5, DIO_FUNCTION, DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5},
-   {DIO_PA, DIO_PA6, DIO_FUNCTION, DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5},
-   {DIO_PA, DIO_PA7, DIO_FUNCTION, DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_NO_RESISTOR, DIO_AF5},
+const DioPortImage_t DioImage[NUMBER_OF_PORTS] =
+{
+   DIO_PORT_IMAGE(DIO_PA),
+   DIO_PORT_IMAGE(DIO_PB),
+   DIO_PORT_IMAGE(DIO_PC),
+   DIO_PORT_IMAGE(DIO_PD),
+   DIO_PORT_IMAGE(DIO_PH),
 };
 
+/* Every setting of the table is within the maximum values (DIO_MAX) */
+_Static_assert(DIO_CONFIG_TABLE(DIO_CONFIG_RANGE, 0) 1,
+               "DIO configuration setting out of range");
+
+/* Every port/pin of the table is unique */
+DIO_PORT_UNIQUE(DIO_PA);
+DIO_PORT_UNIQUE(DIO_PB);
+DIO_PORT_UNIQUE(DIO_PC);
+DIO_PORT_UNIQUE(DIO_PD);
+DIO_PORT_UNIQUE(DIO_PH);
+
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
@@ -68,10 +210,10 @@ const DioConfig_t DioConfig[] =
  * PRE-CONDITION: configuration table needs to be populated (sizeof > 0) <br>
  * 
  * POST-CONDITION: A constant pointer to the first member of the  
- * configuration table will be returned.<br>
+ * configuration table will be returned. <br>
  * 
  * @return A pointer to the configuration table. <br>
- * 
+ *  
  * \b Example: 
  * @code
  * const Dio_Config_t * const DioConfig = DIO_configGet();
@@ -89,6 +231,7 @@ const DioConfig_t DioConfig[] =
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
+ * 
 *****************************************************************************/
 const DioConfig_t * const DIO_configGet(void)
 {
@@ -134,4 +277,36 @@ const DioConfig_t * const DIO_configGet(void)
 size_t DIO_configSizeGet(void)
 {
    return sizeof(DioConfig)/sizeof(DioConfig[0]);
-}
\ No newline at end of file
+}
+
+/*****************************************************************************
+ * Function: DIO_configImageGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the configuration table folded into the
+ * image of the configuration registers of each port.
+ * 
+ * PRE-CONDITION: configuration table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: A constant pointer to the image of the first port will
+ * be returned. <br>
+ * 
+ * @return A pointer to the NUMBER_OF_PORTS port images. <br>
+ *  
+ * \b Example: 
+ * @code
+ * DIO_initImage(DIO_configImageGet());
+ * @endcode
+ * 
+ * @see DIO_configGet
+ * @see DIO_configSizeGet
+ * @see DIO_configImageGet
+ * @see DIO_init
+ * @see DIO_initImage
+ * 
+*****************************************************************************/
+const DioPortImage_t * DIO_configImageGet(void)
+{
+  return (const DioPortImage_t*)&DioImage[0];
+}
@@ -34,12 +34,6 @@ int main(void)
     /* Initialize the DIO pins according to the configuration table*/
     DIO_init(DioConfig, configSizeDio);
 
-    /*Define the pin configuration for PA9 (CS line)*/
-    const DioPinConfig_t CSLine = 
-    {
-        .Port = DIO_PA,
-        .Pin = DIO_PA4 
-    };
     /* Get the address of the configuration table for SPI*/
     const SpiConfig_t * const SpiConfig = SPI_ConfigGet();
     /* Get the size of the configuration table*/
@@ -47,33 +41,38 @@ int main(void)
     /* Initialize the SPI channel according to the configuration table*/
     SPI_init(SpiConfig, configSizeSpi);
 
-    /* Data to be sent*/
+    /* Slave on SPI1, selected by PA4 (CS line)*/
+    SpiDevice_t Slave =
+    {
+        .Channel = SPI_CHANNEL1,
+        .Cs = {DIO_PA, DIO_PA4},
+        .Mode = SPI_MODE3,
+        .BaudRate = SPI_FPCLK4,
+        .FrameFormat = SPI_MSB,
+        .DataSize = SPI_8BITS
+    };
+    SPI_deviceInit(&Slave);
+
+    /* Data to be sent back, replaced by the data received*/
     uint16_t data[1]={};
 
-    /* SPI transfer configuration*/
-    SpiTransferConfig_t TransferConfig =
+    /* SPI exchange configuration, in place on data*/
+    const SpiExchangeConfig_t ExchangeConfig =
     {
         .Channel = SPI_CHANNEL1,
         .size = sizeof(data)/sizeof(data[0]),
-        .data = data
+        .txData = data,
+        .rxData = data
     };
 
     while(1)
     {
         /* Pull cs line low to enable slave*/
-        DIO_pinWrite(&CSLine, DIO_LOW);
-        /* Receive data*/
-        SPI_receive(&TransferConfig);
-        /* Pull cs line high to disable slave*/
-        DIO_pinWrite(&CSLine, DIO_HIGH);
-
-
-        /* Pull cs line low to enable slave*/
-        DIO_pinWrite(&CSLine, DIO_LOW);
-        /* Transmit data*/
-        SPI_transfer(&TransferConfig);
+        SPI_deviceSelect(&Slave);
+        /* Send back the last data while the next one is received*/
+        SPI_transferReceive(&ExchangeConfig);
         /* Pull cs line high to disable slave*/
-        DIO_pinWrite(&CSLine, DIO_HIGH);
+        SPI_deviceDeselect(&Slave);
 
         /*Delay*/
         for(int d=0; d<=500; d++)
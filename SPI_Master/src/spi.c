@@ -16,6 +16,12 @@
 /*****************************************************************************
 * Module Preprocessor Constants
 *****************************************************************************/
+/** Defines the CR1 bits set by a device (SpiDevice_t) */
+#define SPI_DEVICE_CR1_MASK     (SPI_CR1_CPHA | SPI_CR1_CPOL | SPI_CR1_BR | \
+                                 SPI_CR1_LSBFIRST | SPI_CR1_DFF)
+
+/** Defines the CR1 bits written only while SPE is cleared (RM0368: DFF) */
+#define SPI_CR1_STOPPED_MASK    (SPI_CR1_DFF)
 
 /*****************************************************************************
 * Module Preprocessor Macros
@@ -56,19 +62,359 @@ static uint16_t volatile * const dataRegister[SPI_PORTS_NUMBER] =
     (uint16_t*)&SPI4->DR
 };
 
+/** Define a array of pointers to the SPI CRC polynomial register*/
+static uint16_t volatile * const crcPolynomialRegister[SPI_PORTS_NUMBER] =
+{
+    (uint16_t*)&SPI1->CRCPR, (uint16_t*)&SPI2->CRCPR, 
+    (uint16_t*)&SPI3->CRCPR, (uint16_t*)&SPI4->CRCPR
+};
+
+/** Frames on the wire whose reception is not read yet, per channel*/
+static uint8_t rxPending[SPI_PORTS_NUMBER];
+
+/** Open transaction (SPI_transactionBegin) per channel*/
+static bool transaction[SPI_PORTS_NUMBER];
+
+/** CPOL and CPHA bits of each mode*/
+static const uint16_t modeBits[SPI_MAX_MODE] =
+{
+    0U, SPI_CR1_CPHA, SPI_CR1_CPOL, SPI_CR1_CPOL | SPI_CR1_CPHA
+};
+
+/** BR bits of each baud rate*/
+static const uint16_t baudRateBits[SPI_MAX_FPCLK] =
+{
+    0U, SPI_CR1_BR_0, SPI_CR1_BR_1, SPI_CR1_BR_1 | SPI_CR1_BR_0,
+    SPI_CR1_BR_2, SPI_CR1_BR_2 | SPI_CR1_BR_0, SPI_CR1_BR_2 | SPI_CR1_BR_1,
+    SPI_CR1_BR_2 | SPI_CR1_BR_1 | SPI_CR1_BR_0
+};
+
+/** 
+ * Last value written to CR1 per channel, so a device switch is compared
+ * without reading the register. CR2 is not shadowed: a device holds no
+ * CR2 setting, and its DMA and interrupt enables are set and cleared by
+ * their transfers.
+ */
+static uint16_t cr1Shadow[SPI_PORTS_NUMBER];
+
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
+static void SPI_pipeline(SpiChannel_t Channel, const void * const tx, 
+                         void * const rx, size_t size, bool bytes);
+static void SPI_rxDrop(SpiChannel_t Channel, uint8_t left);
+static void SPI_drain(SpiChannel_t Channel);
+static void SPI_flush(SpiChannel_t Channel);
+static SpiStatus_t SPI_crcCheck(SpiChannel_t Channel);
+static SpiStatus_t SPI_run(SpiChannel_t Channel, const void * const tx,
+                           void * const rx, size_t size, bool bytes);
+static uint16_t SPI_cr1Bits(SpiMode_t Mode, SpiBaudRate_t BaudRate,
+                            SpiFrameFormat_t FrameFormat,
+                            SpiDataSize_t DataSize);
+static void SPI_cr1Write(SpiChannel_t Channel, uint16_t cr1);
 
 /*****************************************************************************
 * Function Definitions
 *****************************************************************************/
+/*****************************************************************************
+ * Function: SPI_pipeline()
+*//**
+ *\b Description:
+ * This function is used to move frames on the SPI bus with the transmit 
+ * buffer one frame ahead of the reception, so the bus never idles between
+ * frames. At most two frames are on the wire without being read, so RXNE 
+ * is always read before the next frame completes (no overrun). The frames
+ * still pending from the previous call are received first and dropped.
+ * Without rx, the function returns once the last frame is written. With
+ * the CRC enabled, CRCNEXT is set right after the last frame is written,
+ * so the CRC frame follows it on the wire.
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   tx is the data to be sent, or NULL to send zeros.
+ * @param[out]  rx is the data received, or NULL to drop it.
+ * @param[in]   size is the number of frames.
+ * @param[in]   bytes is true for uint8_t items, false for uint16_t items.
+ * 
+ * @return  void
+ * 
+*****************************************************************************/
+static void SPI_pipeline(SpiChannel_t Channel, const void * const tx, 
+                         void * const rx, size_t size, bool bytes)
+{
+    uint16_t volatile * const status = statusRegister[Channel];
+    uint16_t volatile * const dr = dataRegister[Channel];
+    size_t skip = rxPending[Channel];
+    size_t sent = 0;
+    size_t received = 0;
+
+    while((sent < size) || ((rx != NULL) && (received < size)))
+    {
+        const uint16_t flags = REG_READ16(status);
+
+        if(flags & SPI_SR_RXNE)
+        {
+            const uint16_t frame = REG_READ16(dr);
+
+            if(skip > 0U)
+            {
+                skip--;
+            }
+            else
+            {
+                if(rx == NULL)
+                {
+                    /* The frame is dropped*/
+                }
+                else if(bytes)
+                {
+                    ((uint8_t *)rx)[received] = (uint8_t)frame;
+                }
+                else
+                {
+                    ((uint16_t *)rx)[received] = frame;
+                }
+                received++;
+            }
+        }
+
+        /* Keep the next frame in the transmit buffer*/
+        if((sent < size) && (flags & SPI_SR_TXE) && 
+           ((skip + sent - received) < 2U))
+        {
+            uint16_t frame = 0;
+
+            if(tx != NULL)
+            {
+                frame = bytes ? ((const uint8_t *)tx)[sent] : 
+                                ((const uint16_t *)tx)[sent];
+            }
+            REG_WRITE16(dr, frame);
+            sent++;
+
+            /* The CRC frame follows the last frame*/
+            if((sent == size) && (cr1Shadow[Channel] & SPI_CR1_CRCEN))
+            {
+                REG_WRITE16(controlRegister1[Channel], 
+                            cr1Shadow[Channel] | SPI_CR1_CRCNEXT);
+            }
+        }
+    }
+
+    rxPending[Channel] = (uint8_t)(skip + sent - received);
+}
+
+/*****************************************************************************
+ * Function: SPI_rxDrop()
+*//**
+ *\b Description:
+ * This function is used to receive and drop the frames pending on a 
+ * channel until the given number of them is left unread.
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   left is the number of frames left pending.
+ * 
+ * @return  void
+ * 
+*****************************************************************************/
+static void SPI_rxDrop(SpiChannel_t Channel, uint8_t left)
+{
+    while(rxPending[Channel] > left)
+    {
+        /* Wait for RXNE flag and drop the frame*/
+        while(!(REG_READ16(statusRegister[Channel]) & SPI_SR_RXNE))
+        {
+            asm("nop");
+        }
+        (void)REG_READ16(dataRegister[Channel]);
+        rxPending[Channel]--;
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_drain()
+*//**
+ *\b Description:
+ * This function is used to end the bus activity of a channel: the frames
+ * pending are received and dropped, then the bus is not busy.
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * 
+ * @return  void
+ * 
+*****************************************************************************/
+static void SPI_drain(SpiChannel_t Channel)
+{
+    SPI_rxDrop(Channel, 0);
+
+    /* Wait until bus is not busy to reset*/
+    while(REG_READ16(statusRegister[Channel]) & SPI_SR_BSY)
+    {
+        asm("nop");
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_flush()
+*//**
+ *\b Description:
+ * This function is used to drop a stale frame and a stale overrun, so the
+ * reception starts with the first frame sent.
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * 
+ * @return  void
+ * 
+*****************************************************************************/
+static void SPI_flush(SpiChannel_t Channel)
+{
+    /* Clear OVR bit (Overrun flag): read DR, then SR*/
+    (void)REG_READ16(dataRegister[Channel]);
+    (void)REG_READ16(statusRegister[Channel]);
+    rxPending[Channel] = 0;
+}
+
+/*****************************************************************************
+ * Function: SPI_crcCheck()
+*//**
+ *\b Description:
+ * This function is used to end a message with CRC: the CRC frame sent
+ * after the last frame is received and dropped, then CRCERR tells whether
+ * the CRC received matches the one computed on the frames received.
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * 
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
+ * 
+*****************************************************************************/
+static SpiStatus_t SPI_crcCheck(SpiChannel_t Channel)
+{
+    /* The CRC frame is received after the last frame*/
+    rxPending[Channel]++;
+    SPI_drain(Channel);
+
+    if(REG_READ16(statusRegister[Channel]) & SPI_SR_CRCERR)
+    {
+        /* CRCERR is cleared by writing 0, the other bits are read only*/
+        REG_WRITE16(statusRegister[Channel], (uint16_t)~SPI_SR_CRCERR);
+
+        return SPI_CRC_ERROR;
+    }
+
+    return SPI_OK;
+}
+
+/*****************************************************************************
+ * Function: SPI_run()
+*//**
+ *\b Description:
+ * This function is used to move the frames of a call. Out of a transaction
+ * the call stands alone and drains the bus at the end. In a transaction
+ * the frames follow the previous call back to back, SPI_transactionEnd 
+ * drains the bus. A call in a transaction returns with at most one frame
+ * unread: that frame waits in DR, so the caller may take any time before
+ * the next call (two would overrun DR after one frame time). With the 
+ * CRC enabled, each call is a message of its own, in a transaction too:
+ * the bus is drained, the CRC registers are cleared, and the CRC frame 
+ * ends the message.
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   tx is the data to be sent, or NULL to send zeros.
+ * @param[out]  rx is the data received, or NULL to drop it.
+ * @param[in]   size is the number of frames.
+ * @param[in]   bytes is true for uint8_t items, false for uint16_t items.
+ * 
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
+ * 
+*****************************************************************************/
+static SpiStatus_t SPI_run(SpiChannel_t Channel, const void * const tx,
+                           void * const rx, size_t size, bool bytes)
+{
+    if(cr1Shadow[Channel] & SPI_CR1_CRCEN)
+    {
+        /* The CRC covers the frames of this call only*/
+        SPI_drain(Channel);
+        SPI_crcReset(Channel);
+        SPI_pipeline(Channel, tx, rx, size, bytes);
+
+        return SPI_crcCheck(Channel);
+    }
+
+    SPI_pipeline(Channel, tx, rx, size, bytes);
+
+    if(!transaction[Channel])
+    {
+        SPI_drain(Channel);
+    }
+    else
+    {
+        /* One frame unread waits in DR, a second one would overrun it*/
+        SPI_rxDrop(Channel, 1);
+    }
+
+    return SPI_OK;
+}
+
+/*****************************************************************************
+ * Function: SPI_cr1Bits()
+*//**
+ *\b Description:
+ * This function is used to compose the CR1 bits of the bus settings: 
+ * CPOL, CPHA, BR, LSBFIRST and DFF (SPI_DEVICE_CR1_MASK).
+ * 
+ * @param[in]   Mode is the bus mode.
+ * @param[in]   BaudRate is the baud rate prescaler.
+ * @param[in]   FrameFormat is the bit order.
+ * @param[in]   DataSize is the frame size.
+ * 
+ * @return  The CR1 bits of the settings.
+ * 
+*****************************************************************************/
+static uint16_t SPI_cr1Bits(SpiMode_t Mode, SpiBaudRate_t BaudRate,
+                            SpiFrameFormat_t FrameFormat,
+                            SpiDataSize_t DataSize)
+{
+    return modeBits[Mode] | baudRateBits[BaudRate] |
+           ((FrameFormat == SPI_LSB) ? SPI_CR1_LSBFIRST : 0U) |
+           ((DataSize == SPI_16BITS) ? SPI_CR1_DFF : 0U);
+}
+
+/*****************************************************************************
+ * Function: SPI_cr1Write()
+*//**
+ *\b Description:
+ * This function is used to write new settings in CR1 of an idle channel.
+ * SPE is cleared first only when a bit that requires it changes (DFF), 
+ * otherwise CR1 is written once.
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   cr1 is the value of CR1, SPE included.
+ * 
+ * @return  void
+ * 
+*****************************************************************************/
+static void SPI_cr1Write(SpiChannel_t Channel, uint16_t cr1)
+{
+    const uint16_t changed = cr1 ^ cr1Shadow[Channel];
+
+    if(((changed & SPI_CR1_STOPPED_MASK) != 0U) &&
+       ((cr1Shadow[Channel] & SPI_CR1_SPE) != 0U))
+    {
+        REG_WRITE16(controlRegister1[Channel],
+                    cr1Shadow[Channel] & (uint16_t)~SPI_CR1_SPE);
+    }
+
+    REG_WRITE16(controlRegister1[Channel], cr1);
+    cr1Shadow[Channel] = cr1;
+}
+
 /*****************************************************************************
  * Function: SPI_init()
 *//**
 *\b Description:
  * This function is used to initialize the SPI based on the configuration  
- * table defined in spi_cfg module.
+ * table defined in spi_cfg module. The values of CR1 and CR2 of a channel
+ * are composed from its row and written whole: CR2, then CR1 with SPE 
+ * cleared, then SPE set. The bits not set by the row are cleared.
  * 
  * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
  * PRE-CONDITION: SPI pins should be configured using GPIO driver. <br>
@@ -103,176 +449,64 @@ static uint16_t volatile * const dataRegister[SPI_PORTS_NUMBER] =
 void SPI_init(const SpiConfig_t * const Config, size_t configSize)
 {
     /**Loop through all the elements of the configuration table.*/
-    for(uint8_t i=0; i<configSize; i++)
+    for(size_t i=0; i<configSize; i++)
     {
         /* Prevent to assign a value out of the range of the channels.
          * The registers arrays are limited to the SPI_PORTS_NUMBER, higher 
          * value can cause a memory violation.
         */
-       assert(Config[i].Channel < SPI_MAX_CHANNEL);
+        assert(Config[i].Channel < SPI_MAX_CHANNEL);
+        assert(Config[i].Mode < SPI_MAX_MODE);
+        assert(Config[i].Hierarchy < SPI_MAX_HIERARCHY);
+        assert(Config[i].BaudRate < SPI_MAX_FPCLK);
+        assert(Config[i].SlaveSelect < SPI_MAX_NSS);
+        assert(Config[i].FrameFormat < SPI_MAX_FF);
+        assert(Config[i].TypeTransfer < SPI_MAX_DF);
+        assert(Config[i].DataSize < SPI_MAX_BITS);
+        assert(Config[i].Crc < SPI_MAX_CRC);
 
-        /**Set the configuration of the SPI on the control register 1*/
-        /**Set the Clock phase and polarity modes*/
-        if(Config[i].Mode == SPI_MODE0)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_CPHA;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_CPOL;
-        } 
-        else if(Config[i].Mode == SPI_MODE1)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_CPHA;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_CPOL;
-        }
-        else if(Config[i].Mode == SPI_MODE2)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_CPHA;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_CPOL;
-        }
-        else if(Config[i].Mode == SPI_MODE3)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_CPHA;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_CPOL;
-        }
-        else
-        {
-            assert(Config[i].Mode < SPI_MAX_MODE);
-        }
+        const SpiChannel_t Channel = Config[i].Channel;
 
-        /**Set the hierarchy of the device*/
-        if(Config[i].Hierarchy == SPI_MASTER)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_MSTR;
-        }
-        else if(Config[i].Hierarchy == SPI_SLAVE)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_MSTR;
-        } 
-        else
-        {
-            assert(Config[i].Hierarchy < SPI_MAX_HIERARCHY);
-        }
+        /**Compose the bus settings, the hierarchy and the NSS management*/
+        uint16_t cr1 = SPI_cr1Bits(Config[i].Mode, Config[i].BaudRate,
+                                   Config[i].FrameFormat, Config[i].DataSize);
+        uint16_t cr2 = 0U;
 
-        /**Set the baud rate of the device*/
-        if(Config[i].BaudRate == SPI_FPCLK2)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_2;
-        }
-        else if(Config[i].BaudRate == SPI_FPCLK4)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_2;
-        }
-        else if(Config[i].BaudRate == SPI_FPCLK8)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_2;
-        }
-        else if(Config[i].BaudRate == SPI_FPCLK16)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_2;
-        }
-        else if(Config[i].BaudRate == SPI_FPCLK32)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_2;
-        }
-        else if(Config[i].BaudRate == SPI_FPCLK64)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_2;
-        }
-        else if(Config[i].BaudRate == SPI_FPCLK128)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_2;
-        }
-        else if(Config[i].BaudRate == SPI_FPCLK256)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_0;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_1;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_BR_2;
-        }
-        else
+        if(Config[i].Hierarchy == SPI_MASTER)
         {
-            assert(Config[i].BaudRate < SPI_MAX_FPCLK);
+            cr1 |= SPI_CR1_MSTR;
         }
 
-        /**Set the slave select pin management for the device*/
         if(Config[i].SlaveSelect == SPI_SOFTWARE_NSS)
         {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_SSM;
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_SSI;
+            cr1 |= SPI_CR1_SSM | SPI_CR1_SSI;
         }
         else if(Config[i].SlaveSelect == SPI_HARDWARE_NSS_ENABLED)
         {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_SSM;
-            *controlRegister2[Config[i].Channel] |= SPI_CR2_SSOE;
-        }
-        else if(Config[i].SlaveSelect == SPI_HARDWARE_NSS_DISABLED)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_SSM;
-            *controlRegister2[Config[i].Channel] &=~ SPI_CR2_SSOE;
-        }
-        else
-        {
-            assert(Config[i].SlaveSelect < SPI_MAX_NSS);
+            cr2 |= SPI_CR2_SSOE;
         }
 
-        /**Set the frame format of the device*/
-        if(Config[i].FrameFormat == SPI_MSB)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_LSBFIRST;
-        }
-        else if(Config[i].FrameFormat == SPI_LSB)
-        {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_LSBFIRST;
-        }
-        else
-        {
-            assert(Config[i].FrameFormat < SPI_MAX_FF);
-        }
-
-        /**Set the data transfer type of the device*/
         if(Config[i].TypeTransfer == SPI_RECEIVE_MODE)
         {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_RXONLY;
-        }
-        else if(Config[i].TypeTransfer == SPI_FULL_DUPLEX)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_RXONLY;
-        }
-        else
-        {
-            assert(Config[i].TypeTransfer < SPI_MAX_DF);
+            cr1 |= SPI_CR1_RXONLY;
         }
 
-        /**Set the data frame format (size) of the device*/
-        if(Config[i].DataSize == SPI_8BITS)
-        {
-            *controlRegister1[Config[i].Channel] &=~ SPI_CR1_DFF;
-        }
-        else if(Config[i].DataSize == SPI_16BITS)
+        /**The polynomial is written before the CRC is enabled*/
+        if(Config[i].Crc == SPI_CRC_ENABLED)
         {
-            *controlRegister1[Config[i].Channel] |= SPI_CR1_DFF;
-        }
-        else
-        {
-            assert(Config[i].DataSize < SPI_MAX_BITS);
+            REG_WRITE16(crcPolynomialRegister[Channel], 
+                        Config[i].crcPolynomial);
+            cr1 |= SPI_CR1_CRCEN;
         }
 
-        /**Enable the SPI module*/
-        *controlRegister1[Config[i].Channel] |= SPI_CR1_SPE;
-    }
+        /**Write the settings with the SPI disabled, then enable it*/
+        REG_WRITE16(controlRegister2[Channel], cr2);
+        REG_WRITE16(controlRegister1[Channel], cr1);
+        REG_WRITE16(controlRegister1[Channel], cr1 | SPI_CR1_SPE);
 
+        /**Keep the settings for the device switches*/
+        cr1Shadow[Channel] = cr1 | SPI_CR1_SPE;
+    }
 }
 
 /*****************************************************************************
@@ -295,7 +529,7 @@ void SPI_init(const SpiConfig_t * const Config, size_t configSize)
  * @param[in] SpiTransferConfig A pointer to a structure containing the
  * channel, size, and data to be read.
  * 
- * @return  void
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
  * 
  * \b Example:
  * @code
@@ -318,7 +552,7 @@ void SPI_init(const SpiConfig_t * const Config, size_t configSize)
  * @see SPI_CallbackRegister
  * 
  ****************************************************************************/
-void SPI_transfer(const SpiTransferConfig_t * const TransferConfig)
+SpiStatus_t SPI_transfer(const SpiTransferConfig_t * const TransferConfig)
 {
     /* Prevent to assign a value out of the range of the channel*/
     assert(TransferConfig->Channel < SPI_MAX_CHANNEL);
@@ -327,32 +561,9 @@ void SPI_transfer(const SpiTransferConfig_t * const TransferConfig)
     /* Prevent to use an empty data transfer*/
     assert(TransferConfig->data != NULL);
 
-    for (uint16_t i = 0; i < TransferConfig->size; i++)
-    {
-        /* Wait until TXE is set (buffer empty)*/
-        while(!(*statusRegister[TransferConfig->Channel] & SPI_SR_TXE))
-        {
-            asm("nop");
-        }
-        *dataRegister[TransferConfig->Channel] = TransferConfig->data[i];
-    }
-
-    /* Wait until TXE is set to ensure the bus is empty*/
-    while(!(*statusRegister[TransferConfig->Channel] & SPI_SR_TXE))
-    {
-        asm("nop");
-    }
-
-    /* Wait until bus is not busy to reset*/
-    while(*statusRegister[TransferConfig->Channel] & SPI_SR_BSY)
-    {
-        asm("nop");
-    }
-
-    /* Clear OVR bit (Overrun flag) in case of error*/
-    uint16_t clearingFlag;
-    clearingFlag = *dataRegister[TransferConfig->Channel];
-    clearingFlag = *statusRegister[TransferConfig->Channel];
+    /* The frames received are dropped*/
+    return SPI_run(TransferConfig->Channel, TransferConfig->data, NULL,
+                   TransferConfig->size, false);
 }
 
 /*****************************************************************************
@@ -360,27 +571,27 @@ void SPI_transfer(const SpiTransferConfig_t * const TransferConfig)
 *//**
  *\b Description:
  * This function is used to initialize a data reception on the SPI bus. This 
- * function is used to receive data specified by the  SpiTransferConfig_t 
+ * function is used to receive data specified by the  SpiReceiveConfig_t 
  * structure, which contains the channel, size, and data.
  * 
  * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
  * PRE-CONDITION: SPI_Init must be called with valid configuration data. <br>
- * PRE-CONDITION: SpiTransferConfig_t needs to be populated. <br>
+ * PRE-CONDITION: SpiReceiveConfig_t needs to be populated. <br>
  * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
  * PRE-CONDITION: The size is greater than 0. <br>
  * PRE-CONDITION: The data is not NULL. <br>
  * 
  * POST-CONDITION: Data transferred based on configuration.
  * 
- * @param[in] SpiTransferConfig A pointer to a structure containing the 
+ * @param[in] ReceiveConfig A pointer to a structure containing the 
  * channel, size, and data to be read.
  * 
- * @return  void
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
  * 
  * \b Example:
  * @code
 * uint16_t rxdata[1];
- * SpiTransferConfig_t ReceiveConfig =
+ * SpiReceiveConfig_t ReceiveConfig =
  * {
  *     .Channel = SPI_CHANNEL1,
  *     .size = sizeof(rxdata)/sizeof(rxdata[0]),
@@ -398,27 +609,501 @@ void SPI_transfer(const SpiTransferConfig_t * const TransferConfig)
  * @see SPI_CallbackRegister
  * 
  ****************************************************************************/
-void SPI_receive(const SpiTransferConfig_t * const TransferConfig)
+SpiStatus_t SPI_receive(const SpiReceiveConfig_t * const ReceiveConfig)
+{
+    /* Prevent to assign a value out of the range of the channel*/
+    assert(ReceiveConfig->Channel < SPI_MAX_CHANNEL);
+    /* Prevent to use an empty data size*/
+    assert(ReceiveConfig->size > 0);
+    /* Prevent to use an empty data transfer*/
+    assert(ReceiveConfig->data != NULL);
+
+    /* Send dummy data (Recommended), one frame ahead*/
+    return SPI_run(ReceiveConfig->Channel, NULL, ReceiveConfig->data,
+                   ReceiveConfig->size, false);
+}
+
+/*****************************************************************************
+ * Function: SPI_transferReceive()
+*//**
+ *\b Description:
+ * This function is used to send and receive data on the SPI bus in one
+ * pass. The next frame is written as soon as TXE is set, so the transmit
+ * buffer stays one frame ahead of the reception and the bus never idles
+ * between frames; each frame is read before the next one completes.
+ * 
+ * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+ * PRE-CONDITION: SPI_Init must be called with valid configuration data. <br>
+ * PRE-CONDITION: SpiExchangeConfig_t needs to be populated. <br>
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * 
+ * POST-CONDITION: The data is sent and received, the bus is not busy. <br>
+ * 
+ * @param[in] ExchangeConfig A pointer to a structure containing the
+ * channel, size, data to be sent and data to be read.
+ * 
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
+ * 
+ * \b Example:
+ * @code
+ * uint16_t command[] = {0x9F, 0, 0, 0};
+ * uint16_t answer[4];
+ * const SpiExchangeConfig_t ExchangeConfig =
+ * {
+ *     .Channel = SPI_CHANNEL1,
+ *     .size = sizeof(command)/sizeof(command[0]),
+ *     .txData = command,
+ *     .rxData = answer
+ * };
+ * SPI_transferReceive(&ExchangeConfig);
+ * @endcode
+ * 
+ * @see SPI_Init
+ * @see SPI_Transfer
+ * @see SPI_Receive
+ * @see SPI_transferReceive
+ * 
+ ****************************************************************************/
+SpiStatus_t SPI_transferReceive(
+                    const SpiExchangeConfig_t * const ExchangeConfig)
+{
+    /* Prevent to assign a value out of the range of the channel*/
+    assert(ExchangeConfig->Channel < SPI_MAX_CHANNEL);
+    /* Prevent to use an empty data size*/
+    assert(ExchangeConfig->size > 0);
+
+    return SPI_run(ExchangeConfig->Channel, ExchangeConfig->txData,
+                   ExchangeConfig->rxData, ExchangeConfig->size, false);
+}
+
+/*****************************************************************************
+ * Function: SPI_transfer8()
+*//**
+ *\b Description:
+ * This function is used to send bytes on a channel set to SPI_8BITS, as
+ * SPI_transfer does. The bytes are sent from where they are: a const 
+ * table in flash needs no copy.
+ * 
+ * PRE-CONDITION: SPI_Init must be called with valid configuration data. <br>
+ * PRE-CONDITION: The channel is set to SPI_8BITS. <br>
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL. <br>
+ * 
+ * POST-CONDITION: Data transferred based on configuration. <br>
+ * 
+ * @param[in] TransferConfig A pointer to a structure containing the
+ * channel, size, and bytes to be sent.
+ * 
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
+ * 
+ * \b Example:
+ * @code
+ * static const uint8_t Logo[1024] = {...};
+ * const SpiTransfer8Config_t TransferConfig =
+ * {
+ *     .Channel = SPI_CHANNEL1,
+ *     .size = sizeof(Logo),
+ *     .data = Logo
+ * };
+ * SPI_transfer8(&TransferConfig);
+ * @endcode
+ * 
+ * @see SPI_transfer8
+ * @see SPI_receive8
+ * @see SPI_transferReceive8
+ * 
+ ****************************************************************************/
+SpiStatus_t SPI_transfer8(const SpiTransfer8Config_t * const TransferConfig)
 {
     /* Prevent to assign a value out of the range of the channel*/
     assert(TransferConfig->Channel < SPI_MAX_CHANNEL);
     /* Prevent to use an empty data size*/
     assert(TransferConfig->size > 0);
     /* Prevent to use an empty data transfer*/
-    assert(TransferConfig != NULL);
+    assert(TransferConfig->data != NULL);
+
+    return SPI_run(TransferConfig->Channel, TransferConfig->data, NULL,
+                   TransferConfig->size, true);
+}
+
+/*****************************************************************************
+ * Function: SPI_receive8()
+*//**
+ *\b Description:
+ * This function is used to receive bytes on a channel set to SPI_8BITS, 
+ * as SPI_receive does.
+ * 
+ * PRE-CONDITION: SPI_Init must be called with valid configuration data. <br>
+ * PRE-CONDITION: The channel is set to SPI_8BITS. <br>
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL. <br>
+ * 
+ * POST-CONDITION: The bytes received are in data. <br>
+ * 
+ * @param[in] ReceiveConfig A pointer to a structure containing the
+ * channel, size, and bytes to be read.
+ * 
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
+ * 
+ * @see SPI_transfer8
+ * @see SPI_receive8
+ * @see SPI_transferReceive8
+ * 
+ ****************************************************************************/
+SpiStatus_t SPI_receive8(const SpiReceive8Config_t * const ReceiveConfig)
+{
+    /* Prevent to assign a value out of the range of the channel*/
+    assert(ReceiveConfig->Channel < SPI_MAX_CHANNEL);
+    /* Prevent to use an empty data size*/
+    assert(ReceiveConfig->size > 0);
+    /* Prevent to use an empty data transfer*/
+    assert(ReceiveConfig->data != NULL);
+
+    return SPI_run(ReceiveConfig->Channel, NULL, ReceiveConfig->data,
+                   ReceiveConfig->size, true);
+}
+
+/*****************************************************************************
+ * Function: SPI_transferReceive8()
+*//**
+ *\b Description:
+ * This function is used to exchange bytes on a channel set to SPI_8BITS,
+ * as SPI_transferReceive does.
+ * 
+ * PRE-CONDITION: SPI_Init must be called with valid configuration data. <br>
+ * PRE-CONDITION: The channel is set to SPI_8BITS. <br>
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * 
+ * POST-CONDITION: The data is sent and received, the bus is not busy. <br>
+ * 
+ * @param[in] ExchangeConfig A pointer to a structure containing the
+ * channel, size, bytes to be sent and bytes to be read.
+ * 
+ * @return  SPI_CRC_ERROR if the CRC received does not match, else SPI_OK.
+ * 
+ * @see SPI_transfer8
+ * @see SPI_receive8
+ * @see SPI_transferReceive8
+ * 
+ ****************************************************************************/
+SpiStatus_t SPI_transferReceive8(
+                    const SpiExchange8Config_t * const ExchangeConfig)
+{
+    /* Prevent to assign a value out of the range of the channel*/
+    assert(ExchangeConfig->Channel < SPI_MAX_CHANNEL);
+    /* Prevent to use an empty data size*/
+    assert(ExchangeConfig->size > 0);
+
+    return SPI_run(ExchangeConfig->Channel, ExchangeConfig->txData,
+                   ExchangeConfig->rxData, ExchangeConfig->size, true);
+}
+
+/*****************************************************************************
+ * Function: SPI_transactionBegin()
+*//**
+ *\b Description:
+ * This function is used to open a transaction on a channel: up to 
+ * SPI_transactionEnd, SPI_transfer, SPI_receive and SPI_transferReceive 
+ * keep the bus busy from one call to the next. A transfer returns once its
+ * last frame is written, the next call sends its first frame without 
+ * waiting for the bus to drain.
+ * 
+ * PRE-CONDITION: SPI_Init must be called with valid configuration data. <br>
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * PRE-CONDITION: No transaction is open on the channel. <br>
+ * 
+ * POST-CONDITION: The calls on the channel are pipelined. <br>
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * uint16_t command[] = {0x03, 0x00, 0x10, 0x00};
+ * uint16_t page[256];
+ * const SpiTransferConfig_t Command = {SPI_CHANNEL1, 4, command};
+ * const SpiReceiveConfig_t Page = {SPI_CHANNEL1, 256, page};
+ * 
+ * DIO_pinWrite(&CSLine, DIO_LOW);
+ * SPI_transactionBegin(SPI_CHANNEL1);
+ * SPI_transfer(&Command);
+ * SPI_receive(&Page);
+ * SPI_transactionEnd(SPI_CHANNEL1);
+ * DIO_pinWrite(&CSLine, DIO_HIGH);
+ * @endcode
+ * 
+ * @see SPI_Transfer
+ * @see SPI_Receive
+ * @see SPI_transferReceive
+ * @see SPI_transactionBegin
+ * @see SPI_transactionEnd
+ * 
+ ****************************************************************************/
+void SPI_transactionBegin(SpiChannel_t Channel)
+{
+    /* Prevent to assign a value out of the range of the channel*/
+    assert(Channel < SPI_MAX_CHANNEL);
+    assert(!transaction[Channel]);
+
+    SPI_flush(Channel);
+    transaction[Channel] = true;
+}
+
+/*****************************************************************************
+ * Function: SPI_transactionEnd()
+*//**
+ *\b Description:
+ * This function is used to close the transaction of a channel: the frames
+ * still on the wire are received and dropped and the bus drains (BSY).
+ * 
+ * PRE-CONDITION: A transaction is open on the channel. <br>
+ * 
+ * POST-CONDITION: The bus is not busy, the chip select can be released.
+ * <br>
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * 
+ * @return  void
+ * 
+ * @see SPI_transactionBegin
+ * @see SPI_transactionEnd
+ * 
+ ****************************************************************************/
+void SPI_transactionEnd(SpiChannel_t Channel)
+{
+    /* Prevent to assign a value out of the range of the channel*/
+    assert(Channel < SPI_MAX_CHANNEL);
+    assert(transaction[Channel]);
 
-    for (uint8_t i = 0; i < TransferConfig->size; i++)
+    SPI_drain(Channel);
+    transaction[Channel] = false;
+}
+
+/*****************************************************************************
+ * Function: SPI_deviceInit()
+*//**
+ *\b Description:
+ * This function is used to prepare a device for SPI_deviceSelect: the 
+ * handle of its chip select and the CR1 bits of its settings are resolved
+ * once here, so a select is a CR1 compare and one BSRR store.
+ * 
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * PRE-CONDITION: The Cs port and pin are within DioPort_t and DioPin_t.
+ * <br>
+ * PRE-CONDITION: The settings are within the maximum values (SPI_MAX). 
+ * <br>
+ * 
+ * POST-CONDITION: The device is ready for SPI_deviceSelect. <br>
+ * 
+ * @param[in,out]   Device is a pointer to the device.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * SpiDevice_t Flash =
+ * {
+ *     .Channel = SPI_CHANNEL1,
+ *     .Cs = {DIO_PA, DIO_PA4},
+ *     .Mode = SPI_MODE0,
+ *     .BaudRate = SPI_FPCLK2,
+ *     .FrameFormat = SPI_MSB,
+ *     .DataSize = SPI_8BITS
+ * };
+ * 
+ * SPI_deviceInit(&Flash);
+ * @endcode
+ * 
+ * @see SPI_deviceInit
+ * @see SPI_deviceSelect
+ * 
+ ****************************************************************************/
+void SPI_deviceInit(SpiDevice_t * const Device)
+{
+    assert(Device->Channel < SPI_MAX_CHANNEL);
+    assert(Device->Mode < SPI_MAX_MODE);
+    assert(Device->BaudRate < SPI_MAX_FPCLK);
+    assert(Device->FrameFormat < SPI_MAX_FF);
+    assert(Device->DataSize < SPI_MAX_BITS);
+
+    Device->CsHandle = DIO_pinHandleGet(&Device->Cs);
+    Device->cr1Bits = SPI_cr1Bits(Device->Mode, Device->BaudRate, 
+                                  Device->FrameFormat, Device->DataSize);
+}
+
+/*****************************************************************************
+ * Function: SPI_deviceSelect()
+*//**
+ *\b Description:
+ * This function is used to start the access to a device on a shared 
+ * channel: its settings are applied, a transaction is opened and its chip
+ * select is pulled low. CR1 is compared with its shadow and written only
+ * if the device settings differ from the previous device, so selecting the
+ * same device again costs no CR1 access.
+ * 
+ * PRE-CONDITION: SPI_init has set up the channel. <br>
+ * PRE-CONDITION: SPI_deviceInit has prepared the device. <br>
+ * PRE-CONDITION: The channel is idle, no transaction, DMA or interrupt
+ * transfer is running. <br>
+ * PRE-CONDITION: The chip select is an output, high while idle. <br>
+ * 
+ * POST-CONDITION: The channel runs with the settings of the device, in a
+ * transaction. <br>
+ * 
+ * @param[in]   Device is a pointer to the device.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * SpiDevice_t Flash =
+ * {
+ *     .Channel = SPI_CHANNEL1,
+ *     .Cs = {DIO_PA, DIO_PA4},
+ *     .Mode = SPI_MODE0,
+ *     .BaudRate = SPI_FPCLK2,
+ *     .FrameFormat = SPI_MSB,
+ *     .DataSize = SPI_8BITS
+ * };
+ * uint8_t command[] = {0x9F, 0, 0, 0};
+ * const SpiExchange8Config_t Id = {SPI_CHANNEL1, 4, command, command};
+ * 
+ * SPI_deviceInit(&Flash);
+ * SPI_deviceSelect(&Flash);
+ * SPI_transferReceive8(&Id);
+ * SPI_deviceDeselect(&Flash);
+ * @endcode
+ * 
+ * @see SPI_deviceInit
+ * @see SPI_deviceSelect
+ * @see SPI_deviceDeselect
+ * @see SPI_transactionBegin
+ * 
+ ****************************************************************************/
+void SPI_deviceSelect(const SpiDevice_t * const Device)
+{
+    assert(Device->Channel < SPI_MAX_CHANNEL);
+    assert(Device->CsHandle.Bsrr != NULL);
+
+    const SpiChannel_t Channel = Device->Channel;
+    const uint16_t cr1 = (cr1Shadow[Channel] & 
+                          (uint16_t)~SPI_DEVICE_CR1_MASK) | Device->cr1Bits;
+
+    if(cr1 != cr1Shadow[Channel])
     {
-        /* Send dummy data (Recommended).*/
-        *dataRegister[TransferConfig->Channel] = 0;
-        /* Wait for RXEN flag to be sent*/
-        while(!(*statusRegister[TransferConfig->Channel] & SPI_SR_RXNE))
-        {
-            asm("nop");
-        }
-        /* Read the data*/
-        TransferConfig->data[i] = *dataRegister[TransferConfig->Channel];
+        SPI_cr1Write(Channel, cr1);
     }
+
+    SPI_transactionBegin(Channel);
+    DIO_pinClear(&Device->CsHandle);
+}
+
+/*****************************************************************************
+ * Function: SPI_deviceDeselect()
+*//**
+ *\b Description:
+ * This function is used to end the access to a device: the transaction is
+ * closed (the bus drains) and its chip select is pulled high.
+ * 
+ * PRE-CONDITION: SPI_deviceSelect has selected the device. <br>
+ * 
+ * POST-CONDITION: The channel is idle and the device is released. <br>
+ * 
+ * @param[in]   Device is a pointer to the device.
+ * 
+ * @return  void
+ * 
+ * @see SPI_deviceSelect
+ * @see SPI_deviceDeselect
+ * @see SPI_transactionEnd
+ * 
+ ****************************************************************************/
+void SPI_deviceDeselect(const SpiDevice_t * const Device)
+{
+    assert(Device->Channel < SPI_MAX_CHANNEL);
+
+    SPI_transactionEnd(Device->Channel);
+    DIO_pinSet(&Device->CsHandle);
+}
+
+/*****************************************************************************
+ * Function: SPI_settingsRestore()
+*//**
+ *\b Description:
+ * This function is used to write CR1 of a channel back from the settings
+ * kept by SPI_init and SPI_deviceSelect. A mode fault (MODF) clears SPE 
+ * and MSTR in hardware; reading SR and then calling this function clears
+ * MODF and brings the channel back as a master.
+ * 
+ * PRE-CONDITION: SPI_init must be called with valid configuration data. <br>
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * 
+ * POST-CONDITION: CR1 holds the settings of the channel. <br>
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * if(SPI_registerRead(SPI1_BASE + 0x08UL) & SPI_SR_MODF)
+ * {
+ *     SPI_settingsRestore(SPI_CHANNEL1);
+ * }
+ * @endcode
+ * 
+ * @see SPI_init
+ * @see SPI_deviceSelect
+ * @see SPI_settingsRestore
+ * 
+ ****************************************************************************/
+void SPI_settingsRestore(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    REG_WRITE16(controlRegister1[Channel], cr1Shadow[Channel]);
+}
+
+/*****************************************************************************
+ * Function: SPI_crcReset()
+*//**
+ *\b Description:
+ * This function is used to clear the CRC registers (TXCRCR and RXCRCR) of
+ * a channel before a message: CRCEN is cleared and set again with the SPI
+ * disabled. CR1 is written from its shadow, so the settings of the 
+ * channel are kept. The polled transfers call it at the start of each 
+ * message, the DMA transfers at the start of each transfer.
+ * 
+ * PRE-CONDITION: SPI_init has set the channel to SPI_CRC_ENABLED. <br>
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ * PRE-CONDITION: The bus is not busy. <br>
+ * 
+ * POST-CONDITION: TXCRCR and RXCRCR are zero, the SPI is enabled. <br>
+ * 
+ * @param[in]   Channel is the SPI channel.
+ * 
+ * @return  void
+ * 
+ * @see SPI_init
+ * @see SPI_crcReset
+ * @see SPI_transferReceive
+ * 
+ ****************************************************************************/
+void SPI_crcReset(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    const uint16_t cr1 = cr1Shadow[Channel];
+
+    REG_WRITE16(controlRegister1[Channel], 
+                cr1 & ~(SPI_CR1_SPE | SPI_CR1_CRCEN));
+    REG_WRITE16(controlRegister1[Channel], cr1 & ~SPI_CR1_SPE);
+    REG_WRITE16(controlRegister1[Channel], cr1);
 }
 
 /*****************************************************************************
@@ -428,7 +1113,8 @@ void SPI_receive(const SpiTransferConfig_t * const TransferConfig)
  * This function is used to directly address and modify a SPI register.
  * The function should be used to access specialized functionality in 
  * the SPI peripheral that is not exposed by any other function of the
- * interface.
+ * interface. A setting written to CR1 is not seen by SPI_deviceSelect,
+ * which compares the devices with the last value written by the driver.
  * 
  * PRE-CONDITION: Address is within the boundaries of the SPI register
  * address space. <br>
@@ -458,8 +1144,8 @@ void SPI_receive(const SpiTransferConfig_t * const TransferConfig)
 ****************************************************************************/  
 void SPI_registerWrite(uint32_t address, uint32_t value)
 {
-    volatile uint32_t * const registerPointer = (uint32_t*)address;
-    *registerPointer = value;
+    volatile uint32_t * const registerPointer = REG_ADDRESS32(address);
+    REG_WRITE32(registerPointer, value);
 }
 
 /*****************************************************************************
@@ -497,7 +1183,7 @@ void SPI_registerWrite(uint32_t address, uint32_t value)
  ****************************************************************************/
 uint16_t SPI_registerRead(uint32_t address)
 {
-    volatile uint16_t * const registerPointer = (uint16_t *)address;
+    volatile uint16_t * const registerPointer = REG_ADDRESS16(address);
 
-    return *registerPointer;
+    return REG_READ16(registerPointer);
 }
\ No newline at end of file
@@ -42,10 +42,10 @@ const SpiConfig_t SpiConfig[] =
 {
 /*                                                          
  * Channel        Mode       Hierarchy   Baud rate   NSS pin,                   
- * Frame    Type             Size               
+ * Frame    Type             Size       CRC               Polynomial
 */
    {SPI_CHANNEL1, SPI_MODE3, SPI_MASTER, SPI_FPCLK4, SPI_HARDWARE_NSS_ENABLED, 
-   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS},
+   SPI_MSB, SPI_FULL_DUPLEX, SPI_8BITS, SPI_CRC_DISABLED, 0x0007},
 };
 
 /*****************************************************************************
@@ -0,0 +1,785 @@
+/**
+ * @file spi_dma.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the SPI DMA transfers.
+ * @version 1.0
+ * @date 2025-04-14
+ * @note Take into account the following considerations:
+ * + Each channel owns a receive and a transmit stream (RM0368 DMA request
+ *   mapping) and the interrupt of its receive stream:
+ *   SPI1: DMA2 stream 2 (RX) and 3 (TX), channel 3.
+ *   SPI2: DMA1 stream 3 (RX) and 4 (TX), channel 0.
+ *   SPI3: DMA1 stream 0 (RX) and 5 (TX), channel 0.
+ *   SPI4: DMA2 stream 0 (RX) and 1 (TX), channel 4.
+ * + Both streams always run: the receive stream drains DR, so a transfer
+ *   never overruns, and its last frame marks the end of the bus activity.
+ * + The frames are 16 bits items (SpiTransferConfig_t) or bytes 
+ *   (SpiTransfer8Config_t) in memory, moved from and to the buffers of the
+ *   caller: a const table in flash is sent without a copy.
+ * + A stream moves at most 65535 items (NDTR); a longer transfer is split
+ *   in blocks, the interrupt of a block starts the next one.
+ * + A transfer started by the completion callback of a good transfer is
+ *   chained: the DMA requests of the SPI stay on and DR is not flushed, 
+ *   only the streams are set up again (SPI_queuePush).
+ * + On a channel set to SPI_CRC_ENABLED each transfer is a message: the
+ *   CRC registers are cleared at its start, the SPI sends the CRC frame
+ *   when the transmit stream ends, and the receive stream is armed again
+ *   for one frame to drop the CRC received before CRCERR is checked. The
+ *   message fits one block (65535 frames).
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "spi_dma.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/** Defines the status and clear flags of a stream, at the stream 0 place */
+#define SPI_DMA_FLAGS   (DMA_LIFCR_CFEIF0 | DMA_LIFCR_CDMEIF0 |         \
+                         DMA_LIFCR_CTEIF0 | DMA_LIFCR_CHTIF0 |          \
+                         DMA_LIFCR_CTCIF0)
+
+/** Defines the items of a block, the size of NDTR */
+#define SPI_DMA_MAX_ITEMS   65535U
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+/**
+ * Defines the DMA streams of a channel. The flags of a stream are at the
+ * shift of the stream in LISR/LIFCR (streams 0-3) or HISR/HIFCR (4-7).
+ */
+typedef struct
+{
+    uint16_t volatile *Dr;              /**< DR of the SPI */
+    uint16_t volatile *Sr;              /**< SR of the SPI */
+    uint16_t volatile *Cr2;             /**< CR2 of the SPI */
+    DMA_Stream_TypeDef *Rx;             /**< Receive stream */
+    DMA_Stream_TypeDef *Tx;             /**< Transmit stream */
+    uint32_t volatile *RxStatus;        /**< LISR/HISR of the RX stream */
+    uint32_t volatile *RxClear;         /**< LIFCR/HIFCR of the RX stream */
+    uint32_t volatile *TxClear;         /**< LIFCR/HIFCR of the TX stream */
+    uint8_t rxShift;                    /**< Flags shift of the RX stream */
+    uint8_t txShift;                    /**< Flags shift of the TX stream */
+    uint32_t channel;                   /**< Request channel (CHSEL) */
+    IRQn_Type RxIrq;                    /**< Interrupt of the RX stream */
+}SpiDmaMap_t;
+
+/**
+ * Defines the transfer of a channel: the items of the blocks not started.
+ */
+typedef struct
+{
+    const uint8_t *tx;                  /**< Next item to send, NULL: 0 */
+    uint8_t *rx;                        /**< Next item received, NULL */
+    size_t remaining;                   /**< Items not started */
+    uint32_t itemSize;                  /**< Bytes per item, 1 or 2 */
+    bool crc;                           /**< The CRC frame is to come */
+}SpiDmaContext_t;
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** DMA streams of SPI1-SPI4 (RM0368 DMA request mapping) */
+static const SpiDmaMap_t SpiDmaMap[SPI_PORTS_NUMBER] =
+{
+    {(uint16_t*)&SPI1->DR, (uint16_t*)&SPI1->SR, (uint16_t*)&SPI1->CR2,
+     DMA2_Stream2, DMA2_Stream3, &DMA2->LISR, &DMA2->LIFCR, &DMA2->LIFCR,
+     16U, 22U, 3U, DMA2_Stream2_IRQn},
+    {(uint16_t*)&SPI2->DR, (uint16_t*)&SPI2->SR, (uint16_t*)&SPI2->CR2,
+     DMA1_Stream3, DMA1_Stream4, &DMA1->LISR, &DMA1->LIFCR, &DMA1->HIFCR,
+     22U, 0U, 0U, DMA1_Stream3_IRQn},
+    {(uint16_t*)&SPI3->DR, (uint16_t*)&SPI3->SR, (uint16_t*)&SPI3->CR2,
+     DMA1_Stream0, DMA1_Stream5, &DMA1->LISR, &DMA1->LIFCR, &DMA1->HIFCR,
+     0U, 6U, 0U, DMA1_Stream0_IRQn},
+    {(uint16_t*)&SPI4->DR, (uint16_t*)&SPI4->SR, (uint16_t*)&SPI4->CR2,
+     DMA2_Stream0, DMA2_Stream1, &DMA2->LISR, &DMA2->LIFCR, &DMA2->LIFCR,
+     0U, 6U, 4U, DMA2_Stream0_IRQn},
+};
+
+/** Status of the transfers of each channel */
+static volatile SpiDmaStatus_t DmaStatus[SPI_PORTS_NUMBER];
+
+/** Completion callback of each channel */
+static SpiDmaCallback_t DmaCallback[SPI_PORTS_NUMBER];
+
+/** Transfer of each channel */
+static SpiDmaContext_t DmaContext[SPI_PORTS_NUMBER];
+
+/** The completion callback of the channel runs after a good transfer */
+static bool DmaChained[SPI_PORTS_NUMBER];
+
+/** The channel sends and checks a CRC frame after each transfer */
+static bool DmaCrc[SPI_PORTS_NUMBER];
+
+/** Frame sent by SPI_receiveDma */
+static const uint16_t DmaZero = 0;
+
+/** Frames dropped by SPI_transferDma */
+static uint16_t DmaSink;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void SPI_dmaStart(SpiChannel_t Channel, const void * const Tx,
+                         void * const Rx, size_t size, uint32_t itemSize);
+static void SPI_dmaBlock(SpiChannel_t Channel);
+static void SPI_dmaCrcFrame(SpiChannel_t Channel);
+static void SPI_dmaComplete(SpiChannel_t Channel);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SPI_dmaStart()
+*//**
+ *\b Description:
+ * This function is used to start a transfer. A frame left in DR by a 
+ * previous transfer is read first, so the receive stream stays aligned 
+ * with the transmit stream.
+ *
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   Tx is the items to send, NULL to send zeros.
+ * @param[out]  Rx is the items received, NULL to drop them.
+ * @param[in]   size is the number of frames.
+ * @param[in]   itemSize is the bytes per item, 1 or 2.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_dmaStart(SpiChannel_t Channel, const void * const Tx,
+                         void * const Rx, size_t size, uint32_t itemSize)
+{
+    const SpiDmaMap_t * const Map = &SpiDmaMap[Channel];
+    SpiDmaContext_t * const Context = &DmaContext[Channel];
+
+    assert(DmaStatus[Channel] != SPI_DMA_BUSY);
+    DmaStatus[Channel] = SPI_DMA_BUSY;
+
+    Context->tx = Tx;
+    Context->rx = Rx;
+    Context->remaining = size;
+    Context->itemSize = itemSize;
+    Context->crc = DmaCrc[Channel];
+
+    /* The CRC registers are cleared from the CR1 shadow of the channel */
+    if(DmaCrc[Channel])
+    {
+        /* The CRC frame follows the end of the transmit stream */
+        assert(size <= SPI_DMA_MAX_ITEMS);
+
+        SPI_crcReset(Channel);
+    }
+
+    /* 
+     * A transfer started by the callback follows a good one: DR is empty
+     * and the DMA requests are still on, only the streams are set up.
+     */
+    if(DmaChained[Channel])
+    {
+        SPI_dmaBlock(Channel);
+        return;
+    }
+
+    /* Drop a stale frame and a stale overrun */
+    (void)REG_READ16(Map->Dr);
+    (void)REG_READ16(Map->Sr);
+
+    REG_WRITE32(Map->RxClear, SPI_DMA_FLAGS << Map->rxShift);
+    SPI_dmaBlock(Channel);
+
+    /* The receive stream is enabled before the first transmit request */
+    REG_SET16(Map->Cr2, SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+}
+
+/*****************************************************************************
+ * Function: SPI_dmaBlock()
+*//**
+ *\b Description:
+ * This function is used to start the streams on the next block of a 
+ * transfer, the receive stream first (RM0368 SPI DMA procedure).
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_dmaBlock(SpiChannel_t Channel)
+{
+    const SpiDmaMap_t * const Map = &SpiDmaMap[Channel];
+    SpiDmaContext_t * const Context = &DmaContext[Channel];
+    const size_t items = (Context->remaining > SPI_DMA_MAX_ITEMS) ?
+                         SPI_DMA_MAX_ITEMS : Context->remaining;
+    const uint32_t common = (Map->channel << DMA_SxCR_CHSEL_Pos) |
+        ((Context->itemSize == 2U) ? (DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0)
+                                   : 0U);
+
+    /* The flags of the receive stream are cleared by its interrupt */
+    REG_WRITE32(Map->TxClear, SPI_DMA_FLAGS << Map->txShift);
+
+    /* Peripheral to memory, the last frame interrupts */
+    REG_WRITE32(&Map->Rx->M0AR, (Context->rx != NULL) ?
+                REG_DMA_ADDRESS(Context->rx) : REG_DMA_ADDRESS(&DmaSink));
+    REG_WRITE32(&Map->Rx->NDTR, items);
+    REG_WRITE32(&Map->Rx->CR, common | DMA_SxCR_PL_1 | DMA_SxCR_TCIE |
+                DMA_SxCR_TEIE | ((Context->rx != NULL) ? DMA_SxCR_MINC : 0U)
+                | DMA_SxCR_EN);
+
+    /* Memory to peripheral */
+    REG_WRITE32(&Map->Tx->M0AR, (Context->tx != NULL) ?
+                REG_DMA_ADDRESS(Context->tx) : REG_DMA_ADDRESS(&DmaZero));
+    REG_WRITE32(&Map->Tx->NDTR, items);
+    REG_WRITE32(&Map->Tx->CR, common | DMA_SxCR_PL_0 | DMA_SxCR_DIR_0 |
+                ((Context->tx != NULL) ? DMA_SxCR_MINC : 0U) | DMA_SxCR_EN);
+
+    if(Context->tx != NULL)
+    {
+        Context->tx += items * Context->itemSize;
+    }
+    if(Context->rx != NULL)
+    {
+        Context->rx += items * Context->itemSize;
+    }
+    Context->remaining -= items;
+}
+
+/*****************************************************************************
+ * Function: SPI_dmaCrcFrame()
+*//**
+ *\b Description:
+ * This function is used to arm the receive stream of a channel for the 
+ * CRC frame that follows the last frame of a message; the frame is 
+ * dropped, the SPI compares it with the CRC computed.
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_dmaCrcFrame(SpiChannel_t Channel)
+{
+    const SpiDmaMap_t * const Map = &SpiDmaMap[Channel];
+    SpiDmaContext_t * const Context = &DmaContext[Channel];
+
+    Context->crc = false;
+
+    REG_WRITE32(&Map->Rx->M0AR, REG_DMA_ADDRESS(&DmaSink));
+    REG_WRITE32(&Map->Rx->NDTR, 1U);
+    REG_WRITE32(&Map->Rx->CR, (Map->channel << DMA_SxCR_CHSEL_Pos) |
+                ((Context->itemSize == 2U) ? 
+                 (DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0) : 0U) |
+                DMA_SxCR_PL_1 | DMA_SxCR_TCIE | DMA_SxCR_TEIE | DMA_SxCR_EN);
+}
+
+/*****************************************************************************
+ * Function: SPI_dmaComplete()
+*//**
+ *\b Description:
+ * This function is used to serve the interrupt of the receive stream of 
+ * a channel: the next block (or the CRC frame) is started, or the DMA 
+ * requests of the SPI are disabled and the callback is called.
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_dmaComplete(SpiChannel_t Channel)
+{
+    const SpiDmaMap_t * const Map = &SpiDmaMap[Channel];
+    const uint32_t status = REG_READ32(Map->RxStatus) >> Map->rxShift;
+
+    REG_WRITE32(Map->RxClear, SPI_DMA_FLAGS << Map->rxShift);
+
+    if((status & (DMA_LISR_TCIF0 | DMA_LISR_TEIF0)) == 0U)
+    {
+        return;
+    }
+
+    if(status & DMA_LISR_TEIF0)
+    {
+        DmaStatus[Channel] = SPI_DMA_ERROR;
+    }
+    else if(DmaContext[Channel].remaining > 0U)
+    {
+        SPI_dmaBlock(Channel);
+        return;
+    }
+    else if(DmaContext[Channel].crc)
+    {
+        SPI_dmaCrcFrame(Channel);
+        return;
+    }
+    else if(DmaCrc[Channel] && 
+            (REG_READ16(Map->Sr) & SPI_SR_CRCERR))
+    {
+        /* CRCERR is cleared by writing 0, the other bits are read only */
+        REG_WRITE16(Map->Sr, (uint16_t)~SPI_SR_CRCERR);
+        DmaStatus[Channel] = SPI_DMA_CRC_ERROR;
+    }
+    else
+    {
+        DmaStatus[Channel] = SPI_DMA_IDLE;
+    }
+
+    if(DmaCallback[Channel] != NULL)
+    {
+        DmaChained[Channel] = (DmaStatus[Channel] == SPI_DMA_IDLE);
+        DmaCallback[Channel](Channel, DmaStatus[Channel]);
+        DmaChained[Channel] = false;
+    }
+
+    /* The DMA requests stay on for a transfer started by the callback */
+    if(DmaStatus[Channel] != SPI_DMA_BUSY)
+    {
+        REG_CLEAR16(Map->Cr2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_dmaInit()
+*//**
+ *\b Description:
+ * This function is used to set up the DMA streams of the channels of the
+ * configuration table: the streams mapped to each channel are pointed at
+ * its DR and the interrupt of the receive stream is enabled.
+ *
+ * PRE-CONDITION: SPI_init has set up the channels of the table. <br>
+ * PRE-CONDITION: The clocks of DMA1 and DMA2 are enabled. <br>
+ *
+ * POST-CONDITION: The channels are ready for SPI_transferDma and
+ * SPI_receiveDma. <br>
+ *
+ * @param[in]   Config is a pointer to the configuration table.
+ * @param[in]   configSize is the size of the configuration table.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * const SpiConfig_t * const SpiConfig = SPI_ConfigGet();
+ * size_t configSize = SPI_configSizeGet();
+ *
+ * SPI_init(SpiConfig, configSize);
+ * SPI_dmaInit(SpiConfig, configSize);
+ * @endcode
+ *
+ * @see SPI_dmaInit
+ * @see SPI_dmaCallbackRegister
+ * @see SPI_transferDma
+ * @see SPI_receiveDma
+ *
+*****************************************************************************/
+void SPI_dmaInit(const SpiConfig_t * const Config, size_t configSize)
+{
+    for(size_t i = 0; i < configSize; i++)
+    {
+        assert(Config[i].Channel < SPI_MAX_CHANNEL);
+
+        const SpiDmaMap_t * const Map = &SpiDmaMap[Config[i].Channel];
+
+        REG_WRITE32(&Map->Rx->CR, 0);
+        REG_WRITE32(&Map->Tx->CR, 0);
+        REG_WRITE32(&Map->Rx->PAR, REG_DMA_ADDRESS(Map->Dr));
+        REG_WRITE32(&Map->Tx->PAR, REG_DMA_ADDRESS(Map->Dr));
+        REG_WRITE32(&Map->Rx->FCR, 0);
+        REG_WRITE32(&Map->Tx->FCR, 0);
+
+        DmaStatus[Config[i].Channel] = SPI_DMA_IDLE;
+        DmaCrc[Config[i].Channel] = (Config[i].Crc == SPI_CRC_ENABLED);
+        NVIC_ClearPendingIRQ(Map->RxIrq);
+        NVIC_EnableIRQ(Map->RxIrq);
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_dmaCallbackRegister()
+*//**
+ *\b Description:
+ * This function is used to register the function called at the end of
+ * each transfer of a channel.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: The callback runs at the end of the next transfers. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   Callback is the function to call, NULL for none.
+ *
+ * @return  void
+ *
+ * @see SPI_dmaCallbackRegister
+ * @see SPI_dmaStatusGet
+ *
+*****************************************************************************/
+void SPI_dmaCallbackRegister(SpiChannel_t Channel, SpiDmaCallback_t Callback)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    DmaCallback[Channel] = Callback;
+}
+
+/*****************************************************************************
+ * Function: SPI_transferDma()
+*//**
+ *\b Description:
+ * This function is used to start sending data on the SPI bus, as
+ * SPI_transfer does, and returns at once. The frames received are
+ * dropped.
+ *
+ * PRE-CONDITION: SPI_dmaInit has set up the channel. <br>
+ * PRE-CONDITION: No transfer is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL and lives until the end. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last frame is on the
+ * wire, then the callback is called. <br>
+ *
+ * @param[in] TransferConfig A pointer to a structure containing the
+ * channel, size, and data to be sent.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static const uint16_t data[64] = {...};
+ * const SpiTransferConfig_t TransferConfig =
+ * {
+ *     .Channel = SPI_CHANNEL1,
+ *     .size = sizeof(data)/sizeof(data[0]),
+ *     .data = data
+ * };
+ *
+ * SPI_transferDma(&TransferConfig);
+ * ...                                  //Other work
+ * SPI_dmaWait(SPI_CHANNEL1);
+ * @endcode
+ *
+ * @see SPI_transferDma
+ * @see SPI_receiveDma
+ * @see SPI_dmaStatusGet
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+void SPI_transferDma(const SpiTransferConfig_t * const TransferConfig)
+{
+    assert(TransferConfig->Channel < SPI_MAX_CHANNEL);
+    assert(TransferConfig->size > 0);
+    assert(TransferConfig->data != NULL);
+
+    SPI_dmaStart(TransferConfig->Channel, TransferConfig->data, NULL,
+                 TransferConfig->size, sizeof(uint16_t));
+}
+
+/*****************************************************************************
+ * Function: SPI_receiveDma()
+*//**
+ *\b Description:
+ * This function is used to start receiving data on the SPI bus, as
+ * SPI_receive does (zeros are sent), and returns at once.
+ *
+ * PRE-CONDITION: SPI_dmaInit has set up the channel. <br>
+ * PRE-CONDITION: No transfer is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL and lives until the end. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last frame is in data,
+ * then the callback is called. <br>
+ *
+ * @param[in] ReceiveConfig A pointer to a structure containing the
+ * channel, size, and data to be read.
+ *
+ * @return  void
+ *
+ * @see SPI_transferDma
+ * @see SPI_receiveDma
+ * @see SPI_dmaStatusGet
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+void SPI_receiveDma(const SpiReceiveConfig_t * const ReceiveConfig)
+{
+    assert(ReceiveConfig->Channel < SPI_MAX_CHANNEL);
+    assert(ReceiveConfig->size > 0);
+    assert(ReceiveConfig->data != NULL);
+
+    SPI_dmaStart(ReceiveConfig->Channel, NULL, ReceiveConfig->data,
+                 ReceiveConfig->size, sizeof(uint16_t));
+}
+
+/*****************************************************************************
+ * Function: SPI_transferDma8()
+*//**
+ *\b Description:
+ * This function is used to start sending bytes on a channel set to 
+ * SPI_8BITS, as SPI_transferDma does. The stream reads the bytes where 
+ * they are, a const table in flash included.
+ *
+ * PRE-CONDITION: SPI_dmaInit has set up the channel. <br>
+ * PRE-CONDITION: The channel is set to SPI_8BITS. <br>
+ * PRE-CONDITION: No transfer is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL and lives until the end. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last frame is on the
+ * wire, then the callback is called. <br>
+ *
+ * @param[in] TransferConfig A pointer to a structure containing the
+ * channel, size, and bytes to be sent.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static const uint8_t Frame[128 * 64 / 8] = {...};
+ * const SpiTransfer8Config_t TransferConfig =
+ * {
+ *     .Channel = SPI_CHANNEL1,
+ *     .size = sizeof(Frame),
+ *     .data = Frame
+ * };
+ *
+ * SPI_transferDma8(&TransferConfig);
+ * @endcode
+ *
+ * @see SPI_transferDma8
+ * @see SPI_receiveDma8
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+void SPI_transferDma8(const SpiTransfer8Config_t * const TransferConfig)
+{
+    assert(TransferConfig->Channel < SPI_MAX_CHANNEL);
+    assert(TransferConfig->size > 0);
+    assert(TransferConfig->data != NULL);
+
+    SPI_dmaStart(TransferConfig->Channel, TransferConfig->data, NULL,
+                 TransferConfig->size, sizeof(uint8_t));
+}
+
+/*****************************************************************************
+ * Function: SPI_receiveDma8()
+*//**
+ *\b Description:
+ * This function is used to start receiving bytes on a channel set to 
+ * SPI_8BITS, as SPI_receiveDma does.
+ *
+ * PRE-CONDITION: SPI_dmaInit has set up the channel. <br>
+ * PRE-CONDITION: The channel is set to SPI_8BITS. <br>
+ * PRE-CONDITION: No transfer is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL and lives until the end. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last byte is in data,
+ * then the callback is called. <br>
+ *
+ * @param[in] ReceiveConfig A pointer to a structure containing the
+ * channel, size, and bytes to be read.
+ *
+ * @return  void
+ *
+ * @see SPI_transferDma8
+ * @see SPI_receiveDma8
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+void SPI_receiveDma8(const SpiReceive8Config_t * const ReceiveConfig)
+{
+    assert(ReceiveConfig->Channel < SPI_MAX_CHANNEL);
+    assert(ReceiveConfig->size > 0);
+    assert(ReceiveConfig->data != NULL);
+
+    SPI_dmaStart(ReceiveConfig->Channel, NULL, ReceiveConfig->data,
+                 ReceiveConfig->size, sizeof(uint8_t));
+}
+
+/*****************************************************************************
+ * Function: SPI_transferReceiveDma()
+*//**
+ *\b Description:
+ * This function is used to start an exchange on the SPI bus, as
+ * SPI_transferReceive does, and returns at once.
+ *
+ * PRE-CONDITION: SPI_dmaInit has set up the channel. <br>
+ * PRE-CONDITION: No transfer is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The buffers live until the end. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last frame is received,
+ * then the callback is called. <br>
+ *
+ * @param[in] ExchangeConfig A pointer to a structure containing the
+ * channel, size, data to be sent and data to be read.
+ *
+ * @return  void
+ *
+ * @see SPI_transferReceiveDma
+ * @see SPI_transferReceiveDma8
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+void SPI_transferReceiveDma(const SpiExchangeConfig_t * const ExchangeConfig)
+{
+    assert(ExchangeConfig->Channel < SPI_MAX_CHANNEL);
+    assert(ExchangeConfig->size > 0);
+
+    SPI_dmaStart(ExchangeConfig->Channel, ExchangeConfig->txData,
+                 ExchangeConfig->rxData, ExchangeConfig->size,
+                 sizeof(uint16_t));
+}
+
+/*****************************************************************************
+ * Function: SPI_transferReceiveDma8()
+*//**
+ *\b Description:
+ * This function is used to start an exchange of bytes on a channel set to
+ * SPI_8BITS, as SPI_transferReceiveDma does.
+ *
+ * PRE-CONDITION: SPI_dmaInit has set up the channel. <br>
+ * PRE-CONDITION: The channel is set to SPI_8BITS. <br>
+ * PRE-CONDITION: No transfer is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The buffers live until the end. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last byte is received,
+ * then the callback is called. <br>
+ *
+ * @param[in] ExchangeConfig A pointer to a structure containing the
+ * channel, size, bytes to be sent and bytes to be read.
+ *
+ * @return  void
+ *
+ * @see SPI_transferReceiveDma
+ * @see SPI_transferReceiveDma8
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+void SPI_transferReceiveDma8(const SpiExchange8Config_t * const ExchangeConfig)
+{
+    assert(ExchangeConfig->Channel < SPI_MAX_CHANNEL);
+    assert(ExchangeConfig->size > 0);
+
+    SPI_dmaStart(ExchangeConfig->Channel, ExchangeConfig->txData,
+                 ExchangeConfig->rxData, ExchangeConfig->size,
+                 sizeof(uint8_t));
+}
+
+/*****************************************************************************
+ * Function: SPI_dmaStatusGet()
+*//**
+ *\b Description:
+ * This function is used to poll the transfers of a channel.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  The status of the channel.
+ *
+ * @see SPI_dmaStatusGet
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+SpiDmaStatus_t SPI_dmaStatusGet(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    return DmaStatus[Channel];
+}
+
+/*****************************************************************************
+ * Function: SPI_dmaWait()
+*//**
+ *\b Description:
+ * This function is used to sleep (WFI) until the transfer of a channel
+ * ends. The status is checked with the interrupts masked, so a completion
+ * between the check and the WFI still wakes the core.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: The channel is not busy. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+ * @see SPI_dmaStatusGet
+ * @see SPI_dmaWait
+ *
+*****************************************************************************/
+void SPI_dmaWait(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    __disable_irq();
+    while(DmaStatus[Channel] == SPI_DMA_BUSY)
+    {
+        /* A pending interrupt wakes the core even while it is masked */
+        __WFI();
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+
+/*****************************************************************************
+ * Function: DMA2_Stream2_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of DMA2 stream 2 (SPI1 RX).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void DMA2_Stream2_IRQHandler(void)
+{
+    SPI_dmaComplete(SPI_CHANNEL1);
+}
+
+/*****************************************************************************
+ * Function: DMA1_Stream3_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of DMA1 stream 3 (SPI2 RX).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void DMA1_Stream3_IRQHandler(void)
+{
+    SPI_dmaComplete(SPI_CHANNEL2);
+}
+
+/*****************************************************************************
+ * Function: DMA1_Stream0_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of DMA1 stream 0 (SPI3 RX).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void DMA1_Stream0_IRQHandler(void)
+{
+    SPI_dmaComplete(SPI_CHANNEL3);
+}
+
+/*****************************************************************************
+ * Function: DMA2_Stream0_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of DMA2 stream 0 (SPI4 RX).
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void DMA2_Stream0_IRQHandler(void)
+{
+    SPI_dmaComplete(SPI_CHANNEL4);
+}
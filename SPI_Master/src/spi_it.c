@@ -0,0 +1,522 @@
+/**
+ * @file spi_it.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the SPI interrupt transfers.
+ * @version 1.0
+ * @date 2025-04-15
+ * @note Take into account the following considerations:
+ * + Each channel owns its SPI interrupt (SPI1_IRQn-SPI4_IRQn) while an
+ *   exchange runs; do not mix it with SPI_transferDma on the same channel.
+ * + One frame is in flight per channel: the RXNE interrupt reads frame i
+ *   and writes frame i+1. A channel never overruns, however long the other
+ *   channels hold the CPU; the bus idles the interrupt latency between
+ *   frames. TXE is not needed, the start writes the first frame.
+ * + OVR (ERR interrupt) stops the exchange with SPI_IT_ERROR. MODF stops
+ *   it with SPI_IT_MODE_FAULT; the hardware clears SPE and MSTR, so CR1 is
+ *   written back from the settings of the channel (SPI_settingsRestore).
+ * + The CRC of a channel set to SPI_CRC_ENABLED is not sent nor checked
+ *   by these exchanges; the polled and DMA transfers clear it at their
+ *   start.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "spi_it.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/** Defines the interrupts of an exchange in CR2 */
+#define SPI_IT_ENABLES  (SPI_CR2_RXNEIE | SPI_CR2_ERRIE)
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+/**
+ * Defines the context of the exchange of a channel.
+ */
+typedef struct
+{
+    const void *tx;                     /**< Frames to send, NULL for zeros */
+    void *rx;                           /**< Frames received, NULL to drop */
+    size_t size;                        /**< Frames of the exchange */
+    size_t done;                        /**< Frames received */
+    bool bytes;                         /**< uint8_t items, else uint16_t */
+    volatile SpiItStatus_t Status;      /**< Status of the channel */
+    SpiItCallback_t Callback;           /**< Completion callback */
+}SpiItContext_t;
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Registers and interrupt of each channel */
+static uint16_t volatile * const ItDr[SPI_PORTS_NUMBER] =
+{
+    (uint16_t*)&SPI1->DR, (uint16_t*)&SPI2->DR, 
+    (uint16_t*)&SPI3->DR, (uint16_t*)&SPI4->DR
+};
+
+static uint16_t volatile * const ItSr[SPI_PORTS_NUMBER] =
+{
+    (uint16_t*)&SPI1->SR, (uint16_t*)&SPI2->SR, 
+    (uint16_t*)&SPI3->SR, (uint16_t*)&SPI4->SR
+};
+
+static uint16_t volatile * const ItCr2[SPI_PORTS_NUMBER] =
+{
+    (uint16_t*)&SPI1->CR2, (uint16_t*)&SPI2->CR2, 
+    (uint16_t*)&SPI3->CR2, (uint16_t*)&SPI4->CR2
+};
+
+static const IRQn_Type ItIrq[SPI_PORTS_NUMBER] =
+{
+    SPI1_IRQn, SPI2_IRQn, SPI3_IRQn, SPI4_IRQn
+};
+
+/** Context of each channel */
+static SpiItContext_t ItContext[SPI_PORTS_NUMBER];
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static inline uint16_t SPI_itFrameGet(const SpiItContext_t * const Context,
+                                      size_t index);
+static void SPI_itStart(SpiChannel_t Channel, const void * const tx,
+                        void * const rx, size_t size, bool bytes);
+static void SPI_itService(SpiChannel_t Channel);
+static void SPI_itEnd(SpiChannel_t Channel, SpiItStatus_t Status);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SPI_itFrameGet()
+*//**
+ *\b Description:
+ * This function is used to get a frame to send: an item of tx, or zero.
+ *
+ * @param[in]   Context is the context of the channel.
+ * @param[in]   index is the frame.
+ *
+ * @return  The frame.
+ *
+*****************************************************************************/
+static inline uint16_t SPI_itFrameGet(const SpiItContext_t * const Context,
+                                      size_t index)
+{
+    if(Context->tx == NULL)
+    {
+        return 0U;
+    }
+
+    return Context->bytes ? ((const uint8_t *)Context->tx)[index] :
+                            ((const uint16_t *)Context->tx)[index];
+}
+
+/*****************************************************************************
+ * Function: SPI_itStart()
+*//**
+ *\b Description:
+ * This function is used to start the exchange of a channel: the context 
+ * is set, the interrupts are enabled and the first frame is written.
+ *
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   tx is the frames to send, NULL to send zeros.
+ * @param[out]  rx is the frames received, NULL to drop them.
+ * @param[in]   size is the number of frames.
+ * @param[in]   bytes is true for uint8_t items, false for uint16_t items.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_itStart(SpiChannel_t Channel, const void * const tx,
+                        void * const rx, size_t size, bool bytes)
+{
+    SpiItContext_t * const Context = &ItContext[Channel];
+    uint16_t volatile * const dr = ItDr[Channel];
+
+    assert(Context->Status != SPI_IT_BUSY);
+
+    Context->tx = tx;
+    Context->rx = rx;
+    Context->size = size;
+    Context->done = 0;
+    Context->bytes = bytes;
+    Context->Status = SPI_IT_BUSY;
+
+    /* A frame left on the wire by a stopped exchange ends first*/
+    while(REG_READ16(ItSr[Channel]) & SPI_SR_BSY)
+    {
+        asm("nop");
+    }
+
+    /* Drop a stale frame and a stale overrun*/
+    (void)REG_READ16(dr);
+    (void)REG_READ16(ItSr[Channel]);
+
+    REG_SET16(ItCr2[Channel], SPI_IT_ENABLES);
+    REG_WRITE16(dr, SPI_itFrameGet(Context, 0U));
+}
+
+/*****************************************************************************
+ * Function: SPI_itEnd()
+*//**
+ *\b Description:
+ * This function is used to end the exchange of a channel: the interrupts
+ * of the SPI are disabled and the callback is called.
+ *
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   Status is the status of the end.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_itEnd(SpiChannel_t Channel, SpiItStatus_t Status)
+{
+    SpiItContext_t * const Context = &ItContext[Channel];
+
+    REG_CLEAR16(ItCr2[Channel], SPI_IT_ENABLES);
+    Context->Status = Status;
+
+    if(Context->Callback != NULL)
+    {
+        Context->Callback(Channel, Status);
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_itService()
+*//**
+ *\b Description:
+ * This function is used to serve the interrupt of a channel. An error ends
+ * the exchange; a frame received is stored and the next one is sent. A 
+ * mode fault has cleared SPE and MSTR: CR1 is written back, which also 
+ * clears MODF after the read of SR.
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_itService(SpiChannel_t Channel)
+{
+    SpiItContext_t * const Context = &ItContext[Channel];
+    uint16_t volatile * const dr = ItDr[Channel];
+    const uint16_t status = REG_READ16(ItSr[Channel]);
+
+    if(status & SPI_SR_MODF)
+    {
+        SPI_settingsRestore(Channel);
+        SPI_itEnd(Channel, SPI_IT_MODE_FAULT);
+    }
+    else if(status & SPI_SR_OVR)
+    {
+        /* Clear OVR: read DR after SR*/
+        (void)REG_READ16(dr);
+        SPI_itEnd(Channel, SPI_IT_ERROR);
+    }
+    else if(status & SPI_SR_RXNE)
+    {
+        const uint16_t frame = REG_READ16(dr);
+        const size_t done = Context->done;
+
+        if(Context->rx == NULL)
+        {
+            /* The frame is dropped*/
+        }
+        else if(Context->bytes)
+        {
+            ((uint8_t *)Context->rx)[done] = (uint8_t)frame;
+        }
+        else
+        {
+            ((uint16_t *)Context->rx)[done] = frame;
+        }
+
+        if((done + 1U) < Context->size)
+        {
+            REG_WRITE16(dr, SPI_itFrameGet(Context, done + 1U));
+            Context->done = done + 1U;
+        }
+        else
+        {
+            Context->done = done + 1U;
+            SPI_itEnd(Channel, SPI_IT_IDLE);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_itInit()
+*//**
+ *\b Description:
+ * This function is used to set up the interrupt exchanges of the channels
+ * of the configuration table.
+ *
+ * PRE-CONDITION: SPI_init has set up the channels of the table. <br>
+ *
+ * POST-CONDITION: The channels are ready for SPI_transferReceiveIt. <br>
+ *
+ * @param[in]   Config is a pointer to the configuration table.
+ * @param[in]   configSize is the size of the configuration table.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * const SpiConfig_t * const SpiConfig = SPI_ConfigGet();
+ * size_t configSize = SPI_configSizeGet();
+ *
+ * SPI_init(SpiConfig, configSize);
+ * SPI_itInit(SpiConfig, configSize);
+ * @endcode
+ *
+ * @see SPI_itInit
+ * @see SPI_itCallbackRegister
+ * @see SPI_transferReceiveIt
+ *
+*****************************************************************************/
+void SPI_itInit(const SpiConfig_t * const Config, size_t configSize)
+{
+    for(size_t i = 0; i < configSize; i++)
+    {
+        assert(Config[i].Channel < SPI_MAX_CHANNEL);
+
+        const SpiChannel_t Channel = Config[i].Channel;
+
+        REG_CLEAR16(ItCr2[Channel], SPI_IT_ENABLES | SPI_CR2_TXEIE);
+        ItContext[Channel].Status = SPI_IT_IDLE;
+        NVIC_ClearPendingIRQ(ItIrq[Channel]);
+        NVIC_EnableIRQ(ItIrq[Channel]);
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_itCallbackRegister()
+*//**
+ *\b Description:
+ * This function is used to register the function called at the end of
+ * each exchange of a channel.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: The callback runs at the end of the next exchanges. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   Callback is the function to call, NULL for none.
+ *
+ * @return  void
+ *
+ * @see SPI_itCallbackRegister
+ * @see SPI_itStatusGet
+ *
+*****************************************************************************/
+void SPI_itCallbackRegister(SpiChannel_t Channel, SpiItCallback_t Callback)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    ItContext[Channel].Callback = Callback;
+}
+
+/*****************************************************************************
+ * Function: SPI_transferReceiveIt()
+*//**
+ *\b Description:
+ * This function is used to start an exchange, as SPI_transferReceive does,
+ * and returns at once. The SPI interrupt of the channel moves the frames.
+ *
+ * PRE-CONDITION: SPI_itInit has set up the channel. <br>
+ * PRE-CONDITION: No exchange is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The buffers live until the end of the exchange. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last frame is received,
+ * then the callback is called. <br>
+ *
+ * @param[in] ExchangeConfig A pointer to a structure containing the
+ * channel, size, data to be sent and data to be read.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static uint16_t sensor[8];
+ * static uint16_t flash[64];
+ * const SpiExchangeConfig_t Sensor = {SPI_CHANNEL1, 8, NULL, sensor};
+ * const SpiExchangeConfig_t Flash = {SPI_CHANNEL2, 64, flash, NULL};
+ *
+ * SPI_transferReceiveIt(&Sensor);
+ * SPI_transferReceiveIt(&Flash);
+ * ...                                  //Other work
+ * SPI_itWait(SPI_CHANNEL1);
+ * SPI_itWait(SPI_CHANNEL2);
+ * @endcode
+ *
+ * @see SPI_transferReceive
+ * @see SPI_transferReceiveIt
+ * @see SPI_itStatusGet
+ * @see SPI_itWait
+ *
+*****************************************************************************/
+void SPI_transferReceiveIt(const SpiExchangeConfig_t * const ExchangeConfig)
+{
+    assert(ExchangeConfig->Channel < SPI_MAX_CHANNEL);
+    assert(ExchangeConfig->size > 0);
+
+    SPI_itStart(ExchangeConfig->Channel, ExchangeConfig->txData,
+                ExchangeConfig->rxData, ExchangeConfig->size, false);
+}
+
+/*****************************************************************************
+ * Function: SPI_transferReceiveIt8()
+*//**
+ *\b Description:
+ * This function is used to start an exchange of bytes on a channel set to
+ * SPI_8BITS, as SPI_transferReceiveIt does.
+ *
+ * PRE-CONDITION: SPI_itInit has set up the channel. <br>
+ * PRE-CONDITION: The channel is set to SPI_8BITS. <br>
+ * PRE-CONDITION: No exchange is running on the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The buffers live until the end of the exchange. <br>
+ *
+ * POST-CONDITION: The channel is busy until the last byte is received,
+ * then the callback is called. <br>
+ *
+ * @param[in] ExchangeConfig A pointer to a structure containing the
+ * channel, size, bytes to be sent and bytes to be read.
+ *
+ * @return  void
+ *
+ * @see SPI_transferReceiveIt
+ * @see SPI_transferReceiveIt8
+ * @see SPI_itWait
+ *
+*****************************************************************************/
+void SPI_transferReceiveIt8(const SpiExchange8Config_t * const ExchangeConfig)
+{
+    assert(ExchangeConfig->Channel < SPI_MAX_CHANNEL);
+    assert(ExchangeConfig->size > 0);
+
+    SPI_itStart(ExchangeConfig->Channel, ExchangeConfig->txData,
+                ExchangeConfig->rxData, ExchangeConfig->size, true);
+}
+
+/*****************************************************************************
+ * Function: SPI_itStatusGet()
+*//**
+ *\b Description:
+ * This function is used to poll the exchanges of a channel.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  The status of the channel.
+ *
+ * @see SPI_itStatusGet
+ * @see SPI_itWait
+ *
+*****************************************************************************/
+SpiItStatus_t SPI_itStatusGet(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    return ItContext[Channel].Status;
+}
+
+/*****************************************************************************
+ * Function: SPI_itWait()
+*//**
+ *\b Description:
+ * This function is used to sleep (WFI) until the exchange of a channel
+ * ends. The status is checked with the interrupts masked, so a completion
+ * between the check and the WFI still wakes the core.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: The channel is not busy. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+ * @see SPI_itStatusGet
+ * @see SPI_itWait
+ *
+*****************************************************************************/
+void SPI_itWait(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    __disable_irq();
+    while(ItContext[Channel].Status == SPI_IT_BUSY)
+    {
+        /* A pending interrupt wakes the core even while it is masked */
+        __WFI();
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+
+/*****************************************************************************
+ * Function: SPI1_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of SPI1.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SPI1_IRQHandler(void)
+{
+    SPI_itService(SPI_CHANNEL1);
+}
+
+/*****************************************************************************
+ * Function: SPI2_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of SPI2.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SPI2_IRQHandler(void)
+{
+    SPI_itService(SPI_CHANNEL2);
+}
+
+/*****************************************************************************
+ * Function: SPI3_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of SPI3.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SPI3_IRQHandler(void)
+{
+    SPI_itService(SPI_CHANNEL3);
+}
+
+/*****************************************************************************
+ * Function: SPI4_IRQHandler()
+*//**
+ *\b Description:
+ * This function is the interrupt handler of SPI4.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+void SPI4_IRQHandler(void)
+{
+    SPI_itService(SPI_CHANNEL4);
+}
@@ -0,0 +1,405 @@
+/**
+ * @file spi_queue.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the SPI transaction queue.
+ * @version 1.0
+ * @date 2025-04-17
+ * @note Take into account the following considerations:
+ * + The queue of a channel is a single producer, single consumer ring: one
+ *   context (the main loop or one interrupt) pushes, the DMA interrupt of
+ *   the channel pops. The producer only writes head, the consumer only
+ *   writes tail, so the ring itself needs no lock.
+ * + The queue owns the DMA callback of its channels; do not start other
+ *   DMA transfers on them while transactions are queued.
+ * + The chip select handle is resolved when the transaction is pushed,
+ *   while the previous one is still on the wire. The interrupt of a
+ *   transaction only raises its chip select, lowers the next one and
+ *   starts its streams, so the bus idles the interrupt latency between
+ *   transactions.
+ * + A transaction stopped by a DMA error, or ended by a CRC error, still
+ *   releases its slave; the queue goes on and the error is kept until the
+ *   queue runs again from idle.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "spi_queue.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/** Defines the mask of the ring index */
+#define SPI_QUEUE_MASK  (SPI_QUEUE_DEPTH - 1U)
+
+#if (SPI_QUEUE_DEPTH == 0U) || ((SPI_QUEUE_DEPTH & SPI_QUEUE_MASK) != 0U)
+#error "SPI_QUEUE_DEPTH must be a power of 2"
+#endif
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+/**
+ * Defines a transaction of the ring, ready to start.
+ */
+typedef struct
+{
+    DioPinHandle_t Cs;                  /**< Chip select, active low */
+    const void *tx;                     /**< Frames to send, NULL for zeros */
+    void *rx;                           /**< Frames received, NULL to drop */
+    size_t size;                        /**< Frames of the transaction */
+}SpiQueueEntry_t;
+
+/**
+ * Defines the queue of a channel. The indexes run free, the entry of an
+ * index is at index & SPI_QUEUE_MASK.
+ */
+typedef struct
+{
+    SpiQueueEntry_t Entry[SPI_QUEUE_DEPTH]; /**< Ring of transactions */
+    volatile uint32_t head;             /**< Next entry pushed (producer) */
+    volatile uint32_t tail;             /**< Entry on the wire (consumer) */
+    volatile bool running;              /**< The entry at tail is running */
+    volatile SpiDmaStatus_t status;     /**< Last failure, else IDLE */
+    bool bytes;                         /**< uint8_t items, else uint16_t */
+}SpiQueueContext_t;
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Queue of each channel */
+static SpiQueueContext_t QueueContext[SPI_PORTS_NUMBER];
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void SPI_queueStart(SpiChannel_t Channel);
+static void SPI_queueComplete(SpiChannel_t Channel, SpiDmaStatus_t Status);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SPI_queueStart()
+*//**
+ *\b Description:
+ * This function is used to select the slave of the entry at tail and to
+ * start its exchange.
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_queueStart(SpiChannel_t Channel)
+{
+    SpiQueueContext_t * const Context = &QueueContext[Channel];
+    const SpiQueueEntry_t * const Entry =
+        &Context->Entry[Context->tail & SPI_QUEUE_MASK];
+
+    DIO_pinClear(&Entry->Cs);
+
+    if(Context->bytes)
+    {
+        const SpiExchange8Config_t ExchangeConfig =
+        {
+            .Channel = Channel,
+            .size = Entry->size,
+            .txData = Entry->tx,
+            .rxData = Entry->rx
+        };
+
+        SPI_transferReceiveDma8(&ExchangeConfig);
+    }
+    else
+    {
+        const SpiExchangeConfig_t ExchangeConfig =
+        {
+            .Channel = Channel,
+            .size = Entry->size,
+            .txData = Entry->tx,
+            .rxData = Entry->rx
+        };
+
+        SPI_transferReceiveDma(&ExchangeConfig);
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_queueComplete()
+*//**
+ *\b Description:
+ * This function is the DMA callback of the queued channels: the slave of
+ * the finished entry is released and the next entry, if any, is started.
+ *
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   Status is the status of the finished exchange.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static void SPI_queueComplete(SpiChannel_t Channel, SpiDmaStatus_t Status)
+{
+    SpiQueueContext_t * const Context = &QueueContext[Channel];
+
+    if(!Context->running)
+    {
+        return;
+    }
+
+    DIO_pinSet(&Context->Entry[Context->tail & SPI_QUEUE_MASK].Cs);
+
+    if(Status != SPI_DMA_IDLE)
+    {
+        Context->status = Status;
+    }
+
+    /* The entry is free once tail moves past it */
+    Context->tail = Context->tail + 1U;
+
+    if(Context->tail != Context->head)
+    {
+        SPI_queueStart(Channel);
+    }
+    else
+    {
+        Context->running = false;
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_queueInit()
+*//**
+ *\b Description:
+ * This function is used to set up an empty queue for the channels of the
+ * configuration table. The frames of the channels set to SPI_8BITS are
+ * bytes in memory, the others are 16 bits items.
+ *
+ * PRE-CONDITION: SPI_init and SPI_dmaInit have set up the channels of the
+ * table. <br>
+ * PRE-CONDITION: No transfer is running on the channels. <br>
+ *
+ * POST-CONDITION: The queues are empty and own the DMA callback of the
+ * channels. <br>
+ *
+ * @param[in]   Config is a pointer to the configuration table.
+ * @param[in]   configSize is the size of the configuration table.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * const SpiConfig_t * const SpiConfig = SPI_ConfigGet();
+ * size_t configSize = SPI_configSizeGet();
+ *
+ * SPI_init(SpiConfig, configSize);
+ * SPI_dmaInit(SpiConfig, configSize);
+ * SPI_queueInit(SpiConfig, configSize);
+ * @endcode
+ *
+ * @see SPI_queueInit
+ * @see SPI_queuePush
+ * @see SPI_queueWait
+ *
+*****************************************************************************/
+void SPI_queueInit(const SpiConfig_t * const Config, size_t configSize)
+{
+    for(size_t i = 0; i < configSize; i++)
+    {
+        assert(Config[i].Channel < SPI_MAX_CHANNEL);
+        assert(Config[i].DataSize < SPI_MAX_BITS);
+
+        SpiQueueContext_t * const Context = &QueueContext[Config[i].Channel];
+
+        Context->head = 0U;
+        Context->tail = 0U;
+        Context->running = false;
+        Context->status = SPI_DMA_IDLE;
+        Context->bytes = (Config[i].DataSize == SPI_8BITS);
+
+        SPI_dmaCallbackRegister(Config[i].Channel, SPI_queueComplete);
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_queuePush()
+*//**
+ *\b Description:
+ * This function is used to add a transaction at the end of the queue of a
+ * channel and returns at once. An idle queue starts it; otherwise it
+ * starts from the interrupt of the transaction before it. It may be
+ * called from an interrupt, if that is the only producer of the channel.
+ *
+ * PRE-CONDITION: SPI_queueInit has set up the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The chip select is an output, high while idle. <br>
+ * PRE-CONDITION: The buffers live until the end of the transaction. <br>
+ *
+ * POST-CONDITION: The transaction is queued, unless the queue is full. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ * @param[in]   Transaction is a pointer to the transaction, copied into
+ * the queue.
+ *
+ * @return  true if the transaction is queued, false if the queue is full.
+ *
+ * \b Example:
+ * @code
+ * static uint8_t status[2] = {0x05, 0};
+ * const SpiQueueTransaction_t Transaction =
+ * {
+ *     .Cs = {DIO_PA, DIO_PA4},
+ *     .size = sizeof(status),
+ *     .txData = status,
+ *     .rxData = status
+ * };
+ *
+ * while(!SPI_queuePush(SPI_CHANNEL1, &Transaction))
+ * {
+ *     __WFI();                         //Wait for a free entry
+ * }
+ * @endcode
+ *
+ * @see SPI_queuePush
+ * @see SPI_queueCountGet
+ * @see SPI_queueWait
+ *
+*****************************************************************************/
+bool SPI_queuePush(SpiChannel_t Channel,
+                   const SpiQueueTransaction_t * const Transaction)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+    assert(Transaction->size > 0);
+
+    SpiQueueContext_t * const Context = &QueueContext[Channel];
+    const uint32_t head = Context->head;
+
+    if((head - Context->tail) >= SPI_QUEUE_DEPTH)
+    {
+        return false;
+    }
+
+    SpiQueueEntry_t * const Entry = &Context->Entry[head & SPI_QUEUE_MASK];
+
+    Entry->Cs = DIO_pinHandleGet(&Transaction->Cs);
+    Entry->tx = Transaction->txData;
+    Entry->rx = Transaction->rxData;
+    Entry->size = Transaction->size;
+
+    /* The entry is written before the consumer can see it */
+    __DMB();
+    Context->head = head + 1U;
+
+    /* An idle queue is started here, a running one by its interrupt */
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(!Context->running)
+    {
+        Context->running = true;
+        Context->status = SPI_DMA_IDLE;
+        SPI_queueStart(Channel);
+    }
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+/*****************************************************************************
+ * Function: SPI_queueCountGet()
+*//**
+ *\b Description:
+ * This function is used to get the transactions of a channel not finished
+ * yet, the running one included.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  The transactions in the queue, up to SPI_QUEUE_DEPTH.
+ *
+ * @see SPI_queueCountGet
+ * @see SPI_queueStatusGet
+ *
+*****************************************************************************/
+size_t SPI_queueCountGet(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    const SpiQueueContext_t * const Context = &QueueContext[Channel];
+
+    return (size_t)(Context->head - Context->tail);
+}
+
+/*****************************************************************************
+ * Function: SPI_queueStatusGet()
+*//**
+ *\b Description:
+ * This function is used to get the status of the queue of a channel.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  SPI_DMA_BUSY while transactions run, else the status of the
+ * last one that failed (SPI_DMA_ERROR or SPI_DMA_CRC_ERROR) since the 
+ * queue was idle, else SPI_DMA_IDLE.
+ *
+ * @see SPI_queueCountGet
+ * @see SPI_queueStatusGet
+ * @see SPI_queueWait
+ *
+*****************************************************************************/
+SpiDmaStatus_t SPI_queueStatusGet(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    const SpiQueueContext_t * const Context = &QueueContext[Channel];
+
+    if(Context->running)
+    {
+        return SPI_DMA_BUSY;
+    }
+
+    return Context->status;
+}
+
+/*****************************************************************************
+ * Function: SPI_queueWait()
+*//**
+ *\b Description:
+ * This function is used to sleep (WFI) until the queue of a channel is
+ * empty, as SPI_dmaWait does.
+ *
+ * PRE-CONDITION: The Channel is within the maximum SpiChannel_t. <br>
+ *
+ * POST-CONDITION: The queue is empty and every chip select is high. <br>
+ *
+ * @param[in]   Channel is the SPI channel.
+ *
+ * @return  void
+ *
+ * @see SPI_queuePush
+ * @see SPI_queueStatusGet
+ * @see SPI_queueWait
+ *
+*****************************************************************************/
+void SPI_queueWait(SpiChannel_t Channel)
+{
+    assert(Channel < SPI_MAX_CHANNEL);
+
+    __disable_irq();
+    while(QueueContext[Channel].running)
+    {
+        /* A pending interrupt wakes the core even while it is masked */
+        __WFI();
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
@@ -0,0 +1,359 @@
+/**
+ * @file spi_soft.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the software SPI.
+ * @version 1.0
+ * @date 2025-04-13
+ * @note Take into account the following considerations:
+ * + SCK and MOSI share a port: every SCK edge is one BSRR store, and the
+ *   MOSI bit rides on the SCK store of the edge it changes on. MISO is
+ *   sampled with one IDR load per bit.
+ * + The clock runs as fast as the code (no BaudRate): about a sixth of the
+ *   core clock, with the SCK high and low times set by the bus accesses.
+ * + There is one frame loop per mode, bit order and data size (16), with
+ *   the bit loop unrolled. Each costs a few hundred bytes of flash.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdbool.h>
+#include "spi_soft.h"
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+/** Position in the frame of the n-th bit on the wire */
+#define SPI_SOFT_INDEX(Format, bits, n) \
+    (((Format) == SPI_MSB) ? ((bits) - 1U - (n)) : (n))
+
+/**
+ * Lists the variants of the frame loop: every mode, bit order and data
+ * size. The list is expanded into the functions and into their table.
+ */
+#define SPI_SOFT_VARIANTS(VARIANT)                      \
+    VARIANT(SPI_MODE0, SPI_MSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE0, SPI_MSB, SPI_16BITS)             \
+    VARIANT(SPI_MODE0, SPI_LSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE0, SPI_LSB, SPI_16BITS)             \
+    VARIANT(SPI_MODE1, SPI_MSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE1, SPI_MSB, SPI_16BITS)             \
+    VARIANT(SPI_MODE1, SPI_LSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE1, SPI_LSB, SPI_16BITS)             \
+    VARIANT(SPI_MODE2, SPI_MSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE2, SPI_MSB, SPI_16BITS)             \
+    VARIANT(SPI_MODE2, SPI_LSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE2, SPI_LSB, SPI_16BITS)             \
+    VARIANT(SPI_MODE3, SPI_MSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE3, SPI_MSB, SPI_16BITS)             \
+    VARIANT(SPI_MODE3, SPI_LSB, SPI_8BITS)              \
+    VARIANT(SPI_MODE3, SPI_LSB, SPI_16BITS)
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+typedef struct SpiSoftBus SpiSoftBus_t;
+
+/** Defines a frame loop: Tx NULL sends zeros, Rx NULL drops the frames */
+typedef void (*SpiSoftExchange_t)(const SpiSoftBus_t * const Bus,
+                                  const uint16_t *Tx, uint16_t *Rx,
+                                  size_t size);
+
+/** Defines the pins and the frame loop of a software SPI channel */
+struct SpiSoftBus
+{
+    uint32_t volatile *Bsrr;        /**< BSRR of the SCK/MOSI port */
+    uint32_t volatile *Idr;         /**< IDR of the MISO port */
+    uint32_t Sck;                   /**< Mask of SCK */
+    uint32_t Mosi;                  /**< Mask of MOSI */
+    uint32_t misoPin;               /**< Pin of MISO */
+    SpiSoftExchange_t Exchange;     /**< Frame loop of the settings */
+};
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#define SPI_SOFT_PROTOTYPE(Mode, Format, Size)                          \
+    static void SPI_softExchange_##Mode##_##Format##_##Size(            \
+        const SpiSoftBus_t * const Bus, const uint16_t *Tx,             \
+        uint16_t *Rx, size_t size);
+SPI_SOFT_VARIANTS(SPI_SOFT_PROTOTYPE)
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/** Software SPI channels, built by SPI_softInit */
+static SpiSoftBus_t SoftBus[SPI_PORTS_NUMBER];
+
+/** Frame loop of each mode, bit order and data size */
+#define SPI_SOFT_ENTRY(Mode, Format, Size)                              \
+    [Mode][Format][Size] = SPI_softExchange_##Mode##_##Format##_##Size,
+static const SpiSoftExchange_t
+    SoftExchange[SPI_MAX_MODE][SPI_MAX_FF][SPI_MAX_BITS] =
+{
+    SPI_SOFT_VARIANTS(SPI_SOFT_ENTRY)
+};
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SPI_softFrames()
+*//**
+ *\b Description:
+ * This function is the frame loop of every variant. The settings are
+ * constants of each caller, so the mode and bit order tests fold away and
+ * the bit steps below become straight-line code.
+ *
+ * CPHA = 0: MOSI is valid before the leading edge. Each bit is the leading
+ * edge, the MISO sample, and the trailing edge that also puts the next bit
+ * (of the next frame after the last bit) on MOSI.
+ * CPHA = 1: each bit is the leading edge that also puts the bit on MOSI,
+ * the trailing edge, and the MISO sample.
+ *
+ * @param[in]   Bus is the software SPI channel.
+ * @param[in]   Tx is the frames to send, NULL to send zeros.
+ * @param[out]  Rx is the frames received, NULL to drop them.
+ * @param[in]   size is the number of frames.
+ * @param[in]   Mode is the clock polarity and phase.
+ * @param[in]   Format is the bit order.
+ * @param[in]   Size is the data size.
+ *
+ * @return  void
+ *
+*****************************************************************************/
+static inline __attribute__((always_inline))
+void SPI_softFrames(const SpiSoftBus_t * const Bus, const uint16_t *Tx,
+                    uint16_t *Rx, size_t size, const SpiMode_t Mode,
+                    const SpiFrameFormat_t Format, const SpiDataSize_t Size)
+{
+    const uint32_t bits = (Size == SPI_16BITS) ? 16U : 8U;
+    const bool cpha = (Mode == SPI_MODE1) || (Mode == SPI_MODE3);
+    const bool cpol = (Mode == SPI_MODE2) || (Mode == SPI_MODE3);
+    uint32_t volatile * const bsrr = Bus->Bsrr;
+    uint32_t volatile * const idr = Bus->Idr;
+    const uint32_t misoPin = Bus->misoPin;
+    const uint32_t mosi = Bus->Mosi;
+    /* BSRR words of the SCK levels: idle is the CPOL level */
+    const uint32_t idle = cpol ? Bus->Sck : (Bus->Sck << 16U);
+    const uint32_t active = cpol ? (Bus->Sck << 16U) : Bus->Sck;
+    uint32_t tx = (Tx != NULL) ? Tx[0] : 0U;
+
+/* The BSRR word of MOSI for bit n of frame: set half or reset half */
+#define SPI_SOFT_MOSI(frame, n)                                         \
+    ((mosi << 16U) >>                                                   \
+     ((((frame) >> SPI_SOFT_INDEX(Format, bits, (n))) & 1U) * 16U))
+
+/* The bit steps, only the first bits of the frame are kept */
+#define SPI_SOFT_BIT(n)                                                 \
+    if((n) < bits)                                                      \
+    {                                                                   \
+        if(!cpha)                                                       \
+        {                                                               \
+            REG_WRITE32(bsrr, active);                                  \
+            rx |= ((REG_READ32(idr) >> misoPin) & 1U) <<                \
+                  SPI_SOFT_INDEX(Format, bits, (n));                    \
+            REG_WRITE32(bsrr, idle | (((n) + 1U < bits) ?               \
+                        SPI_SOFT_MOSI(tx, (n) + 1U) :                   \
+                        SPI_SOFT_MOSI(next, 0U)));                      \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            REG_WRITE32(bsrr, active | SPI_SOFT_MOSI(tx, (n)));         \
+            REG_WRITE32(bsrr, idle);                                    \
+            rx |= ((REG_READ32(idr) >> misoPin) & 1U) <<                \
+                  SPI_SOFT_INDEX(Format, bits, (n));                    \
+        }                                                               \
+    }
+
+    if(!cpha)
+    {
+        REG_WRITE32(bsrr, idle | SPI_SOFT_MOSI(tx, 0U));
+    }
+
+    for(size_t i = 0; i < size; i++)
+    {
+        const uint32_t next = ((Tx != NULL) && (i + 1U < size)) ?
+                              Tx[i + 1U] : 0U;
+        uint32_t rx = 0;
+
+        (void)next;
+        SPI_SOFT_BIT(0U)  SPI_SOFT_BIT(1U)  SPI_SOFT_BIT(2U)
+        SPI_SOFT_BIT(3U)  SPI_SOFT_BIT(4U)  SPI_SOFT_BIT(5U)
+        SPI_SOFT_BIT(6U)  SPI_SOFT_BIT(7U)  SPI_SOFT_BIT(8U)
+        SPI_SOFT_BIT(9U)  SPI_SOFT_BIT(10U) SPI_SOFT_BIT(11U)
+        SPI_SOFT_BIT(12U) SPI_SOFT_BIT(13U) SPI_SOFT_BIT(14U)
+        SPI_SOFT_BIT(15U)
+
+        if(Rx != NULL)
+        {
+            Rx[i] = (uint16_t)rx;
+        }
+        tx = next;
+    }
+
+#undef SPI_SOFT_BIT
+#undef SPI_SOFT_MOSI
+}
+
+/** Expands a variant into its frame loop */
+#define SPI_SOFT_DEFINE(Mode, Format, Size)                             \
+    static void SPI_softExchange_##Mode##_##Format##_##Size(            \
+        const SpiSoftBus_t * const Bus, const uint16_t *Tx,             \
+        uint16_t *Rx, size_t size)                                      \
+    {                                                                   \
+        SPI_softFrames(Bus, Tx, Rx, size, Mode, Format, Size);          \
+    }
+SPI_SOFT_VARIANTS(SPI_SOFT_DEFINE)
+
+/*****************************************************************************
+ * Function: SPI_softInit()
+*//**
+ *\b Description:
+ * This function is used to initialize the software SPI channels based on a
+ * configuration table. The frame loop of the mode, bit order and data
+ * size of each channel is selected, and SCK is driven to its idle level.
+ *
+ * PRE-CONDITION: SCK and MOSI are outputs of one port, MISO is an input
+ * (DIO_init). <br>
+ * PRE-CONDITION: The setting is within the maximum values (SPI_MAX). <br>
+ *
+ * POST-CONDITION: The channels are ready for SPI_softTransfer and
+ * SPI_softReceive. <br>
+ *
+ * @param[in]   Config is a pointer to the configuration table.
+ * @param[in]   configSize is the size of the configuration table.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * static const SpiSoftConfig_t SoftConfig[] =
+ * {
+ *     {SPI_CHANNEL1, SPI_MODE0, SPI_MSB, SPI_8BITS,
+ *      {DIO_PB, DIO_PB13}, {DIO_PB, DIO_PB15}, {DIO_PB, DIO_PB14}},
+ * };
+ *
+ * SPI_softInit(SoftConfig, sizeof(SoftConfig)/sizeof(SoftConfig[0]));
+ * @endcode
+ *
+ * @see SPI_softInit
+ * @see SPI_softTransfer
+ * @see SPI_softReceive
+ *
+*****************************************************************************/
+void SPI_softInit(const SpiSoftConfig_t * const Config, size_t configSize)
+{
+    for(size_t i = 0; i < configSize; i++)
+    {
+        assert(Config[i].Channel < SPI_MAX_CHANNEL);
+        assert(Config[i].Mode < SPI_MAX_MODE);
+        assert(Config[i].FrameFormat < SPI_MAX_FF);
+        assert(Config[i].DataSize < SPI_MAX_BITS);
+        assert(Config[i].Sck.Port == Config[i].Mosi.Port);
+
+        SpiSoftBus_t * const Bus = &SoftBus[Config[i].Channel];
+        const DioPinHandle_t Sck = DIO_pinHandleGet(&Config[i].Sck);
+
+        Bus->Bsrr = Sck.Bsrr;
+        Bus->Idr = DIO_pinHandleGet(&Config[i].Miso).Idr;
+        Bus->Sck = Sck.Mask;
+        Bus->Mosi = DIO_pinHandleGet(&Config[i].Mosi).Mask;
+        Bus->misoPin = (uint32_t)Config[i].Miso.Pin;
+        Bus->Exchange = SoftExchange[Config[i].Mode][Config[i].FrameFormat]
+                                    [Config[i].DataSize];
+
+        /* SCK idle at the CPOL level, MOSI low */
+        if(Config[i].Mode >= SPI_MODE2)
+        {
+            REG_WRITE32(Bus->Bsrr, Bus->Sck | (Bus->Mosi << 16U));
+        }
+        else
+        {
+            REG_WRITE32(Bus->Bsrr, (Bus->Sck | Bus->Mosi) << 16U);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_softTransfer()
+*//**
+ *\b Description:
+ * This function is used to send data on a software SPI channel, as
+ * SPI_transfer does on a peripheral. The frames received are dropped.
+ *
+ * PRE-CONDITION: SPI_softInit set up the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL. <br>
+ *
+ * POST-CONDITION: The frames are sent, SCK is at its idle level. <br>
+ *
+ * @param[in] TransferConfig A pointer to a structure containing the
+ * channel, size, and data to be sent.
+ *
+ * @return  void
+ *
+ * \b Example:
+ * @code
+ * uint16_t data[] = {0x56, 0x78};
+ * SpiTransferConfig_t TransferConfig =
+ * {
+ *     .Channel = SPI_CHANNEL1,
+ *     .size = sizeof(data)/sizeof(data[0]),
+ *     .data = data
+ * };
+ * SPI_softTransfer(&TransferConfig);
+ * @endcode
+ *
+ * @see SPI_softInit
+ * @see SPI_softTransfer
+ * @see SPI_softReceive
+ *
+*****************************************************************************/
+void SPI_softTransfer(const SpiTransferConfig_t * const TransferConfig)
+{
+    assert(TransferConfig->Channel < SPI_MAX_CHANNEL);
+    assert(TransferConfig->size > 0);
+    assert(TransferConfig->data != NULL);
+
+    const SpiSoftBus_t * const Bus = &SoftBus[TransferConfig->Channel];
+
+    Bus->Exchange(Bus, TransferConfig->data, NULL, TransferConfig->size);
+}
+
+/*****************************************************************************
+ * Function: SPI_softReceive()
+*//**
+ *\b Description:
+ * This function is used to receive data on a software SPI channel, as
+ * SPI_receive does on a peripheral. Zeros are sent.
+ *
+ * PRE-CONDITION: SPI_softInit set up the channel. <br>
+ * PRE-CONDITION: The size is greater than 0. <br>
+ * PRE-CONDITION: The data is not NULL. <br>
+ *
+ * POST-CONDITION: The frames received are in data, SCK is at its idle
+ * level. <br>
+ *
+ * @param[in] ReceiveConfig A pointer to a structure containing the
+ * channel, size, and data to be read.
+ *
+ * @return  void
+ *
+ * @see SPI_softInit
+ * @see SPI_softTransfer
+ * @see SPI_softReceive
+ *
+*****************************************************************************/
+void SPI_softReceive(const SpiReceiveConfig_t * const ReceiveConfig)
+{
+    assert(ReceiveConfig->Channel < SPI_MAX_CHANNEL);
+    assert(ReceiveConfig->size > 0);
+    assert(ReceiveConfig->data != NULL);
+
+    const SpiSoftBus_t * const Bus = &SoftBus[ReceiveConfig->Channel];
+
+    Bus->Exchange(Bus, NULL, ReceiveConfig->data, ReceiveConfig->size);
+}